@@ -1,33 +1,33 @@
-"""Optional dense benchmarks comparing pEigen and NumPy."""
+"""Optional dense benchmarks comparing pEigen and NumPy.
+
+    python benchmarks/bench_dense.py [--sizes 256,1024] [--threads 1,4] [--json out.json]
+                                     [--baseline base.json]
+
+See benchmarks/benchlib.py for the JSON layout and the baseline comparison.
+"""
 
 from __future__ import annotations
 
-import time
+import argparse
 
 import numpy as np
 
+import benchlib
 from peigen import build_config, linalg
 
-
-def _timed(fn, *args, warmup: int = 3, runs: int = 10):
-    for _ in range(warmup):
-        fn(*args)
-
-    durations = []
-    for _ in range(runs):
-        t0 = time.perf_counter()
-        fn(*args)
-        durations.append((time.perf_counter() - t0) * 1000.0)
-
-    durations.sort()
-    p50 = durations[len(durations) // 2]
-    p90 = durations[int(len(durations) * 0.9) - 1]
-    return p50, p90
+try:
+    import scipy.linalg as sla
+except ImportError:  # generalized eigh benchmarks need scipy as the reference
+    sla = None
 
 
-def _report_line(op: str, size: str, numpy_ms: float, peigen_ms: float):
-    speedup = numpy_ms / peigen_ms if peigen_ms > 0 else float("inf")
-    print(f"{op:<18} {size:<14} {numpy_ms:>14.3f} {peigen_ms:>15.3f} {speedup:>8.2f}x")
+def _report_line(rec: benchlib.Recorder, op: str, size: str, numpy_t: benchlib.Timing, peigen_t: benchlib.Timing):
+    rec.add(op, size, peigen_t, numpy_t)
+    speedup = numpy_t.p50 / peigen_t.p50 if peigen_t.p50 > 0 else float("inf")
+    print(
+        f"{op:<18} {size:<14} {numpy_t.p50:>14.3f} {peigen_t.p50:>15.3f} {speedup:>8.2f}x"
+        f" {peigen_t.p99:>15.3f}"
+    )
 
 
 def _svd_methods():
@@ -110,6 +110,30 @@ NORM_CASES = [
 ]
 
 
+def _square_cases(sizes: list[int]) -> dict:
+    """Square-only case lists used by --sizes."""
+    return {
+        "matmul": [(f"{n}x{n}", (n, n), (n, n)) for n in sizes],
+        "solve": [(f"{n}x{n}", (n, n), (n, 1)) for n in sizes] + [(f"{n}x{n}@4rhs", (n, n), (n, 4)) for n in sizes],
+        "norm": [(f"{n}x{n}", (n, n)) for n in sizes],
+        "svd": [(f"{n}x{n}", (n, n)) for n in sizes],
+        "qr": [(f"{n}x{n}", (n, n)) for n in sizes],
+        "eigh": [(f"{n}x{n}", (n, n)) for n in sizes],
+        "cholupdate": list(sizes),
+    }
+
+
+DEFAULT_CASES = {
+    "matmul": MATMUL_CASES,
+    "solve": SOLVE_CASES,
+    "norm": NORM_CASES,
+    "svd": SVD_CASES,
+    "qr": QR_CASES,
+    "eigh": EIGH_CASES,
+    "cholupdate": [500, 1000, 2000, 5000],
+}
+
+
 def _symmetric(rng: np.random.Generator, shape: tuple[int, int]) -> np.ndarray:
     a = rng.standard_normal(shape)
     return (a + a.T) / 2.0
@@ -120,106 +144,201 @@ def _solvable(rng: np.random.Generator, n: int) -> np.ndarray:
     return a + 5.0 * np.eye(n)
 
 
-def run():
+def _run_suite(rec: benchlib.Recorder, cases: dict):
     rng = np.random.default_rng(123)
 
-    print(f"{'op':<18} {'size':<14} {'numpy_p50(ms)':>14} {'peigen_p50(ms)':>15} {'speedup':>8}")
-    print("-" * 76)
+    print(
+        f"{'op':<18} {'size':<14} {'numpy_p50(ms)':>14} {'peigen_p50(ms)':>15} {'speedup':>8}"
+        f" {'peigen_p99(ms)':>15}"
+    )
+    print("-" * 92)
     print("Matmul (with copy-out)")
-    for label, a_shape, b_shape in MATMUL_CASES:
+    for label, a_shape, b_shape in cases["matmul"]:
         a = rng.standard_normal(a_shape)
         b = rng.standard_normal(b_shape)
 
-        np_p50, _ = _timed(lambda x, y: x @ y, a, b)
-        pg_p50, _ = _timed(linalg.matmul, a, b)
-        _report_line("matmul", label, np_p50, pg_p50)
+        np_t = rec.timed(lambda x, y: x @ y, a, b)
+        pg_t = rec.timed(linalg.matmul, a, b)
+        _report_line(rec, "matmul", label, np_t, pg_t)
+
+    print("\nStructured products (gram vs a.T @ a, trmm/symm vs dense @; with copy-out)")
+    for label, a_shape, b_shape in cases["matmul"]:
+        a = rng.standard_normal(a_shape)
+        np_t = rec.timed(lambda x: x.T @ x, a)
+        pg_t = rec.timed(linalg.gram, a)
+        _report_line(rec, "gram", f"{a_shape[0]}x{a_shape[1]}", np_t, pg_t)
+        if a_shape[0] != a_shape[1]:
+            continue
+        b = rng.standard_normal(b_shape)
+        lower = np.tril(a)
+        np_t = rec.timed(lambda x, y: x @ y, lower, b)
+        pg_t = rec.timed(linalg.trmm, a, b)
+        _report_line(rec, "trmm", label, np_t, pg_t)
+        sym = _symmetric(rng, a_shape)
+        np_t = rec.timed(lambda x, y: x @ y, sym, b)
+        pg_t = rec.timed(linalg.symm, sym, b)
+        _report_line(rec, "symm", label, np_t, pg_t)
 
     print("\nSolve (with copy-out)")
-    for label, a_shape, b_shape in SOLVE_CASES:
+    for label, a_shape, b_shape in cases["solve"]:
         n = a_shape[0]
         a = _solvable(rng, n)
         b = rng.standard_normal(b_shape)
 
-        np_p50, _ = _timed(lambda x, y: np.linalg.solve(x, y), a, b)
+        np_t = rec.timed(lambda x, y: np.linalg.solve(x, y), a, b)
         for method in _lapack_eigen_methods():
-            pg_p50, _ = _timed(lambda x, y, m=method: linalg.solve(x, y, method=m), a, b)
-            _report_line(f"solve[{method}]", label, np_p50, pg_p50)
+            pg_t = rec.timed(lambda x, y, m=method: linalg.solve(x, y, method=m), a, b)
+            _report_line(rec, f"solve[{method}]", label, np_t, pg_t)
+            pg_t = rec.timed(lambda x, y, m=method: linalg.solve(x, y, method=m, precision="mixed"), a, b)
+            _report_line(rec, f"solve[{method},mixed]", label, np_t, pg_t)
+
+    print("\nBatched small matrices (numpy stacked linalg vs eigh_batched / solve_batched)")
+    for n in (2, 3, 4, 6):
+        batch = 100_000
+        m = rng.standard_normal((batch, n, n))
+        spd = m @ m.transpose(0, 2, 1) + n * np.eye(n)
+        rhs = rng.standard_normal((batch, n))
+        label = f"{batch}x{n}x{n}"
+
+        np_t = rec.timed(np.linalg.eigh, spd)
+        pg_t = rec.timed(linalg.eigh_batched, spd)
+        _report_line(rec, "eigh_batched", label, np_t, pg_t)
+        np_t = rec.timed(lambda x, y: np.linalg.solve(x, y[..., None]), spd, rhs)
+        pg_t = rec.timed(linalg.solve_batched, spd, rhs)
+        _report_line(rec, "solve_batched", label, np_t, pg_t)
+        pg_t = rec.timed(lambda x, y: linalg.solve_batched(x, y, assume_a="pos"), spd, rhs)
+        _report_line(rec, "solve_batched[pos]", label, np_t, pg_t)
 
     print("\nNorm Frobenius (2D default)")
-    for label, shape in NORM_CASES:
+    for label, shape in cases["norm"]:
         a = rng.standard_normal(shape)
 
-        np_p50, _ = _timed(lambda x: np.linalg.norm(x), a)
-        pg_p50, _ = _timed(linalg.norm, a)
-        _report_line("norm", label, np_p50, pg_p50)
+        np_t = rec.timed(lambda x: np.linalg.norm(x), a)
+        pg_t = rec.timed(linalg.norm, a)
+        _report_line(rec, "norm", label, np_t, pg_t)
 
     print("\nSVD with copy-out (U, s, Vt returned)")
-    for label, shape in SVD_CASES:
+    for label, shape in cases["svd"]:
         a = rng.standard_normal(shape)
-        np_p50, _ = _timed(lambda x: np.linalg.svd(x, full_matrices=False), a)
+        np_t = rec.timed(lambda x: np.linalg.svd(x, full_matrices=False), a)
 
         for method in _svd_methods():
-            pg_p50, _ = _timed(
+            pg_t = rec.timed(
                 lambda x, m=method: linalg.svd(x, full_matrices=False, method=m),
                 a,
             )
-            _report_line(f"svd[{method}]", label, np_p50, pg_p50)
+            _report_line(rec, f"svd[{method}]", label, np_t, pg_t)
 
     print("\nSVD compute-only (minimal return; excludes U/V copy-out)")
-    for label, shape in SVD_CASES:
+    for label, shape in cases["svd"]:
         a = rng.standard_normal(shape)
-        np_p50, _ = _timed(lambda x: np.linalg.svd(x, full_matrices=False), a)
+        np_t = rec.timed(lambda x: np.linalg.svd(x, full_matrices=False), a)
 
         for method in _svd_methods():
-            pg_p50, _ = _timed(
+            pg_t = rec.timed(
                 lambda x, m=method: linalg.svd_compute(x, full_matrices=False, method=m),
                 a,
             )
-            _report_line(f"svd_compute[{method}]", label, np_p50, pg_p50)
+            _report_line(rec, f"svd_compute[{method}]", label, np_t, pg_t)
 
     print("\nQR with copy-out (Q, R returned, mode='reduced')")
-    for label, shape in QR_CASES:
+    for label, shape in cases["qr"]:
         a = rng.standard_normal(shape)
-        np_p50, _ = _timed(lambda x: np.linalg.qr(x, mode="reduced"), a)
-        pg_p50, _ = _timed(lambda x: linalg.qr(x, mode="reduced"), a)
-        _report_line("qr", label, np_p50, pg_p50)
+        np_t = rec.timed(lambda x: np.linalg.qr(x, mode="reduced"), a)
+        pg_t = rec.timed(lambda x: linalg.qr(x, mode="reduced"), a)
+        _report_line(rec, "qr", label, np_t, pg_t)
 
     print("\nEigh with copy-out (eigenvalues and eigenvectors returned)")
-    for label, shape in EIGH_CASES:
+    for label, shape in cases["eigh"]:
         a = _symmetric(rng, shape)
-        np_p50, _ = _timed(lambda x: np.linalg.eigh(x), a)
+        np_t = rec.timed(lambda x: np.linalg.eigh(x), a)
 
         for method in _eigh_methods():
-            pg_p50, _ = _timed(
+            pg_t = rec.timed(
                 lambda x, m=method: linalg.eigh(x, method=m),
                 a,
             )
-            _report_line(f"eigh[{method}]", label, np_p50, pg_p50)
+            _report_line(rec, f"eigh[{method}]", label, np_t, pg_t)
 
     print("\nEigh eigenvalues only (no eigenvector copy-out)")
-    for label, shape in EIGH_CASES:
+    for label, shape in cases["eigh"]:
         a = _symmetric(rng, shape)
-        np_p50, _ = _timed(lambda x: np.linalg.eigvalsh(x), a)
+        np_t = rec.timed(lambda x: np.linalg.eigvalsh(x), a)
 
         for method in _eigh_methods():
-            pg_p50, _ = _timed(
+            pg_t = rec.timed(
                 lambda x, m=method: linalg.eighvals(x, method=m),
                 a,
             )
-            _report_line(f"eighvals[{method}]", label, np_p50, pg_p50)
+            _report_line(rec, f"eighvals[{method}]", label, np_t, pg_t)
 
     print("\nEigh eigenvalues compute-only (minimal return; excludes eigenvector copy-out)")
-    for label, shape in EIGH_CASES:
+    for label, shape in cases["eigh"]:
         a = _symmetric(rng, shape)
-        np_p50, _ = _timed(lambda x: np.linalg.eigvalsh(x), a)
+        np_t = rec.timed(lambda x: np.linalg.eigvalsh(x), a)
 
         for method in _eigh_methods():
-            pg_p50, _ = _timed(
+            pg_t = rec.timed(
                 lambda x, m=method: linalg.eigh_compute(x, method=m),
                 a,
             )
-            _report_line(f"eigh_compute[{method}]", label, np_p50, pg_p50)
+            _report_line(rec, f"eigh_compute[{method}]", label, np_t, pg_t)
+
+    print("\nLow-rank Cholesky update + solve (reference column: refactorize + solve)")
+    for n in cases["cholupdate"]:
+        m = rng.standard_normal((n, n))
+        a = m @ m.T + n * np.eye(n)
+        rhs = rng.standard_normal(n)
+        chol = linalg.cholesky_factor(a)
+        ldlt = linalg.ldlt_factor(a)
+        for k in (1, 16):
+            # Small enough that the repeated downdates of a timing run stay well inside A.
+            u = 1e-3 * rng.standard_normal((n, k))
+            a_new = a + u @ u.T
+            ref_t = rec.timed(lambda x, y: linalg.cholesky_factor(x).solve(y), a_new, rhs)
+
+            def step(factor, sign):
+                factor.update(u, sign=sign)
+                return factor.solve(rhs)
+
+            pg_t = rec.timed(step, chol, 1)
+            _report_line(rec, f"chol_update[k={k}]", f"{n}x{n}", ref_t, pg_t)
+            pg_t = rec.timed(step, chol, -1)
+            _report_line(rec, f"chol_downdate[k={k}]", f"{n}x{n}", ref_t, pg_t)
+            pg_t = rec.timed(step, ldlt, 1)
+            _report_line(rec, f"ldlt_update[k={k}]", f"{n}x{n}", ref_t, pg_t)
+
+    if sla is None:
+        return
+    print("\nGeneralized eigh a v = w b v (scipy.linalg.eigh(a, b) vs eigh(a, b); [chol] reuses b's factor)")
+    for label, shape in cases["eigh"]:
+        a = _symmetric(rng, shape)
+        m = rng.standard_normal(shape)
+        b = m @ m.T + shape[0] * np.eye(shape[0])
+        factor = linalg.cholesky_factor(b)
+        np_t = rec.timed(sla.eigh, a, b)
+        for method in _eigh_methods():
+            pg_t = rec.timed(lambda x, y, m=method: linalg.eigh(x, y, method=m), a, b)
+            _report_line(rec, f"eigh_gen[{method}]", label, np_t, pg_t)
+            pg_t = rec.timed(lambda x, m=method: linalg.eigh(x, factor, method=m), a)
+            _report_line(rec, f"eigh_gen[{method},chol]", label, np_t, pg_t)
+        hi = max(shape[0] // 10, 1) - 1
+        np_t = rec.timed(lambda x, y: sla.eigh(x, y, subset_by_index=(0, hi)), a, b)
+        pg_t = rec.timed(lambda x, y: linalg.eigh(x, y, subset_by_index=(0, hi)), a, b)
+        _report_line(rec, "eigh_gen[10%]", label, np_t, pg_t)
+
+
+def run(argv=None) -> int:
+    parser = argparse.ArgumentParser(description="Dense pEigen vs NumPy benchmarks.")
+    benchlib.add_arguments(parser, sizes_help="square sizes to sweep, e.g. 256,512,1024 (default: built-in cases)")
+    args = parser.parse_args(argv)
+
+    cases = _square_cases(args.sizes) if args.sizes else DEFAULT_CASES
+    rec = benchlib.Recorder("dense", reference="numpy", warmup=args.warmup, runs=args.runs)
+    for _ in benchlib.thread_sweep(rec, args.threads):
+        _run_suite(rec, cases)
+    return benchlib.finish(args, rec)
 
 
 if __name__ == "__main__":
-    run()
+    raise SystemExit(run())
@@ -2,11 +2,21 @@
 
 Matrices are 2D finite-difference operators on structured grids (Poisson Laplacian,
 advection–diffusion, lumped mass) rather than unstructured random sparse patterns.
+
+    python benchmarks/bench_sparse.py [--sizes 64x64,128x128] [--threads 1,4] [--json out.json]
+                                      [--baseline base.json]
+
+See benchmarks/benchlib.py for the JSON layout and the baseline comparison.
 """
 
 from __future__ import annotations
 
-import time
+import argparse
+import json
+import os
+import subprocess
+import sys
+import tempfile
 from collections.abc import Callable
 
 import numpy as np
@@ -17,6 +27,8 @@ try:
 except ImportError as exc:  # pragma: no cover
     raise SystemExit("SciPy is required for sparse benchmarks") from exc
 
+import benchlib
+import peigen
 from peigen import sparse
 
 
@@ -30,9 +42,13 @@ BENCH_GRIDS = (
     (128, 128),  # n = 16384
 )
 RHS_COLS = 8
+# Small grids (nnz ~ 300-1200) where per-call conversion dominates the kernel.
+HANDLE_GRIDS = ((8, 8), (16, 16))
 CG_RHS_COLS = 1
 CG_PRECONDITIONERS = ("none", "jacobi", "ilu")
 SOLVE_RTOL = 1e-8
+# Internal: re-run only the matrix-free operator section (see _run_operator_section).
+OPERATORS_ONLY_FLAG = "--operators-only"
 
 # ILU parameters calibrated on BENCH_GRIDS Laplacian (seed 321): both sides converge at
 # rtol=1e-8 with similar CG iteration counts (typically 3–8 iterations).
@@ -46,30 +62,41 @@ ADV_DIFF_VX = 1.0
 ADV_DIFF_VY = 0.5
 
 
-def _timed(fn, *args, warmup: int = 3, runs: int = 10):
-    for _ in range(warmup):
-        fn(*args)
-
-    durations = []
-    for _ in range(runs):
-        t0 = time.perf_counter()
-        fn(*args)
-        durations.append((time.perf_counter() - t0) * 1000.0)
-
-    durations.sort()
-    return durations[len(durations) // 2]
-
-
-def _report_line(op: str, size: str, scipy_ms: float, peigen_ms: float):
-    speedup = scipy_ms / peigen_ms if peigen_ms > 0 else float("inf")
-    print(f"{op:<30} {size:<12} {scipy_ms:>14.3f} {peigen_ms:>15.3f} {speedup:>8.2f}x")
+def _parse_grids(text: str) -> list[tuple[int, int]]:
+    """Parses `--sizes` as comma-separated NX or NXxNY grid sides."""
+    grids = []
+    for item in text.split(","):
+        item = item.strip().lower()
+        if not item:
+            continue
+        try:
+            nx, _, ny = item.partition("x")
+            grid = (int(nx), int(ny or nx))
+        except ValueError as exc:
+            raise argparse.ArgumentTypeError(f"expected grid sizes like 64 or 128x64, got {item!r}") from exc
+        if min(grid) <= 0:
+            raise argparse.ArgumentTypeError("grid sides must be positive")
+        grids.append(grid)
+    if not grids:
+        raise argparse.ArgumentTypeError("no grid sizes given")
+    return grids
+
+
+def _report_line(rec: benchlib.Recorder, op: str, size: str, scipy_t: benchlib.Timing, peigen_t: benchlib.Timing):
+    rec.add(op, size, peigen_t, scipy_t)
+    speedup = scipy_t.p50 / peigen_t.p50 if peigen_t.p50 > 0 else float("inf")
+    print(
+        f"{op:<30} {size:<12} {scipy_t.p50:>14.3f} {peigen_t.p50:>15.3f} {speedup:>8.2f}x"
+        f" {peigen_t.p99:>15.3f}"
+    )
 
 
 def _report_cg_line(
+    rec: benchlib.Recorder,
     op: str,
     size: str,
-    scipy_ms: float,
-    peigen_ms: float,
+    scipy_t: benchlib.Timing,
+    peigen_t: benchlib.Timing | None,
     *,
     scipy_iters: int,
     peigen_iters: int,
@@ -78,6 +105,22 @@ def _report_cg_line(
     scipy_ok: bool,
     peigen_ok: bool,
 ):
+    rec.add(
+        op,
+        size,
+        peigen_t,
+        scipy_t,
+        cg={
+            "scipy_iterations": scipy_iters,
+            "peigen_iterations": peigen_iters,
+            "scipy_residual": scipy_resid,
+            "peigen_residual": peigen_resid if peigen_resid == peigen_resid else None,
+            "scipy_converged": scipy_ok,
+            "peigen_converged": peigen_ok,
+        },
+    )
+    scipy_ms = scipy_t.p50
+    peigen_ms = peigen_t.p50 if peigen_t is not None else float("nan")
     if not scipy_ok or not peigen_ok:
         speedup_str = "     n/a"
     elif peigen_ms != peigen_ms:
@@ -285,11 +328,11 @@ def _scipy_cg_profile(
     }
 
 
-def _timed_cg_solve(fn, a, b) -> float:
+def _timed_cg_solve(rec: benchlib.Recorder, fn, a, b) -> benchlib.Timing | None:
     try:
-        return _timed(fn, a, b)
+        return rec.timed(fn, a, b)
     except RuntimeError:
-        return float("nan")
+        return None
 
 
 def _peigen_cg_profile(
@@ -363,37 +406,168 @@ def _peigen_iterative_solve(method: str, a, b: np.ndarray, *, rtol: float, maxit
     return sparse.solve(a, b, method=method, tol=rtol, maxiter=maxiter)
 
 
-def run():
+def _laplacian_1d(n: int) -> sp.csc_matrix:
+    return sp.diags([-1.0, 2.0, -1.0], [-1, 0, 1], shape=(n, n), format="csc")
+
+
+def _operator_cases(nx: int, ny: int):
+    """(name, build_operator, assemble) triples; both callables start from the same pieces."""
+    lap_x = _laplacian_1d(nx)
+    lap_y = _laplacian_1d(ny)
+    eye_x = sp.identity(nx, format="csc")
+    eye_y = sp.identity(ny, format="csc")
+    stiffness = laplacian_2d(nx, ny)
+    mass = lumped_mass_2d(nx, ny)
+    sigma = 1.0 / (nx * ny)
+
+    def kron_op():
+        return sparse.LinearOperator.kron(eye_y, lap_x) + sparse.LinearOperator.kron(lap_y, eye_x)
+
+    def kron_assembled():
+        return (sp.kron(eye_y, lap_x) + sp.kron(lap_y, eye_x)).tocsc()
+
+    def shifted_op():
+        return sparse.aslinearoperator(stiffness) + sigma * sparse.aslinearoperator(mass)
+
+    def shifted_assembled():
+        return (stiffness + sigma * mass).tocsc()
+
+    return (
+        ("kronsum", kron_op, kron_assembled),
+        ("shifted", shifted_op, shifted_assembled),
+    )
+
+
+def _baseline_isa() -> str:
+    """The baseline kernel variant; cpu_isa_supported lists it first."""
+    return peigen.build_config()["cpu_isa_supported"][0]
+
+
+def _operator_section(rec: benchlib.Recorder, grids, rng):
+    for nx, ny in grids:
+        n = nx * ny
+        b = rng.standard_normal(n)
+        label = _grid_label(nx, ny)
+        maxiter = _maxiter(n, method="cg")
+        kwargs = {"method": "cg", "tol": SOLVE_RTOL, "maxiter": maxiter, "preconditioner": "jacobi"}
+
+        for name, build_op, assemble in _operator_cases(nx, ny):
+            assembled_t = rec.timed(lambda y, f=assemble: sparse.solve(f(), y, **kwargs), b)
+            operator_t = rec.timed(lambda y, f=build_op: sparse.solve(f(), y, **kwargs), b)
+            op_label = f"linop_solve[{name}]"
+            rec.add(
+                op_label,
+                label,
+                operator_t,
+                None,
+                assembled=assembled_t.summary(),
+                kernel_isa=peigen.build_config()["kernel_isa"],
+            )
+            speedup = assembled_t.p50 / operator_t.p50 if operator_t.p50 > 0 else float("inf")
+            print(
+                f"{op_label:<30} {label:<12} {assembled_t.p50:>14.3f} {operator_t.p50:>15.3f} {speedup:>8.2f}x"
+                f" {operator_t.p99:>15.3f}"
+            )
+
+
+def _run_operator_section(rec: benchlib.Recorder, grids, rng):
+    """Times operator vs assembled CG with both sides at the baseline ISA.
+
+    Matrix-free CG runs in the core library at the baseline ISA, while assembled CG uses the
+    dispatched kernels. When this process loaded a wider variant, the section re-runs in a
+    child with PEIGEN_ISA pinned, so the comparison measures the operator design rather than
+    the instruction set.
+    """
+    isa = _baseline_isa()
+    print(f"\nMatrix-free operators vs assembled (build + CG jacobi, PEIGEN_ISA={isa}; columns: assembled, operator)")
+    if peigen.build_config()["kernel_isa"] == isa:
+        _operator_section(rec, grids, rng)
+        return
+
+    with tempfile.TemporaryDirectory() as tmp:
+        out = os.path.join(tmp, "operators.json")
+        argv = [sys.executable, os.path.abspath(__file__), OPERATORS_ONLY_FLAG, "--json", out]
+        argv += ["--sizes", ",".join(f"{nx}x{ny}" for nx, ny in grids)]
+        argv += ["--runs", str(rec.runs), "--warmup", str(rec.warmup), "--threads", str(rec.threads)]
+        sys.stdout.flush()
+        subprocess.run(argv, env=dict(os.environ, PEIGEN_ISA=isa), check=True)
+        with open(out, encoding="utf-8") as fh:
+            results = json.load(fh)["results"]
+    for result in results:
+        result["threads"] = rec.threads
+    rec.results.extend(results)
+
+
+def _run_suite(rec: benchlib.Recorder, grids):
     rng = np.random.default_rng(321)
 
-    print(f"{'op':<30} {'size':<12} {'scipy_p50(ms)':>14} {'peigen_p50(ms)':>15} {'speedup':>8}")
-    print("-" * 80)
+    print(
+        f"{'op':<30} {'size':<12} {'scipy_p50(ms)':>14} {'peigen_p50(ms)':>15} {'speedup':>8}"
+        f" {'peigen_p99(ms)':>15}"
+    )
+    print("-" * 96)
     print(
         "Grid operators: 5-point Laplacian (SPD/CG), upwind advection–diffusion "
         "(LU/BiCGSTAB), stiffness @ lumped mass (spspmm)"
     )
-    print("-" * 80)
+    print("-" * 96)
 
     print("\nSpmm (sparse @ dense; Laplacian operator)")
-    for nx, ny in BENCH_GRIDS:
+    for nx, ny in grids:
         a = laplacian_2d(nx, ny)
         n = nx * ny
         b = rng.standard_normal((n, RHS_COLS))
         label = _grid_label(nx, ny)
 
-        scipy_ms = _timed(lambda x, y: x @ y, a, b)
-        peigen_ms = _timed(sparse.spmm, a, b)
-        _report_line("spmm", label, scipy_ms, peigen_ms)
+        scipy_t = rec.timed(lambda x, y: x @ y, a, b)
+        peigen_t = rec.timed(sparse.spmm, a, b)
+        _report_line(rec, "spmm", label, scipy_t, peigen_t)
+
+    print("\nFused sparse kernels (axpby into out, A^T B, A^T A x, SDDMM k=16; Laplacian pattern)")
+    for nx, ny in grids:
+        a = laplacian_2d(nx, ny)
+        n = nx * ny
+        b = rng.standard_normal((n, RHS_COLS))
+        y = rng.standard_normal((n, RHS_COLS))
+        x = rng.standard_normal(n)
+        u = rng.standard_normal((n, 16))
+        v = rng.standard_normal((n, 16))
+        coo = a.tocoo()
+        label = _grid_label(nx, ny)
+
+        def scipy_axpby(m, rhs, out):
+            out *= 0.5
+            out += 2.0 * (m @ rhs)
+
+        scipy_t = rec.timed(scipy_axpby, a, b, y.copy())
+        peigen_t = rec.timed(lambda m, rhs, out: sparse.spmm(m, rhs, alpha=2.0, beta=0.5, out=out), a, b, y.copy())
+        _report_line(rec, "spmm_axpby", label, scipy_t, peigen_t)
+
+        scipy_t = rec.timed(lambda m, rhs: m.T @ rhs, a, b)
+        peigen_t = rec.timed(lambda m, rhs: sparse.spmm(m, rhs, transpose=True), a, b)
+        _report_line(rec, "spmm_t", label, scipy_t, peigen_t)
+
+        scipy_t = rec.timed(lambda m, rhs: m.T @ (m @ rhs), a, x)
+        peigen_t = rec.timed(sparse.normal_matmul, a, x)
+        _report_line(rec, "normal_matmul", label, scipy_t, peigen_t)
+
+        def scipy_sddmm(m, left, right):
+            vals = coo.data * np.einsum("ij,ij->i", left[coo.row], right[coo.col])
+            return sp.csc_matrix((vals, (coo.row, coo.col)), shape=m.shape)
+
+        scipy_t = rec.timed(scipy_sddmm, a, u, v)
+        peigen_t = rec.timed(sparse.sddmm, a, u, v)
+        _report_line(rec, "sddmm[k=16]", label, scipy_t, peigen_t)
 
     print("\nSpspmm (stiffness @ lumped mass, copy-out)")
-    for nx, ny in BENCH_GRIDS:
+    for nx, ny in grids:
         stiffness = laplacian_2d(nx, ny)
         mass = lumped_mass_2d(nx, ny)
         label = _grid_label(nx, ny)
 
-        scipy_ms = _timed(lambda k, m: k @ m, stiffness, mass)
-        peigen_ms = _timed(sparse.spspmm, stiffness, mass)
-        _report_line("spspmm", label, scipy_ms, peigen_ms)
+        scipy_t = rec.timed(lambda k, m: k @ m, stiffness, mass)
+        peigen_t = rec.timed(sparse.spspmm, stiffness, mass)
+        _report_line(rec, "spspmm", label, scipy_t, peigen_t)
 
     print("\nSparse solve [CG] (setup + solve; 2D Laplacian, SPD; single RHS)")
     print(
@@ -404,7 +578,7 @@ def run():
         f"ILU tuning: SciPy spilu(fill={SCIPY_ILU_FILL_FACTOR}, drop_tol={ILU_DROP_TOL}); "
         f"pEigen IncompleteLUT(fill={EIGEN_ILU_FILL_FACTOR}, drop_tol={ILU_DROP_TOL})."
     )
-    for nx, ny in BENCH_GRIDS:
+    for nx, ny in grids:
         a = laplacian_2d(nx, ny)
         n = nx * ny
         b = rng.standard_normal(n)
@@ -414,14 +588,15 @@ def run():
         for preconditioner in CG_PRECONDITIONERS:
             op = f"sparse_solve[cg,{preconditioner}]"
 
-            scipy_ms = _timed(
+            scipy_t = rec.timed(
                 lambda x, y, pre=preconditioner: _scipy_cg_solve(
                     x, y, rtol=SOLVE_RTOL, maxiter=maxiter, preconditioner=pre
                 ),
                 a,
                 b,
             )
-            peigen_ms = _timed_cg_solve(
+            peigen_t = _timed_cg_solve(
+                rec,
                 lambda x, y, pre=preconditioner: _peigen_cg_solve(
                     x, y, rtol=SOLVE_RTOL, maxiter=maxiter, preconditioner=pre
                 ),
@@ -435,10 +610,11 @@ def run():
                 a, b, rtol=SOLVE_RTOL, maxiter=maxiter, preconditioner=preconditioner
             )
             _report_cg_line(
+                rec,
                 op,
                 label,
-                scipy_ms,
-                peigen_ms,
+                scipy_t,
+                peigen_t,
                 scipy_iters=scipy_prof["iters"],
                 peigen_iters=peigen_prof["iters"],
                 scipy_resid=scipy_prof["residual"],
@@ -448,49 +624,153 @@ def run():
             )
 
     print("\nSparse solve [BiCGSTAB] (setup + solve; advection–diffusion)")
-    for nx, ny in BENCH_GRIDS:
+    for nx, ny in grids:
         a = advection_diffusion_2d(nx, ny)
         n = nx * ny
         b = rng.standard_normal((n, RHS_COLS))
         label = _grid_label(nx, ny)
         maxiter = _maxiter(n, method="bicgstab")
 
-        scipy_ms = _timed(
+        scipy_t = rec.timed(
             lambda x, y: _scipy_iterative_solve(
                 spla.bicgstab, x, y, rtol=SOLVE_RTOL, maxiter=maxiter
             ),
             a,
             b,
         )
-        peigen_ms = _timed(
+        peigen_t = rec.timed(
             lambda x, y: _peigen_iterative_solve(
                 "bicgstab", x, y, rtol=SOLVE_RTOL, maxiter=maxiter
             ),
             a,
             b,
         )
-        _report_line("sparse_solve[bicgstab]", label, scipy_ms, peigen_ms)
+        _report_line(rec, "sparse_solve[bicgstab]", label, scipy_t, peigen_t)
 
     print("\nSparse factorize [LU] (pattern + numeric factorization; advection–diffusion)")
-    for nx, ny in BENCH_GRIDS:
+    for nx, ny in grids:
         a = advection_diffusion_2d(nx, ny)
         label = _grid_label(nx, ny)
 
-        scipy_ms = _timed(lambda x: spla.splu(x.tocsc()), a)
-        peigen_ms = _timed(sparse.factorize, a)
-        _report_line("sparse_factorize[lu]", label, scipy_ms, peigen_ms)
+        scipy_t = rec.timed(lambda x: spla.splu(x.tocsc()), a)
+        peigen_t = rec.timed(sparse.factorize, a)
+        _report_line(rec, "sparse_factorize[lu]", label, scipy_t, peigen_t)
 
     print("\nSparse solve [LU] (factorize + solve; advection–diffusion)")
-    for nx, ny in BENCH_GRIDS:
+    for nx, ny in grids:
+        a = advection_diffusion_2d(nx, ny)
+        n = nx * ny
+        b = rng.standard_normal((n, RHS_COLS))
+        label = _grid_label(nx, ny)
+
+        scipy_t = rec.timed(spla.spsolve, a, b)
+        peigen_t = rec.timed(lambda x, y: sparse.solve(x, y, method="lu"), a, b)
+        _report_line(rec, "sparse_solve[lu]", label, scipy_t, peigen_t)
+        peigen_t = rec.timed(lambda x, y: sparse.solve(x, y, method="lu", precision="mixed"), a, b)
+        _report_line(rec, "sparse_solve[lu,mixed]", label, scipy_t, peigen_t)
+
+    print("\nSparse solve [LU] with factor cache (repeat solve, same A; columns: uncached, cached)")
+    for nx, ny in grids:
         a = advection_diffusion_2d(nx, ny)
+        b = rng.standard_normal((nx * ny, RHS_COLS))
+        label = _grid_label(nx, ny)
+
+        uncached_t = rec.timed(lambda x, y: sparse.solve(x, y, method="lu"), a, b)
+        with peigen.factor_cache():
+            cached_t = rec.timed(lambda x, y: sparse.solve(x, y, method="lu"), a, b)
+        peigen.clear_factor_cache()
+        _report_line(rec, "sparse_solve[lu,cached]", label, uncached_t, cached_t)
+
+    _run_operator_section(rec, grids, rng)
+
+    print("\nSparse least squares (advection–diffusion stacked on 0.1 I, 2n x n; vs scipy lsqr)")
+    for nx, ny in grids:
+        n = nx * ny
+        a = sp.vstack([advection_diffusion_2d(nx, ny), 0.1 * sp.identity(n)]).tocsc()
+        b = rng.standard_normal(2 * n)
+        label = _grid_label(nx, ny)
+        maxiter = _maxiter(n, method="cg")
+
+        scipy_t = rec.timed(lambda x, y: spla.lsqr(x, y, atol=SOLVE_RTOL, btol=SOLVE_RTOL, iter_lim=maxiter), a, b)
+        peigen_t = rec.timed(lambda x, y: sparse.lstsq(x, y, method="qr"), a, b)
+        _report_line(rec, "lstsq[qr]", label, scipy_t, peigen_t)
+        peigen_t = rec.timed(lambda x, y: sparse.lstsq(x, y, method="lscg", tol=SOLVE_RTOL, maxiter=maxiter), a, b)
+        _report_line(rec, "lstsq[lscg]", label, scipy_t, peigen_t)
+        fac = sparse.factorize(a, method="qr")
+        peigen_t = rec.timed(fac.solve, b)
+        _report_line(rec, "lstsq[qr,factored]", label, scipy_t, peigen_t)
+
+    print("\nReordering (shuffled Laplacian; columns: shuffled, reordered via permuted=)")
+    for nx, ny in grids:
+        shuffle = rng.permutation(nx * ny)
+        a = sparse.Matrix(laplacian_2d(nx, ny)[shuffle][:, shuffle].tocsc())
         n = nx * ny
         b = rng.standard_normal((n, RHS_COLS))
+        x = rng.standard_normal(n)
         label = _grid_label(nx, ny)
+        maxiter = _maxiter(n, method="cg")
+        kwargs = {"method": "cg", "tol": SOLVE_RTOL, "maxiter": maxiter, "preconditioner": "jacobi"}
+
+        for method in ("rcm", "nd"):
+            reorder_t = rec.timed(sparse.reorder, a, method)
+            r = sparse.reorder(a, method=method)
+            cases = (
+                (f"spmm[{method}]", lambda: sparse.spmm(a, b), lambda: sparse.spmm(a, b, permuted=r)),
+                (
+                    f"cg_solve[{method}]",
+                    lambda: sparse.solve(a, x, **kwargs),
+                    lambda: sparse.solve(a, x, permuted=r, **kwargs),
+                ),
+            )
+            for op_label, shuffled_fn, reordered_fn in cases:
+                shuffled_t = rec.timed(shuffled_fn)
+                reordered_t = rec.timed(reordered_fn)
+                rec.add(
+                    op_label, label, reordered_t, None, shuffled=shuffled_t.summary(), reorder=reorder_t.summary()
+                )
+                speedup = shuffled_t.p50 / reordered_t.p50 if reordered_t.p50 > 0 else float("inf")
+                print(
+                    f"{op_label:<30} {label:<12} {shuffled_t.p50:>14.3f} {reordered_t.p50:>15.3f} {speedup:>8.2f}x"
+                    f" {reordered_t.p99:>15.3f}  (reorder once: {reorder_t.p50:.3f})"
+                )
+
+    print("\nSmall-matrix call overhead (spmm, single vector; columns: scipy, sparse.Matrix handle)")
+    for nx, ny in HANDLE_GRIDS:
+        a = laplacian_2d(nx, ny)
+        handle = sparse.Matrix(a)
+        x = rng.standard_normal(nx * ny)
+        label = f"{_grid_label(nx, ny)},nnz={a.nnz}"
+
+        scipy_t = rec.timed(lambda m, y: m @ y, a, x)
+        converted_t = rec.timed(sparse.spmm, a, x[:, None])
+        handle_t = rec.timed(lambda m, y: m @ y, handle, x)
+        rec.add("spmm[handle]", label, handle_t, scipy_t, scipy_input=converted_t.summary())
+        speedup = scipy_t.p50 / handle_t.p50 if handle_t.p50 > 0 else float("inf")
+        print(
+            f"{'spmm[handle]':<30} {label:<12} {scipy_t.p50:>14.3f} {handle_t.p50:>15.3f} {speedup:>8.2f}x"
+            f" {handle_t.p99:>15.3f}  (scipy input: {converted_t.p50:.3f})"
+        )
+
+
+def run(argv=None) -> int:
+    parser = argparse.ArgumentParser(description="Sparse pEigen vs SciPy benchmarks.")
+    benchlib.add_arguments(
+        parser,
+        sizes_help="grid sides to sweep, e.g. 64,128x64 (default: built-in grids)",
+        sizes_type=_parse_grids,
+    )
+    parser.add_argument(OPERATORS_ONLY_FLAG, action="store_true", help=argparse.SUPPRESS)
+    args = parser.parse_args(argv)
 
-        scipy_ms = _timed(spla.spsolve, a, b)
-        peigen_ms = _timed(lambda x, y: sparse.solve(x, y, method="lu"), a, b)
-        _report_line("sparse_solve[lu]", label, scipy_ms, peigen_ms)
+    grids = args.sizes or BENCH_GRIDS
+    rec = benchlib.Recorder("sparse", reference="scipy", warmup=args.warmup, runs=args.runs)
+    for _ in benchlib.thread_sweep(rec, args.threads):
+        if args.operators_only:
+            _operator_section(rec, grids, np.random.default_rng(321))
+        else:
+            _run_suite(rec, grids)
+    return benchlib.finish(args, rec)
 
 
 if __name__ == "__main__":
-    run()
+    raise SystemExit(run())
@@ -0,0 +1,113 @@
+"""Optional thread-scaling benchmarks for pEigen dense and sparse kernels.
+
+Each kernel is timed under `peigen.threadpool_limits(n)` for a doubling sweep of thread
+counts up to the default (all cores), so Eigen, OpenMP and the BLAS backend are limited
+together. Efficiency is `t(1) / (n * t(n))`.
+"""
+
+from __future__ import annotations
+
+import time
+
+import numpy as np
+
+import peigen
+from peigen import linalg, sparse
+
+DENSE_N = 1024
+SPARSE_GRID = (256, 256)
+RHS_COLS = 8
+
+
+def _timed(fn, *args, warmup: int = 2, runs: int = 7):
+    for _ in range(warmup):
+        fn(*args)
+
+    durations = []
+    for _ in range(runs):
+        t0 = time.perf_counter()
+        fn(*args)
+        durations.append((time.perf_counter() - t0) * 1000.0)
+
+    durations.sort()
+    return durations[len(durations) // 2]
+
+
+def _thread_counts() -> list[int]:
+    max_threads = peigen.thread_info()["default"]
+    counts = []
+    n = 1
+    while n < max_threads:
+        counts.append(n)
+        n *= 2
+    counts.append(max_threads)
+    return counts
+
+
+def _report_header():
+    print(f"{'op':<22} {'threads':>7} {'p50(ms)':>12} {'speedup':>8} {'efficiency':>10}")
+
+
+def _report_line(op: str, threads: int, ms: float, base_ms: float):
+    speedup = base_ms / ms if ms > 0 else float("inf")
+    print(f"{op:<22} {threads:>7} {ms:>12.3f} {speedup:>7.2f}x {speedup / threads:>10.2f}")
+
+
+def _scale(op: str, fn, *args):
+    base_ms = None
+    for threads in _thread_counts():
+        with peigen.threadpool_limits(threads):
+            ms = _timed(fn, *args)
+        if base_ms is None:
+            base_ms = ms
+        _report_line(op, threads, ms, base_ms)
+
+
+def _laplacian_2d(nx: int, ny: int):
+    import scipy.sparse as sp
+
+    ex = np.ones(nx)
+    ey = np.ones(ny)
+    tx = sp.diags([-ex[:-1], 2 * ex, -ex[:-1]], [-1, 0, 1])
+    ty = sp.diags([-ey[:-1], 2 * ey, -ey[:-1]], [-1, 0, 1])
+    return (sp.kron(sp.eye(ny), tx) + sp.kron(ty, sp.eye(nx))).tocsc()
+
+
+def run():
+    rng = np.random.default_rng(7)
+    info = peigen.thread_info()
+    print(
+        f"threads: default={info['default']} openmp={peigen.build_config()['openmp_enabled']} "
+        f"blas_api={info['blas_threading_api']}"
+    )
+    _report_header()
+    print("-" * 63)
+
+    a = rng.standard_normal((DENSE_N, DENSE_N))
+    b = rng.standard_normal((DENSE_N, DENSE_N))
+    spd = a @ a.T + DENSE_N * np.eye(DENSE_N)
+    rhs = rng.standard_normal((DENSE_N, RHS_COLS))
+
+    _scale(f"matmul {DENSE_N}", linalg.matmul, a, b)
+    _scale(f"solve[eigen] {DENSE_N}", lambda x, y: linalg.solve(x, y, method="eigen"), a, rhs)
+    _scale(f"solve[auto] {DENSE_N}", lambda x, y: linalg.solve(x, y, method="auto"), a, rhs)
+    _scale(f"svd[bdcsvd] {DENSE_N // 2}", lambda x: linalg.svd_compute(x, method="bdcsvd"), a[: DENSE_N // 2])
+    _scale(f"eigh[auto] {DENSE_N}", lambda x: linalg.eigh_compute(x), spd)
+
+    try:
+        lap = _laplacian_2d(*SPARSE_GRID)
+    except ImportError:
+        return
+    n = lap.shape[0]
+    x = rng.standard_normal((n, RHS_COLS))
+    _scale(f"spmm n={n}", sparse.spmm, lap, x)
+    _scale(
+        f"cg[jacobi] n={n}",
+        lambda m, y: sparse.solve(m, y, method="cg", preconditioner="jacobi", maxiter=10 * n),
+        lap,
+        x[:, 0],
+    )
+
+
+if __name__ == "__main__":
+    run()
@@ -0,0 +1,321 @@
+"""Shared timing, JSON reporting and baseline comparison for the pEigen benchmark scripts.
+
+Each script records one entry per (op, size, threads) with the full list of pEigen and
+reference (NumPy/SciPy) samples, so a later run can be compared against a saved baseline
+with a rank test instead of eyeballing medians:
+
+    python benchmarks/bench_dense.py --json base.json
+    python benchmarks/bench_dense.py --baseline base.json        # exit 1 on regression
+    python benchmarks/compare_bench.py base.json current.json    # offline comparison
+"""
+
+from __future__ import annotations
+
+import argparse
+import datetime as _dt
+import json
+import math
+import os
+import platform
+import sys
+import time
+from collections.abc import Iterator
+from dataclasses import dataclass
+
+SCHEMA_VERSION = 1
+DEFAULT_THRESHOLD = 0.05
+DEFAULT_ALPHA = 0.01
+
+
+@dataclass
+class Timing:
+    """Sorted wall-clock samples in milliseconds."""
+
+    samples: list[float]
+
+    def percentile(self, q: float) -> float:
+        return percentile(self.samples, q)
+
+    @property
+    def p50(self) -> float:
+        return self.percentile(50.0)
+
+    @property
+    def p90(self) -> float:
+        return self.percentile(90.0)
+
+    @property
+    def p99(self) -> float:
+        return self.percentile(99.0)
+
+    def summary(self) -> dict:
+        mean = sum(self.samples) / len(self.samples)
+        var = sum((s - mean) ** 2 for s in self.samples) / max(len(self.samples) - 1, 1)
+        return {
+            "min_ms": self.samples[0],
+            "p50_ms": self.p50,
+            "p90_ms": self.p90,
+            "p99_ms": self.p99,
+            "mean_ms": mean,
+            "stdev_ms": math.sqrt(var),
+            "runs": len(self.samples),
+            "samples_ms": list(self.samples),
+        }
+
+
+def percentile(sorted_samples: list[float], q: float) -> float:
+    """Linear-interpolated percentile of already sorted samples (q in [0, 100])."""
+    if not sorted_samples:
+        raise ValueError("percentile of empty sample list")
+    pos = (len(sorted_samples) - 1) * q / 100.0
+    lo = int(math.floor(pos))
+    hi = min(lo + 1, len(sorted_samples) - 1)
+    return sorted_samples[lo] + (sorted_samples[hi] - sorted_samples[lo]) * (pos - lo)
+
+
+def timed(fn, *args, warmup: int = 3, runs: int = 10) -> Timing:
+    for _ in range(warmup):
+        fn(*args)
+
+    durations = []
+    for _ in range(runs):
+        t0 = time.perf_counter()
+        fn(*args)
+        durations.append((time.perf_counter() - t0) * 1000.0)
+
+    durations.sort()
+    return Timing(durations)
+
+
+def peak_rss_mb() -> float | None:
+    """Process high-water-mark RSS in MiB (None where getrusage is unavailable)."""
+    try:
+        import resource
+    except ImportError:  # pragma: no cover - Windows
+        return None
+    rss = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    # Linux reports KiB, macOS bytes.
+    return rss / (1024.0 * 1024.0) if sys.platform == "darwin" else rss / 1024.0
+
+
+def environment() -> dict:
+    import numpy as np
+
+    import peigen
+
+    env = {
+        "timestamp": _dt.datetime.now(_dt.timezone.utc).isoformat(timespec="seconds"),
+        "python": platform.python_version(),
+        "platform": platform.platform(),
+        "machine": platform.machine(),
+        "processor": platform.processor(),
+        "cpu_count": os.cpu_count(),
+        "numpy": np.__version__,
+        "build_config": peigen.build_config(),
+        "thread_info": peigen.thread_info(),
+        "env": {k: os.environ[k] for k in sorted(os.environ) if k.startswith(("PEIGEN_", "OMP_", "OPENBLAS_"))},
+    }
+    try:
+        import scipy
+
+        env["scipy"] = scipy.__version__
+    except ImportError:
+        env["scipy"] = None
+    return env
+
+
+class Recorder:
+    """Collects benchmark results for one suite and serializes them to JSON."""
+
+    def __init__(self, suite: str, *, reference: str, warmup: int, runs: int):
+        self.suite = suite
+        self.reference = reference
+        self.warmup = warmup
+        self.runs = runs
+        self.threads: int | None = None
+        self.results: list[dict] = []
+
+    def timed(self, fn, *args) -> Timing:
+        return timed(fn, *args, warmup=self.warmup, runs=self.runs)
+
+    def add(self, op: str, size: str, peigen_timing: Timing | None, reference_timing: Timing | None, **extra):
+        self.results.append(
+            {
+                "op": op,
+                "size": size,
+                "threads": self.threads,
+                "peigen": peigen_timing.summary() if peigen_timing is not None else None,
+                self.reference: reference_timing.summary() if reference_timing is not None else None,
+                "peak_rss_mb": peak_rss_mb(),
+                **extra,
+            }
+        )
+
+    def to_json(self) -> dict:
+        return {
+            "schema": SCHEMA_VERSION,
+            "suite": self.suite,
+            "reference": self.reference,
+            "warmup": self.warmup,
+            "runs": self.runs,
+            "environment": environment(),
+            "results": self.results,
+        }
+
+    def write(self, path: str):
+        with open(path, "w", encoding="utf-8") as fh:
+            json.dump(self.to_json(), fh, indent=2)
+            fh.write("\n")
+
+
+def _result_key(result: dict) -> tuple:
+    return (result["op"], result["size"], result.get("threads"))
+
+
+def mann_whitney_greater(baseline: list[float], current: list[float]) -> float:
+    """One-sided Mann-Whitney U p-value for "current is slower than baseline".
+
+    Uses the normal approximation with tie correction, which is adequate for the
+    10+ samples per side the benchmark scripts collect.
+    """
+    n1 = len(baseline)
+    n2 = len(current)
+    if n1 == 0 or n2 == 0:
+        return 1.0
+
+    pooled = sorted([(v, 0) for v in baseline] + [(v, 1) for v in current])
+    ranks = [0.0] * len(pooled)
+    tie_term = 0.0
+    i = 0
+    while i < len(pooled):
+        j = i
+        while j + 1 < len(pooled) and pooled[j + 1][0] == pooled[i][0]:
+            j += 1
+        avg_rank = (i + j) / 2.0 + 1.0
+        for k in range(i, j + 1):
+            ranks[k] = avg_rank
+        t = j - i + 1
+        tie_term += t**3 - t
+        i = j + 1
+
+    rank_sum_current = sum(r for r, (_, group) in zip(ranks, pooled) if group == 1)
+    u = rank_sum_current - n2 * (n2 + 1) / 2.0
+    mean_u = n1 * n2 / 2.0
+    n = n1 + n2
+    var_u = n1 * n2 / 12.0 * ((n + 1) - tie_term / (n * (n - 1)))
+    if var_u <= 0.0:
+        return 1.0
+    z = (u - mean_u - 0.5) / math.sqrt(var_u)
+    return 0.5 * math.erfc(z / math.sqrt(2.0))
+
+
+def compare(baseline: dict, current: dict, *, threshold: float = DEFAULT_THRESHOLD, alpha: float = DEFAULT_ALPHA):
+    """Compares pEigen timings of two result files.
+
+    An entry is a regression when its median slowed down by more than `threshold`
+    (relative) and the rank test rejects "no slowdown" at level `alpha`; improvements
+    are flagged symmetrically. Returns a list of row dicts in current-file order.
+    """
+    base_by_key = {_result_key(r): r for r in baseline.get("results", []) if r.get("peigen")}
+    rows = []
+    for result in current.get("results", []):
+        key = _result_key(result)
+        cur = result.get("peigen")
+        base = base_by_key.pop(key, {}).get("peigen")
+        row = {"op": key[0], "size": key[1], "threads": key[2], "status": "new", "ratio": None, "p_value": None}
+        if cur is not None and base is not None:
+            ratio = cur["p50_ms"] / base["p50_ms"] if base["p50_ms"] > 0 else float("inf")
+            p_slower = mann_whitney_greater(base["samples_ms"], cur["samples_ms"])
+            p_faster = mann_whitney_greater(cur["samples_ms"], base["samples_ms"])
+            status = "same"
+            if ratio > 1.0 + threshold and p_slower < alpha:
+                status = "slower"
+            elif ratio < 1.0 - threshold and p_faster < alpha:
+                status = "faster"
+            row.update(
+                status=status,
+                ratio=ratio,
+                p_value=p_slower if ratio >= 1.0 else p_faster,
+                base_p50_ms=base["p50_ms"],
+                p50_ms=cur["p50_ms"],
+            )
+        elif cur is None and base is not None:
+            row["status"] = "failed"
+        rows.append(row)
+    for key in base_by_key:
+        rows.append({"op": key[0], "size": key[1], "threads": key[2], "status": "missing", "ratio": None, "p_value": None})
+    return rows
+
+
+def print_comparison(rows: list[dict], *, verbose: bool = False) -> int:
+    """Prints the comparison table and returns the number of regressions."""
+    print(f"{'op':<30} {'size':<16} {'thr':>4} {'base_p50':>10} {'p50':>10} {'ratio':>7} {'p':>8}  status")
+    print("-" * 100)
+    regressions = 0
+    for row in rows:
+        if row["status"] in ("slower", "failed"):
+            regressions += 1
+        if not verbose and row["status"] == "same":
+            continue
+        threads = "-" if row["threads"] is None else str(row["threads"])
+        if row["ratio"] is None:
+            print(f"{row['op']:<30} {row['size']:<16} {threads:>4} {'':>10} {'':>10} {'':>7} {'':>8}  {row['status']}")
+            continue
+        print(
+            f"{row['op']:<30} {row['size']:<16} {threads:>4} {row['base_p50_ms']:>10.3f} {row['p50_ms']:>10.3f} "
+            f"{row['ratio']:>6.2f}x {row['p_value']:>8.1e}  {row['status']}"
+        )
+    counts: dict[str, int] = {}
+    for row in rows:
+        counts[row["status"]] = counts.get(row["status"], 0) + 1
+    print("summary: " + ", ".join(f"{k}={v}" for k, v in sorted(counts.items())))
+    return regressions
+
+
+def parse_int_list(text: str) -> list[int]:
+    try:
+        values = [int(item) for item in text.split(",") if item.strip()]
+    except ValueError as exc:
+        raise argparse.ArgumentTypeError(f"expected comma-separated integers, got {text!r}") from exc
+    if not values or any(v <= 0 for v in values):
+        raise argparse.ArgumentTypeError("values must be positive integers")
+    return values
+
+
+def add_arguments(parser: argparse.ArgumentParser, *, sizes_help: str, sizes_type=parse_int_list):
+    parser.add_argument("--json", metavar="PATH", help="write machine-readable results to PATH")
+    parser.add_argument("--baseline", metavar="PATH", help="compare against a saved --json file; exit 1 on regression")
+    parser.add_argument("--threshold", type=float, default=DEFAULT_THRESHOLD, help="relative median slowdown to flag")
+    parser.add_argument("--alpha", type=float, default=DEFAULT_ALPHA, help="significance level of the rank test")
+    parser.add_argument("--threads", type=parse_int_list, help="thread-count sweep, e.g. 1,2,4 (default: current)")
+    parser.add_argument("--sizes", type=sizes_type, help=sizes_help)
+    parser.add_argument("--runs", type=int, default=10, help="timed runs per measurement")
+    parser.add_argument("--warmup", type=int, default=3, help="untimed warmup runs per measurement")
+
+
+def thread_sweep(recorder: Recorder, threads: list[int] | None) -> Iterator[int | None]:
+    """Yields once per requested thread count with all thread pools limited accordingly."""
+    import peigen
+
+    if not threads:
+        recorder.threads = peigen.get_num_threads()
+        yield None
+        return
+    for n in threads:
+        recorder.threads = n
+        print(f"\n=== threads={n} ===")
+        with peigen.threadpool_limits(n):
+            yield n
+
+
+def finish(args: argparse.Namespace, recorder: Recorder) -> int:
+    """Writes JSON and runs the baseline comparison; returns the process exit code."""
+    if args.json:
+        recorder.write(args.json)
+    if not args.baseline:
+        return 0
+    with open(args.baseline, encoding="utf-8") as fh:
+        baseline = json.load(fh)
+    print(f"\nComparison against {args.baseline} (threshold={args.threshold:.0%}, alpha={args.alpha})")
+    rows = compare(baseline, {"results": recorder.results}, threshold=args.threshold, alpha=args.alpha)
+    return 1 if print_comparison(rows) else 0
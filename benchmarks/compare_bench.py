@@ -0,0 +1,37 @@
+"""Compare two benchmark JSON files written with `--json` and flag significant slowdowns.
+
+    python benchmarks/compare_bench.py baseline.json current.json [--threshold 0.05] [--alpha 0.01]
+
+Exits with status 1 when any op is significantly slower (or failed) in the current run.
+"""
+
+from __future__ import annotations
+
+import argparse
+import json
+
+import benchlib
+
+
+def main(argv=None) -> int:
+    parser = argparse.ArgumentParser(description="Compare pEigen benchmark results against a baseline.")
+    parser.add_argument("baseline", help="baseline JSON file")
+    parser.add_argument("current", help="current JSON file")
+    parser.add_argument("--threshold", type=float, default=benchlib.DEFAULT_THRESHOLD)
+    parser.add_argument("--alpha", type=float, default=benchlib.DEFAULT_ALPHA)
+    parser.add_argument("--verbose", action="store_true", help="also list unchanged ops")
+    args = parser.parse_args(argv)
+
+    with open(args.baseline, encoding="utf-8") as fh:
+        baseline = json.load(fh)
+    with open(args.current, encoding="utf-8") as fh:
+        current = json.load(fh)
+    if baseline.get("suite") != current.get("suite"):
+        print(f"warning: comparing suite {current.get('suite')!r} against {baseline.get('suite')!r}")
+
+    rows = benchlib.compare(baseline, current, threshold=args.threshold, alpha=args.alpha)
+    return 1 if benchlib.print_comparison(rows, verbose=args.verbose) else 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
@@ -0,0 +1,383 @@
+// Native microbenchmarks for the pEigen compute layer (src/core).
+//
+// Times the same kernels the Python bindings call, without pybind11 conversion or
+// interpreter overhead, and reports min/median/p99 wall time plus GFLOP/s and GB/s from
+// simple analytic operation counts. Build with -DPEIGEN_BUILD_NATIVE_BENCH=ON and run the
+// `bench_native` target, or invoke peigen_bench directly:
+//
+//   peigen_bench [--json PATH|-] [--filter SUBSTR] [--runs N] [--warmup N]
+//                [--dense-n N] [--grid N] [--rhs N] [--threads N]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+#include <Eigen/Sparse>
+
+#include "core/common.h"
+#include "core/dense.h"
+#include "core/dispatch.h"
+#include "core/sparse.h"
+#include "core/threads.h"
+
+#ifndef PEIGEN_BLAS_BACKEND
+#define PEIGEN_BLAS_BACKEND "unknown"
+#endif
+#ifndef PEIGEN_LAPACK_BACKEND
+#define PEIGEN_LAPACK_BACKEND "none"
+#endif
+
+namespace {
+
+using peigen::ColMatrix;
+using peigen::RowMatrix;
+using peigen::Sparse;
+
+struct Options {
+  std::string json_path;
+  std::string filter;
+  int runs = 15;
+  int warmup = 3;
+  int dense_n = 512;
+  int grid = 128;
+  int rhs = 8;
+  int threads = 0;
+};
+
+struct Result {
+  std::string name;
+  std::string group;
+  long long size = 0;
+  int runs = 0;
+  double min_ms = 0.0;
+  double median_ms = 0.0;
+  double p99_ms = 0.0;
+  double flops = 0.0;  // per call; 0 when no model applies
+  double bytes = 0.0;  // per call; 0 when no model applies
+};
+
+// Approximate operation counts (double precision, real arithmetic).
+double gemm_flops(double m, double k, double n) {
+  return 2.0 * m * k * n;
+}
+
+double lu_solve_flops(double n, double k) {
+  return 2.0 / 3.0 * n * n * n + 2.0 * n * n * k;
+}
+
+double svd_flops(double m, double n) {
+  return 4.0 * m * n * n + 8.0 * n * n * n;
+}
+
+double eigh_flops(double n) {
+  return 9.0 * n * n * n;
+}
+
+double spmm_flops(double nnz, double k) {
+  return 2.0 * nnz * k;
+}
+
+double csc_bytes(const Sparse &a) {
+  return static_cast<double>(a.nonZeros()) * (sizeof(double) + sizeof(int)) +
+         static_cast<double>(a.outerSize() + 1) * sizeof(int);
+}
+
+double percentile(const std::vector<double> &sorted, double q) {
+  const std::size_t idx = static_cast<std::size_t>(q * static_cast<double>(sorted.size() - 1) + 0.5);
+  return sorted[std::min(idx, sorted.size() - 1)];
+}
+
+Result time_kernel(const Options &opts, const std::function<void()> &fn) {
+  for (int i = 0; i < opts.warmup; ++i) {
+    fn();
+  }
+
+  std::vector<double> samples;
+  samples.reserve(static_cast<std::size_t>(opts.runs));
+  for (int i = 0; i < opts.runs; ++i) {
+    const auto t0 = std::chrono::steady_clock::now();
+    fn();
+    const auto t1 = std::chrono::steady_clock::now();
+    samples.push_back(std::chrono::duration<double, std::milli>(t1 - t0).count());
+  }
+  std::sort(samples.begin(), samples.end());
+
+  Result r;
+  r.runs = opts.runs;
+  r.min_ms = samples.front();
+  r.median_ms = percentile(samples, 0.5);
+  r.p99_ms = percentile(samples, 0.99);
+  return r;
+}
+
+Sparse laplacian_2d(int nx) {
+  const int n = nx * nx;
+  std::vector<Eigen::Triplet<double, int>> triplets;
+  triplets.reserve(static_cast<std::size_t>(5 * n));
+  for (int j = 0; j < nx; ++j) {
+    for (int i = 0; i < nx; ++i) {
+      const int row = j * nx + i;
+      triplets.emplace_back(row, row, 4.0);
+      if (i > 0) {
+        triplets.emplace_back(row, row - 1, -1.0);
+      }
+      if (i + 1 < nx) {
+        triplets.emplace_back(row, row + 1, -1.0);
+      }
+      if (j > 0) {
+        triplets.emplace_back(row, row - nx, -1.0);
+      }
+      if (j + 1 < nx) {
+        triplets.emplace_back(row, row + nx, -1.0);
+      }
+    }
+  }
+  Sparse a(n, n);
+  a.setFromTriplets(triplets.begin(), triplets.end());
+  a.makeCompressed();
+  return a;
+}
+
+RowMatrix random_matrix(std::mt19937_64 &rng, Eigen::Index rows, Eigen::Index cols) {
+  std::normal_distribution<double> dist(0.0, 1.0);
+  RowMatrix out(rows, cols);
+  for (Eigen::Index i = 0; i < out.size(); ++i) {
+    out.data()[i] = dist(rng);
+  }
+  return out;
+}
+
+class Runner {
+ public:
+  Runner(const Options &opts, std::FILE *log) : opts_(opts), log_(log) {}
+
+  void run(const std::string &name, const std::string &group, long long size, double flops, double bytes,
+           const std::function<void()> &fn) {
+    if (!opts_.filter.empty() && name.find(opts_.filter) == std::string::npos) {
+      return;
+    }
+    Result r = time_kernel(opts_, fn);
+    r.name = name;
+    r.group = group;
+    r.size = size;
+    r.flops = flops;
+    r.bytes = bytes;
+    print_line(r);
+    results_.push_back(r);
+  }
+
+  const std::vector<Result> &results() const { return results_; }
+
+ private:
+  void print_line(const Result &r) const {
+    const double seconds = r.median_ms * 1e-3;
+    char gflops[32] = "-";
+    char gbytes[32] = "-";
+    if (r.flops > 0.0 && seconds > 0.0) {
+      std::snprintf(gflops, sizeof(gflops), "%.2f", r.flops / seconds * 1e-9);
+    }
+    if (r.bytes > 0.0 && seconds > 0.0) {
+      std::snprintf(gbytes, sizeof(gbytes), "%.2f", r.bytes / seconds * 1e-9);
+    }
+    std::fprintf(log_, "%-28s %10.3f %10.3f %10.3f %10s %10s\n", r.name.c_str(), r.min_ms, r.median_ms, r.p99_ms,
+                 gflops, gbytes);
+    std::fflush(log_);
+  }
+
+  const Options &opts_;
+  std::FILE *log_;
+  std::vector<Result> results_;
+};
+
+void run_dense(Runner &runner, const Options &opts, std::mt19937_64 &rng) {
+  const Eigen::Index n = opts.dense_n;
+  const Eigen::Index k = opts.rhs;
+  const RowMatrix a = random_matrix(rng, n, n);
+  const RowMatrix b = random_matrix(rng, n, n);
+  const RowMatrix rhs = random_matrix(rng, n, k);
+  ColMatrix spd = a.transpose() * a;
+  spd.diagonal().array() += static_cast<double>(n);
+  const ColMatrix a_col = a;
+  const ColMatrix rhs_col = rhs;
+  const ColMatrix tall = a_col.topRows(n).leftCols(n / 2);
+  const double nd = static_cast<double>(n);
+
+  RowMatrix out(n, n);
+  runner.run("gemm n=" + std::to_string(n), "dense", n, gemm_flops(nd, nd, nd), 3.0 * nd * nd * sizeof(double),
+             [&] { peigen::gemm(a, b, Eigen::Map<RowMatrix>(out.data(), n, n)); });
+
+  for (const char *method : {"eigen", "lapack"}) {
+    const std::string m = method;
+    if (m == "lapack" && peigen::resolve_lapack_eigen_method("auto", "solve") != "lapack") {
+      continue;
+    }
+    runner.run("solve[" + m + "] n=" + std::to_string(n), "dense", n, lu_solve_flops(nd, static_cast<double>(k)),
+               0.0, [&] { peigen::solve_dense(a_col, rhs_col, m); });
+  }
+
+  for (const char *method : {"bdcsvd", "lapack"}) {
+    const std::string m = method;
+    if (m == "lapack" && peigen::resolve_svd_method("auto") != "lapack") {
+      continue;
+    }
+    runner.run("svd[" + m + "] " + std::to_string(n) + "x" + std::to_string(n / 2), "dense", n,
+               svd_flops(nd, nd / 2.0), 0.0, [&] { peigen::compute_svd(tall, false, m); });
+  }
+
+  for (const char *method : {"eigen", "lapack"}) {
+    const std::string m = method;
+    if (m == "lapack" && peigen::resolve_eigh_method("auto") != "lapack") {
+      continue;
+    }
+    runner.run("eigh[" + m + "] n=" + std::to_string(n), "dense", n, eigh_flops(nd), 0.0,
+               [&] { peigen::compute_eigh(spd, true, true, m); });
+  }
+}
+
+void run_sparse(Runner &runner, const Options &opts, std::mt19937_64 &rng) {
+  const Sparse lap = laplacian_2d(opts.grid);
+  const Eigen::Map<const Sparse> mat(lap.rows(), lap.cols(), lap.nonZeros(), lap.outerIndexPtr(),
+                                     lap.innerIndexPtr(), lap.valuePtr());
+  const Eigen::Index n = lap.rows();
+  const Eigen::Index k = opts.rhs;
+  const double nnz = static_cast<double>(lap.nonZeros());
+  const RowMatrix x = random_matrix(rng, n, k);
+  RowMatrix out(n, k);
+
+  runner.run("spmm n=" + std::to_string(n) + " k=" + std::to_string(k), "sparse", n,
+             spmm_flops(nnz, static_cast<double>(k)),
+             csc_bytes(lap) + 2.0 * static_cast<double>(n * k) * sizeof(double),
+             [&] { peigen::spmm(mat, x.data(), k, out.data()); });
+
+  // CG cost is modelled from the iteration count of a probe solve: one SpMV (2 nnz) and
+  // roughly ten vector flops per row per iteration.
+  const RowMatrix b = x.leftCols(1);
+  RowMatrix sol(n, 1);
+  for (const char *pre : {"none", "jacobi"}) {
+    const peigen_iterative_params params =
+        peigen::resolve_iterative_params("cg", pre, 1e-8, static_cast<int>(10 * n), 10, 1e-4);
+    const peigen_iterative_result probe = peigen::run_iterative_kernel(mat, b.data(), 1, sol.data(), params);
+    const double iters = static_cast<double>(probe.iterations);
+    runner.run("cg[" + std::string(pre) + "] n=" + std::to_string(n), "sparse", n,
+               iters * (2.0 * nnz + 10.0 * static_cast<double>(n)),
+               iters * (csc_bytes(lap) + 6.0 * static_cast<double>(n) * sizeof(double)),
+               [&] { peigen::run_iterative_kernel(mat, b.data(), 1, sol.data(), params); });
+  }
+
+  runner.run("sparselu n=" + std::to_string(n), "sparse", n, 0.0, 0.0,
+             [&] { peigen::sparse_lu_solve(mat, b, Eigen::Map<RowMatrix>(sol.data(), n, 1)); });
+}
+
+void write_json(const Options &opts, const std::vector<Result> &results) {
+  std::FILE *fp = opts.json_path == "-" ? stdout : std::fopen(opts.json_path.c_str(), "w");
+  if (fp == nullptr) {
+    throw std::runtime_error("cannot open " + opts.json_path + " for writing");
+  }
+
+  const peigen::ThreadInfo threads = peigen::thread_info();
+  std::fprintf(fp, "{\n  \"context\": {\"kernel_isa\": \"%s\", \"blas_backend\": \"%s\", ", peigen::kernels().isa,
+               PEIGEN_BLAS_BACKEND);
+  std::fprintf(fp, "\"lapack_backend\": \"%s\", \"threads\": %d, \"runs\": %d, \"warmup\": %d},\n",
+               PEIGEN_LAPACK_BACKEND, threads.eigen, opts.runs, opts.warmup);
+  std::fprintf(fp, "  \"results\": [\n");
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    const Result &r = results[i];
+    const double seconds = r.median_ms * 1e-3;
+    std::fprintf(fp,
+                 "    {\"name\": \"%s\", \"group\": \"%s\", \"size\": %lld, \"runs\": %d, \"min_ms\": %.6f, "
+                 "\"median_ms\": %.6f, \"p99_ms\": %.6f, \"gflops\": %.6f, \"gbytes_per_s\": %.6f}%s\n",
+                 r.name.c_str(), r.group.c_str(), r.size, r.runs, r.min_ms, r.median_ms, r.p99_ms,
+                 r.flops > 0.0 ? r.flops / seconds * 1e-9 : 0.0, r.bytes > 0.0 ? r.bytes / seconds * 1e-9 : 0.0,
+                 i + 1 < results.size() ? "," : "");
+  }
+  std::fprintf(fp, "  ]\n}\n");
+  if (fp != stdout) {
+    std::fclose(fp);
+  }
+}
+
+int parse_int(const std::string &flag, const char *value) {
+  char *end = nullptr;
+  const long parsed = std::strtol(value, &end, 10);
+  if (end == value || *end != '\0' || parsed < 0) {
+    throw std::invalid_argument(flag + " expects a non-negative integer");
+  }
+  return static_cast<int>(parsed);
+}
+
+Options parse_args(int argc, char **argv) {
+  Options opts;
+  for (int i = 1; i < argc; ++i) {
+    const std::string flag = argv[i];
+    if (flag == "--help" || flag == "-h") {
+      std::printf(
+          "usage: peigen_bench [--json PATH|-] [--filter SUBSTR] [--runs N] [--warmup N]\n"
+          "                    [--dense-n N] [--grid N] [--rhs N] [--threads N]\n");
+      std::exit(0);
+    }
+    if (i + 1 >= argc) {
+      throw std::invalid_argument(flag + " expects a value");
+    }
+    const char *value = argv[++i];
+    if (flag == "--json") {
+      opts.json_path = value;
+    } else if (flag == "--filter") {
+      opts.filter = value;
+    } else if (flag == "--runs") {
+      opts.runs = std::max(1, parse_int(flag, value));
+    } else if (flag == "--warmup") {
+      opts.warmup = parse_int(flag, value);
+    } else if (flag == "--dense-n") {
+      opts.dense_n = std::max(2, parse_int(flag, value));
+    } else if (flag == "--grid") {
+      opts.grid = std::max(2, parse_int(flag, value));
+    } else if (flag == "--rhs") {
+      opts.rhs = std::max(1, parse_int(flag, value));
+    } else if (flag == "--threads") {
+      opts.threads = parse_int(flag, value);
+    } else {
+      throw std::invalid_argument("unknown option " + flag);
+    }
+  }
+  return opts;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  try {
+    const Options opts = parse_args(argc, argv);
+    peigen::init_kernel_dispatch();
+    if (!peigen::kernel_dispatch().note.empty()) {
+      std::fprintf(stderr, "peigen_bench: %s\n", peigen::kernel_dispatch().note.c_str());
+    }
+    peigen::set_num_threads(opts.threads, "all");
+
+    // Keep stdout machine-readable when JSON goes there.
+    std::FILE *log = opts.json_path == "-" ? stderr : stdout;
+    std::fprintf(log, "kernel_isa=%s blas=%s lapack=%s threads=%d\n", peigen::kernels().isa, PEIGEN_BLAS_BACKEND,
+                 PEIGEN_LAPACK_BACKEND, peigen::get_num_threads());
+    std::fprintf(log, "%-28s %10s %10s %10s %10s %10s\n", "op", "min(ms)", "p50(ms)", "p99(ms)", "GFLOP/s", "GB/s");
+    std::fprintf(log, "%s\n", std::string(83, '-').c_str());
+
+    std::mt19937_64 rng(7);
+    Runner runner(opts, log);
+    run_dense(runner, opts, rng);
+    run_sparse(runner, opts, rng);
+
+    if (!opts.json_path.empty()) {
+      write_json(opts, runner.results());
+    }
+  } catch (const std::exception &e) {
+    std::fprintf(stderr, "peigen_bench: %s\n", e.what());
+    return 1;
+  }
+  return 0;
+}
@@ -2,7 +2,10 @@
 
 from __future__ import annotations
 
-from . import _core, decomp, linalg, sparse
+from . import _core, cache, decomp, futures, linalg, sparse, threads
+from .cache import clear_factor_cache, factor_cache, factor_cache_info, set_factor_cache
+from .futures import Future, get_async_workers, set_async_workers, submit
+from .threads import get_num_threads, set_num_threads, thread_info, threadpool_limits
 
 
 def build_config() -> dict:
@@ -24,6 +27,37 @@ def show_build_config() -> None:
     print(f"openmp_enabled:        {cfg['openmp_enabled']}")
     print(f"vectorization_enabled: {cfg['vectorization_enabled']}")
     print(f"eigen_mpl2_only:       {cfg['eigen_mpl2_only']}")
-
-
-__all__ = ["linalg", "sparse", "decomp", "build_config", "show_build_config"]
+    print(f"num_threads:           {cfg['num_threads']}")
+    print(f"openmp_max_threads:    {cfg['openmp_max_threads']}")
+    print(f"blas_num_threads:      {cfg['blas_num_threads']}")
+    print(f"blas_threading_api:    {cfg['blas_threading_api']}")
+    print(f"kernel_isa:            {cfg['kernel_isa']}")
+    print(f"kernel_isa_variants:   {', '.join(cfg['kernel_isa_variants'])}")
+    print(f"cpu_isa_supported:     {', '.join(cfg['cpu_isa_supported'])}")
+    if cfg["kernel_isa_note"]:
+        print(f"kernel_isa_note:       {cfg['kernel_isa_note']}")
+    print(f"async_workers:         {cfg['async_workers']}")
+
+
+__all__ = [
+    "linalg",
+    "sparse",
+    "decomp",
+    "threads",
+    "cache",
+    "futures",
+    "build_config",
+    "show_build_config",
+    "set_num_threads",
+    "get_num_threads",
+    "thread_info",
+    "threadpool_limits",
+    "set_factor_cache",
+    "factor_cache_info",
+    "clear_factor_cache",
+    "factor_cache",
+    "submit",
+    "Future",
+    "set_async_workers",
+    "get_async_workers",
+]
@@ -0,0 +1,46 @@
+"""Opt-in cache of LU factorizations shared by ``linalg.solve`` and ``sparse.solve``."""
+
+from __future__ import annotations
+
+from . import _core
+
+DEFAULT_MAX_BYTES = 256 * 2**20
+
+
+def set_factor_cache(max_bytes: int = DEFAULT_MAX_BYTES) -> None:
+    """Enable the factorization cache with a memory cap in bytes.
+
+    Solves whose matrix matches a cached entry (same shape, sparsity pattern and values,
+    checked by a content fingerprint) reuse its factors. Least-recently-used entries are
+    evicted past ``max_bytes``; ``max_bytes=0`` disables the cache and frees every entry.
+    """
+    _core.set_factor_cache(int(max_bytes))
+
+
+def factor_cache_info() -> dict:
+    """Return ``enabled``, ``hits``, ``misses``, ``evictions``, ``entries``, ``bytes`` and ``max_bytes``."""
+    return dict(_core.factor_cache_info())
+
+
+def clear_factor_cache() -> None:
+    """Drop all cached factors and reset the counters; the memory cap is kept."""
+    _core.clear_factor_cache()
+
+
+class factor_cache:
+    """Context manager enabling the cache for a block and restoring the previous cap on exit.
+
+    Entries created inside the block stay cached if the previous cap was non-zero.
+    """
+
+    def __init__(self, max_bytes: int = DEFAULT_MAX_BYTES):
+        self._max_bytes = int(max_bytes)
+        self._previous = 0
+
+    def __enter__(self) -> "factor_cache":
+        self._previous = factor_cache_info()["max_bytes"]
+        set_factor_cache(self._max_bytes)
+        return self
+
+    def __exit__(self, exc_type, exc, tb) -> None:
+        set_factor_cache(self._previous)
@@ -0,0 +1,315 @@
+"""Asynchronous execution on the native work-stealing pool.
+
+``submit(op, *args, **kwargs)`` enqueues one of the main routines on a pool of native
+worker threads inside the extension and returns a :class:`Future`. Futures can be
+waited on from any thread (they are :class:`concurrent.futures.Future` instances) and
+awaited from asyncio. Passing a pending future as an argument chains the operations
+natively: the dependent task starts on the pool as soon as its inputs are ready, without
+a round trip through Python.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import atexit
+import concurrent.futures
+
+import numpy as np
+
+from . import _core, linalg, sparse
+
+
+class Future(concurrent.futures.Future):
+    """Result of an operation running on the pEigen async pool.
+
+    Running operations cannot be cancelled; :meth:`cancel` always returns ``False``.
+    """
+
+    def __init__(self, task, post=None):
+        super().__init__()
+        self._task = task
+        self._post = post
+        self.set_running_or_notify_cancel()
+        task.add_done_callback(self._settle)
+
+    def _settle(self):
+        try:
+            value = self._task.result()
+            if self._post is not None:
+                value = self._post(value)
+        except BaseException as exc:
+            self.set_exception(exc)
+        else:
+            self.set_result(value)
+
+    def __await__(self):
+        return asyncio.wrap_future(self).__await__()
+
+
+def _dense(x):
+    if isinstance(x, Future):
+        return x._task
+    return np.asarray(x, dtype=np.float64)
+
+
+def _rhs(b):
+    """Returns the native rhs operand and whether the result must be squeezed to 1D."""
+    if isinstance(b, Future):
+        return b._task, False
+    rhs = np.asarray(b, dtype=np.float64)
+    if rhs.ndim == 1:
+        return rhs[:, None], True
+    if rhs.ndim == 2:
+        return rhs, False
+    raise ValueError("b must be 1D or 2D")
+
+
+def _squeeze(x):
+    return x[:, 0]
+
+
+def _sparse(a):
+    return sparse._as_sparse(a)
+
+
+def _gather(b, rows):
+    """Returns ``b[rows]`` for an operand of a reordered matrix (``rows`` None: unchanged)."""
+    if rows is None:
+        return b
+    if isinstance(b, Future):
+        raise ValueError("permuted= needs b as an array: a pending future cannot be reordered")
+    return np.asarray(b, dtype=np.float64)[rows]
+
+
+def _unpermute(perm, squeezed):
+    """Post-processing that scatters a reordered result back (and squeezes a 1D rhs)."""
+
+    def post(x):
+        x = sparse._scatter(x, perm)
+        return x[:, 0] if squeezed else x
+
+    return post
+
+
+def _matmul(a, b):
+    return _core.async_matmul(_dense(a), _dense(b)), None
+
+
+def _solve(a, b, *, assume_a: str = "gen", method: str = "auto", precision: str = "double"):
+    if assume_a != "gen":
+        raise ValueError("assume_a currently only supports 'gen'")
+    if precision not in linalg.PRECISIONS:
+        raise ValueError("precision must be 'double' or 'mixed'")
+    rhs, squeezed = _rhs(b)
+    return _core.async_solve(_dense(a), rhs, method, precision), _squeeze if squeezed else None
+
+
+def _generalized_eigh(a, b, type: int, lower: bool, eigenvectors: bool, method: str, subset_by_index):
+    if type not in (1, 2, 3):
+        raise ValueError("type must be 1, 2 or 3")
+    lo, hi = -1, -1
+    if subset_by_index is not None:
+        lo, hi = (int(i) for i in subset_by_index)
+        if lo < 0:
+            raise ValueError("subset_by_index must satisfy 0 <= lo <= hi < n")
+    if not isinstance(b, linalg.CholeskyFactor):
+        b = _dense(b)
+    return _core.async_eigh_generalized(_dense(a), b, type, lower, eigenvectors, method, lo, hi), None
+
+
+def _eigh(
+    a,
+    b=None,
+    *,
+    lower: bool = True,
+    eigenvectors: bool = True,
+    method: str = "auto",
+    type: int = 1,
+    subset_by_index=None,
+):
+    if b is not None:
+        return _generalized_eigh(a, b, type, lower, eigenvectors, method, subset_by_index)
+    if subset_by_index is not None:
+        raise ValueError("subset_by_index requires b")
+    return _core.async_eigh(_dense(a), lower, eigenvectors, method), None
+
+
+def _eighvals(a, b=None, *, lower: bool = True, method: str = "auto", type: int = 1):
+    if b is not None:
+        return _generalized_eigh(a, b, type, lower, False, method, None)
+    return _core.async_eigh(_dense(a), lower, False, method), None
+
+
+def _svd(a, *, full_matrices: bool = False, method: str = "auto"):
+    return _core.async_svd(_dense(a), full_matrices, method), None
+
+
+def _spmm(a, b, *, transpose: bool = False, alpha: float = 1.0, beta: float = 0.0, out=None, permuted=None):
+    if out is not None or beta != 0.0:
+        raise ValueError("submit(sparse.spmm) returns a new array; out and beta are not supported")
+    if permuted is not None:
+        r = sparse._resolve_reordering(a, permuted)
+        gather, scatter = (r._row_perm, r.perm) if transpose else (r.perm, r._row_perm)
+        rhs, squeezed = _rhs(_gather(b, gather))
+        return _core.async_spmm(r._handle, rhs, bool(transpose), float(alpha)), _unpermute(scatter, squeezed)
+    rhs, squeezed = _rhs(b)
+    return _core.async_spmm(_sparse(a), rhs, bool(transpose), float(alpha)), _squeeze if squeezed else None
+
+
+def _sparse_solve(
+    a,
+    b,
+    *,
+    method: str = "auto",
+    tol: float = 1e-8,
+    maxiter: int | None = None,
+    preconditioner: str = "none",
+    ilu_fill_factor: int = 10,
+    ilu_drop_tol: float = 1e-4,
+    permuted=None,
+    precision: str = "double",
+):
+    sparse._check_precision(precision, method, permuted)
+    if precision == "mixed":
+        rhs, squeezed = _rhs(b)
+        factor = _core.async_sparse_factorize(_sparse(a), precision)
+        return _core.async_factorized_solve(factor, rhs), _squeeze if squeezed else None
+    if permuted is not None:
+        r = sparse._resolve_reordering(a, permuted)
+        if method in ("auto", "lu"):
+            # The permuted factor maps the rhs itself, so b may be a pending future here.
+            factor = _core.async_sparse_factorize_permuted(r._handle, r._row_perm, r.perm)
+            rhs, squeezed = _rhs(b)
+            return _core.async_factorized_solve(factor, rhs), _squeeze if squeezed else None
+        if method == "cg" and not r.symmetric:
+            raise ValueError("method='cg' requires a symmetric ordering (rcm, amd or nd)")
+        a, scatter = r._handle, r.perm
+        rhs, squeezed = _rhs(_gather(b, r._row_perm))
+    else:
+        a, scatter = _sparse(a), None
+        rhs, squeezed = _rhs(b)
+    task = _core.async_sparse_solve(
+        a,
+        rhs,
+        method,
+        tol,
+        0 if maxiter is None else maxiter,
+        preconditioner,
+        ilu_fill_factor,
+        ilu_drop_tol,
+    )
+    return task, _unpermute(scatter, squeezed)
+
+
+def _sparse_factorize(a, *, method: str = "auto", permuted=None, precision: str = "double"):
+    if method == "qr":
+        if permuted is not None or precision != "double":
+            raise ValueError("method='qr' does not support permuted or precision")
+        return _core.async_sparse_factorize_qr(_sparse(a)), None
+    if method != "auto":
+        raise ValueError("method must be 'auto' or 'qr'")
+    sparse._check_precision(precision, "lu", permuted)
+    if precision == "mixed":
+        return _core.async_sparse_factorize(_sparse(a), precision), None
+    if permuted is not None:
+        r = sparse._resolve_reordering(a, permuted)
+        return _core.async_sparse_factorize_permuted(r._handle, r._row_perm, r.perm), None
+    return _core.async_sparse_factorize(_sparse(a)), None
+
+
+def _lstsq(
+    a,
+    b,
+    *,
+    method: str = "qr",
+    tol: float = 1e-8,
+    maxiter: int | None = None,
+    pivot_threshold: float | None = None,
+):
+    if method not in sparse.LSTSQ_METHODS:
+        raise ValueError("method must be one of: qr, lscg")
+    rhs, squeezed = _rhs(b)
+    task = _core.async_sparse_lstsq(
+        _sparse(a),
+        rhs,
+        method,
+        tol,
+        0 if maxiter is None else maxiter,
+        -1.0 if pivot_threshold is None else pivot_threshold,
+    )
+    return task, _squeeze if squeezed else None
+
+
+def _factorized_solve(factor, b):
+    rhs, squeezed = _rhs(b)
+    native = factor._task if isinstance(factor, Future) else factor
+    return _core.async_factorized_solve(native, rhs), _squeeze if squeezed else None
+
+
+_OPS = {
+    "linalg.matmul": (linalg.matmul, _matmul),
+    "linalg.solve": (linalg.solve, _solve),
+    "linalg.eigh": (linalg.eigh, _eigh),
+    "linalg.eighvals": (linalg.eighvals, _eighvals),
+    "linalg.svd": (linalg.svd, _svd),
+    "sparse.spmm": (sparse.spmm, _spmm),
+    "sparse.solve": (sparse.solve, _sparse_solve),
+    "sparse.factorize": (sparse.factorize, _sparse_factorize),
+    "sparse.lstsq": (sparse.lstsq, _lstsq),
+    "sparse.factorized_solve": (None, _factorized_solve),
+}
+_OPS_BY_FUNCTION = {fn: launcher for fn, launcher in _OPS.values() if fn is not None}
+
+
+def submit(op, *args, **kwargs) -> Future:
+    """Run ``op(*args, **kwargs)`` on the native async pool and return a :class:`Future`.
+
+    ``op`` is one of the supported routines (e.g. ``peigen.linalg.eigh``) or its dotted
+    name (``"linalg.eigh"``). ``"sparse.factorized_solve"`` takes a factorization (LU or
+    ``method="qr"``, or a future of one) and a right-hand side. Arguments and keywords match the synchronous
+    routine; dense arguments may also be futures of earlier array-producing submissions.
+    Keywords without an async form raise ``ValueError``:
+
+    - ``sparse.spmm``: ``out`` and ``beta``, since the future always returns a new array.
+
+    ``permuted=`` is supported; an ordering name is computed by :func:`sparse.reorder` during
+    ``submit``, so pass a precomputed :class:`sparse.Reordering` to keep submission cheap.
+    Except for direct solves, ``b`` must then be an array rather than a future.
+
+    ``precision="mixed"`` is supported by ``linalg.solve``, ``sparse.solve`` and
+    ``sparse.factorize``.
+
+    Generalized ``linalg.eigh`` / ``linalg.eighvals`` (``b``, ``type``, ``subset_by_index``)
+    run natively; a :class:`linalg.CholeskyFactor` ``b`` is copied during ``submit``.
+    """
+    if isinstance(op, str):
+        entry = _OPS.get(op)
+        launcher = entry[1] if entry is not None else None
+    else:
+        launcher = _OPS_BY_FUNCTION.get(op)
+    if launcher is None:
+        supported = ", ".join(sorted(_OPS))
+        raise ValueError(f"unsupported async op {op!r}; supported ops: {supported}")
+    task, post = launcher(*args, **kwargs)
+    return Future(task, post)
+
+
+def set_async_workers(n: int) -> None:
+    """Set the number of async pool workers (``0`` restores the core count).
+
+    Raises ``RuntimeError`` while submitted operations are still running.
+    """
+    _core.async_set_workers(int(n))
+
+
+def get_async_workers() -> int:
+    """Return the number of async pool workers."""
+    return int(_core.async_get_workers())
+
+
+def shutdown() -> None:
+    """Wait for all submitted operations and stop the pool; it restarts on the next submit."""
+    _core.async_shutdown()
+
+
+atexit.register(_core.async_shutdown)
@@ -31,10 +31,46 @@ def matmul(a, b):
     return _core.matmul(arr_a, arr_b)
 
 
-def solve(a, b, *, assume_a: str = "gen", method: str = "auto"):
-    """Solve a x = b for dense matrices."""
+def gram(a, *, trans: bool = True, lower: bool = True, mirror: bool = True):
+    """Gram matrix ``a.T @ a`` (``trans=True``) or ``a @ a.T`` as a symmetric rank-k update.
+
+    Only the ``lower`` (or upper) triangle is computed, which halves the flops of a general
+    product; ``mirror=False`` leaves the other triangle zero.
+    """
+    arr = _as_2d_float64(a)
+    return _core.gram(arr, trans, lower, mirror)
+
+
+def _side_is_left(side: str) -> bool:
+    if side not in ("left", "right"):
+        raise ValueError("side must be 'left' or 'right'")
+    return side == "left"
+
+
+def trmm(a, b, *, lower: bool = True, unit_diagonal: bool = False, side: str = "left"):
+    """Multiply by the triangle of square ``a``: ``tri(a) @ b`` (``side="left"``) or ``b @ tri(a)``.
+
+    Entries outside the ``lower`` (or upper) triangle are ignored, as is the diagonal when
+    ``unit_diagonal`` is set.
+    """
+    left = _side_is_left(side)
+    return _core.trmm(_as_2d_float64(a), _as_2d_float64(b), lower, unit_diagonal, left)
+
+
+def symm(a, b, *, lower: bool = True, side: str = "left"):
+    """Multiply by the symmetric matrix stored in one triangle of ``a``: ``sym(a) @ b`` or ``b @ sym(a)``."""
+    left = _side_is_left(side)
+    return _core.symm(_as_2d_float64(a), _as_2d_float64(b), lower, left)
+
+
+PRECISIONS = ("double", "mixed")
+
+
+def _solve_operands(a, b, assume_a: str, precision: str):
     if assume_a != "gen":
         raise ValueError("assume_a currently only supports 'gen'")
+    if precision not in PRECISIONS:
+        raise ValueError("precision must be 'double' or 'mixed'")
     lhs = _as_2d_float64(a)
     rhs = np.asarray(b, dtype=np.float64)
     if rhs.ndim == 1:
@@ -44,11 +80,38 @@ def solve(a, b, *, assume_a: str = "gen", method: str = "auto"):
         squeezed = False
     else:
         raise ValueError("b must be 1D or 2D")
+    return lhs, rhs, squeezed
+
+
+def solve(a, b, *, assume_a: str = "gen", method: str = "auto", precision: str = "double"):
+    """Solve a x = b for dense matrices.
 
-    x = _core.solve(lhs, rhs, method)
+    ``precision="mixed"`` factors in float32 and refines the residual in float64, falling
+    back to a float64 solve when refinement does not converge (see :func:`solve_stats`).
+    """
+    lhs, rhs, squeezed = _solve_operands(a, b, assume_a, precision)
+    if precision == "mixed":
+        x, _ = _core.solve_mixed(lhs, rhs, method)
+    else:
+        x = _core.solve(lhs, rhs, method)
     return x[:, 0] if squeezed else x
 
 
+def solve_stats(a, b, *, assume_a: str = "gen", method: str = "auto", precision: str = "mixed"):
+    """Solve like :func:`solve` and return ``(x, stats)``.
+
+    For ``precision="mixed"`` the stats hold the refinement ``iterations`` (max over
+    columns), the normwise backward ``error`` and whether the float64 ``fallback`` ran.
+    """
+    lhs, rhs, squeezed = _solve_operands(a, b, assume_a, precision)
+    if precision == "mixed":
+        x, stats = _core.solve_mixed(lhs, rhs, method)
+    else:
+        x = _core.solve(lhs, rhs, method)
+        stats = {"precision": "double", "iterations": 0, "error": None, "fallback": False}
+    return (x[:, 0] if squeezed else x), stats
+
+
 def qr(a, *, mode: str = "reduced"):
     """Compute QR decomposition of a dense matrix."""
     return _core.qr(_as_2d_for_factorization(a), mode)
@@ -64,13 +127,75 @@ def svd_compute(a, *, full_matrices: bool = False, method: str = "auto") -> floa
     return _core.svd_compute(_as_2d_for_factorization(a), full_matrices, method)
 
 
-def eigh(a, *, lower: bool = True, eigenvectors: bool = True, method: str = "auto"):
-    """Compute eigenpairs of a symmetric/hermitian matrix."""
+CholeskyFactor = _core.CholeskyFactor
+LDLTFactor = _core.LDLTFactor
+
+
+def cholesky_factor(b, *, lower: bool = True) -> CholeskyFactor:
+    """Factor a symmetric positive definite ``b = L L^T`` once for reuse.
+
+    The returned :class:`CholeskyFactor` provides ``solve(rhs)`` and can be passed as ``b``
+    to :func:`eigh` so repeated generalized problems with the same mass matrix skip the
+    Cholesky factorization. ``update(u, sign=+1|-1)`` refactors ``b + sign * u @ u.T`` in
+    place in O(k n^2). Only the ``lower`` (or upper) triangle of ``b`` is read.
+    """
+    return _core.CholeskyFactor(_as_2d_for_factorization(b), lower)
+
+
+def ldlt_factor(a, *, lower: bool = True) -> LDLTFactor:
+    """Square-root free, pivoted ``a = P^T L D L^T P`` factor with ``solve`` and ``update``.
+
+    Unlike :func:`cholesky_factor`, ``a`` may be symmetric indefinite or semidefinite
+    (``positive_definite`` reports which). Pivoting is diagonal only, so a matrix that needs
+    2x2 pivots, such as ``[[0, 1], [1, 0]]``, raises ``ValueError``. ``update`` requires
+    nonzero pivots; downdates of a positive definite factor keep the definiteness check of
+    :func:`cholesky_factor`, while an indefinite factor is updated as given.
+    """
+    return _core.LDLTFactor(_as_2d_for_factorization(a), lower)
+
+
+def _generalized_eigh(a, b, type: int, lower: bool, eigenvectors: bool, method: str, subset_by_index):
+    if type not in (1, 2, 3):
+        raise ValueError("type must be 1, 2 or 3")
+    lo, hi = -1, -1
+    if subset_by_index is not None:
+        lo, hi = (int(i) for i in subset_by_index)
+        if lo < 0:
+            raise ValueError("subset_by_index must satisfy 0 <= lo <= hi < n")
+    if not isinstance(b, CholeskyFactor):
+        b = _as_2d_for_factorization(b)
+    return _core.eigh_generalized(_as_2d_for_factorization(a), b, type, lower, eigenvectors, method, lo, hi)
+
+
+def eigh(
+    a,
+    b=None,
+    *,
+    lower: bool = True,
+    eigenvectors: bool = True,
+    method: str = "auto",
+    type: int = 1,
+    subset_by_index=None,
+):
+    """Compute eigenpairs of a symmetric/hermitian matrix.
+
+    With ``b`` (symmetric positive definite, or a :class:`CholeskyFactor` of it) the
+    generalized problem is solved: ``type=1`` for ``a v = w b v``, ``2`` for
+    ``a b v = w v`` and ``3`` for ``b a v = w v``, with ``b``-normalized eigenvectors.
+    ``subset_by_index=(lo, hi)`` returns only eigenvalues ``lo..hi`` (inclusive, ascending)
+    and is supported for generalized problems.
+    """
+    if b is not None:
+        return _generalized_eigh(a, b, type, lower, eigenvectors, method, subset_by_index)
+    if subset_by_index is not None:
+        raise ValueError("subset_by_index requires b")
     return _core.eigh(_as_2d_for_factorization(a), lower, eigenvectors, method)
 
 
-def eighvals(a, *, lower: bool = True, method: str = "auto"):
-    """Compute eigenvalues of a symmetric/hermitian matrix."""
+def eighvals(a, b=None, *, lower: bool = True, method: str = "auto", type: int = 1):
+    """Compute eigenvalues of a symmetric/hermitian matrix (or of the pencil ``(a, b)``)."""
+    if b is not None:
+        return _generalized_eigh(a, b, type, lower, False, method, None)
     # Staging to column-major is handled once in the extension.
     return _core.eigh(_as_2d_float64(a), lower, False, method)
 
@@ -80,6 +205,36 @@ def eigh_compute(a, *, lower: bool = True, method: str = "auto") -> float:
     return _core.eigh_compute(_as_2d_float64(a), lower, method)
 
 
+def _as_batch(a, name: str) -> np.ndarray:
+    arr = np.ascontiguousarray(a, dtype=np.float64)
+    if arr.ndim != 3 or arr.shape[1] != arr.shape[2]:
+        raise ValueError(f"{name} must have shape (batch, n, n)")
+    return arr
+
+
+def eigh_batched(a, *, lower: bool = True, eigenvectors: bool = True, method: str = "auto"):
+    """Eigenpairs of every symmetric matrix in a ``(batch, n, n)`` stack in one native call.
+
+    Returns ``w`` of shape ``(batch, n)`` and, with ``eigenvectors``, ``v`` of shape
+    ``(batch, n, n)``. Sizes 2..6 use fixed-size kernels; ``method="auto"`` takes the
+    closed form for n <= 3, ``"iterative"`` forces the QL iteration and ``"direct"``
+    requires n <= 3.
+    """
+    return _core.eigh_batched(_as_batch(a, "a"), lower, eigenvectors, method)
+
+
+def solve_batched(a, b, *, assume_a: str = "gen"):
+    """Solve ``a[i] @ x[i] = b[i]`` for a ``(batch, n, n)`` stack in one native call.
+
+    ``b`` has shape ``(batch, n)`` or ``(batch, n, k)``. ``assume_a="pos"`` uses Cholesky
+    (LLT) instead of partial-pivot LU.
+    """
+    if assume_a not in ("gen", "pos"):
+        raise ValueError("assume_a must be 'gen' or 'pos'")
+    rhs = np.ascontiguousarray(b, dtype=np.float64)
+    return _core.solve_batched(_as_batch(a, "a"), rhs, assume_a == "pos")
+
+
 def norm(a, ord=None, axis=None, keepdims: bool = False):
     """Norm wrapper with fast path for common Frobenius case."""
     arr = np.asarray(a, dtype=np.float64)
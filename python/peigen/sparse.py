@@ -17,6 +17,19 @@ def _require_scipy():
     return sp
 
 
+# Persistent handle: ``Matrix(a)`` or ``Matrix.from_coo(data, row, col, shape)`` copies the
+# input into native storage once; every routine below then uses it without conversion.
+Matrix = _core.SparseMatrix
+
+
+def _as_sparse(a):
+    """Returns ``a`` unchanged if it is a :class:`Matrix` or SciPy sparse, else a CSC copy."""
+    if isinstance(a, Matrix):
+        return a
+    sp = _require_scipy()
+    return a if sp.issparse(a) else sp.csc_matrix(a)
+
+
 def _as_2d_rhs(b):
     rhs = np.ascontiguousarray(np.asarray(b, dtype=np.float64))
     if rhs.ndim == 1:
@@ -26,22 +39,259 @@ def _as_2d_rhs(b):
     raise ValueError("rhs must be a 1D or 2D array")
 
 
-def spmm(a, b):
-    """Multiply sparse matrix `a` by dense matrix `b`."""
-    sp = _require_scipy()
-    if not sp.issparse(a):
-        a = sp.csc_matrix(a)
-    return _core.spmm(a, np.asarray(b, dtype=np.float64))
+class LinearOperator:
+    """Matrix-free operator composed natively from sparse/dense pieces.
+
+    Build leaves with :func:`aslinearoperator` (or :meth:`identity`) and combine them with
+    ``+``, ``-``, scalar ``*``, ``@`` (operator product), ``.T``, :meth:`kron` and
+    :meth:`block_diag`. Products with vectors and the iterative solvers in :func:`solve`
+    run entirely in C++; the combined matrix is never assembled.
+    """
+
+    # Make NumPy defer `ndarray @ op` and `alpha * op` to the reflected methods below.
+    __array_ufunc__ = None
+
+    def __init__(self, native):
+        self._op = native
+
+    @property
+    def shape(self) -> tuple[int, int]:
+        return tuple(self._op.shape)
+
+    @property
+    def T(self) -> LinearOperator:
+        return LinearOperator(_core.linop_transpose(self._op))
+
+    def transpose(self) -> LinearOperator:
+        return self.T
+
+    def diagonal(self) -> np.ndarray:
+        """Main diagonal (not available for operator products)."""
+        return self._op.diagonal()
+
+    def matvec(self, x):
+        """Return ``self @ x`` for a 1D or 2D ``x``."""
+        rhs, squeezed = _as_2d_rhs(x)
+        y = self._op.matvec(rhs)
+        return y[:, 0] if squeezed else y
+
+    def rmatvec(self, x):
+        """Return ``self.T @ x`` for a 1D or 2D ``x``."""
+        rhs, squeezed = _as_2d_rhs(x)
+        y = self._op.rmatvec(rhs)
+        return y[:, 0] if squeezed else y
+
+    @staticmethod
+    def identity(n: int) -> LinearOperator:
+        return LinearOperator(_core.linop_identity(int(n)))
+
+    @staticmethod
+    def kron(a, b) -> LinearOperator:
+        """Kronecker product ``a ⊗ b``, applied as ``vec(B X Aᵀ)`` without forming it."""
+        return LinearOperator(_core.linop_kron(aslinearoperator(a)._op, aslinearoperator(b)._op))
+
+    @staticmethod
+    def block_diag(blocks) -> LinearOperator:
+        return LinearOperator(_core.linop_block_diag([aslinearoperator(blk)._op for blk in blocks]))
+
+    def __add__(self, other):
+        return LinearOperator(_core.linop_sum([self._op, aslinearoperator(other)._op]))
+
+    def __radd__(self, other):
+        return LinearOperator(_core.linop_sum([aslinearoperator(other)._op, self._op]))
+
+    def __sub__(self, other):
+        return self + (-aslinearoperator(other))
+
+    def __rsub__(self, other):
+        return aslinearoperator(other) + (-self)
+
+    def __neg__(self):
+        return self * -1.0
+
+    def __mul__(self, alpha):
+        if not np.isscalar(alpha):
+            return NotImplemented
+        return LinearOperator(_core.linop_scaled(float(alpha), self._op))
+
+    __rmul__ = __mul__
+
+    def __matmul__(self, other):
+        if isinstance(other, LinearOperator) or _is_operator_like(other):
+            return LinearOperator(_core.linop_product([self._op, aslinearoperator(other)._op]))
+        return self.matvec(other)
+
+    def __rmatmul__(self, other):
+        return LinearOperator(_core.linop_product([aslinearoperator(other)._op, self._op]))
+
+    def __repr__(self) -> str:
+        return f"<peigen.sparse.LinearOperator shape={self.shape}>"
+
+
+def _is_operator_like(a) -> bool:
+    if isinstance(a, (LinearOperator, Matrix)):
+        return True
+    try:
+        import scipy.sparse as sp
+    except ImportError:
+        return False
+    return sp.issparse(a)
+
+
+def aslinearoperator(a) -> LinearOperator:
+    """Wrap a sparse matrix or 2D dense array as a :class:`LinearOperator`.
+
+    SciPy and dense inputs are copied; a :class:`Matrix` shares its storage.
+    """
+    if isinstance(a, LinearOperator):
+        return a
+    if _is_operator_like(a):
+        return LinearOperator(_core.linop_sparse(a))
+    arr = np.asarray(a, dtype=np.float64)
+    if arr.ndim != 2:
+        raise ValueError("linear operator input must be a 2D array or sparse matrix")
+    return LinearOperator(_core.linop_dense(arr))
+
+
+ORDERINGS = ("rcm", "amd", "colamd", "nd")
+
+
+class Reordering:
+    """Result of :func:`reorder`: the permutation and the reordered matrix.
+
+    ``perm`` maps new positions to original indices. For the symmetric orderings the
+    reordered matrix is ``A[perm][:, perm]``; for ``"colamd"`` only the columns move
+    (``A[:, perm]``). Unpacks as ``perm, B = sparse.reorder(A)``. Pass it as ``permuted=`` to
+    :func:`spmm`, :func:`solve` or :func:`factorize` to run on the reordered matrix with
+    vectors mapped in and out automatically.
+    """
+
+    def __init__(self, perm, handle, method: str, as_handle: bool):
+        self.perm = perm
+        self.method = method
+        self._handle = handle
+        self._as_handle = as_handle
+        self._scipy = None
+
+    @property
+    def symmetric(self) -> bool:
+        """True when rows and columns are permuted together."""
+        return self.method != "colamd"
+
+    @property
+    def shape(self) -> tuple[int, int]:
+        return tuple(self._handle.shape)
+
+    @property
+    def matrix(self):
+        """The reordered matrix: a :class:`Matrix` for handle input, else a CSC matrix."""
+        if self._as_handle:
+            return self._handle
+        if self._scipy is None:
+            self._scipy = self._handle.to_scipy()
+        return self._scipy
+
+    @property
+    def _row_perm(self):
+        return self.perm if self.symmetric else None
+
+    def __iter__(self):
+        return iter((self.perm, self.matrix))
+
+    def __repr__(self) -> str:
+        return f"<peigen.sparse.Reordering method={self.method!r} shape={self.shape}>"
+
+
+def reorder(a, method: str = "rcm") -> Reordering:
+    """Compute a bandwidth- or fill-reducing ordering of `a` and apply it once.
+
+    ``method`` is ``"rcm"`` (reverse Cuthill-McKee), ``"amd"`` (approximate minimum
+    degree), ``"colamd"`` (column AMD, columns only) or ``"nd"`` (nested dissection).
+    """
+    if method not in ORDERINGS:
+        raise ValueError(f"method must be one of: {', '.join(ORDERINGS)}")
+    as_handle = isinstance(a, Matrix)
+    a = _as_sparse(a)
+    perm = _core.sparse_ordering(a, method)
+    handle = _core.sparse_permute(a, perm if method != "colamd" else None, perm)
+    return Reordering(perm, handle, method, as_handle)
+
+
+def _resolve_reordering(a, permuted) -> Reordering:
+    if isinstance(permuted, Reordering):
+        shape = tuple(a.shape) if hasattr(a, "shape") else np.shape(a)
+        if permuted.shape != shape:
+            raise ValueError("permuted reordering does not match the matrix shape")
+        return permuted
+    if isinstance(permuted, str):
+        return reorder(a, method=permuted)
+    raise ValueError("permuted must be a Reordering from sparse.reorder or an ordering method name")
+
+
+def _scatter(y, perm):
+    if perm is None:
+        return y
+    out = np.empty_like(y)
+    out[perm] = y
+    return out
+
+
+def spmm(a, b, *, transpose: bool = False, alpha: float = 1.0, beta: float = 0.0, out=None, permuted=None):
+    """Multiply sparse matrix `a` by dense matrix `b`.
+
+    With the keywords this is the fused ``out = alpha * op(a) @ b + beta * out``, where
+    ``op(a)`` is ``a.T`` when ``transpose=True`` (the transpose is never formed). ``out`` is
+    updated in place and returned; ``b`` and ``out`` may then also be 1D.
+
+    ``permuted`` (a :class:`Reordering` or an ordering name) multiplies with the reordered
+    matrix instead; ``b`` and the result stay in the original ordering.
+    """
+    if permuted is not None:
+        if out is not None or beta != 0.0:
+            raise ValueError("permuted cannot be combined with out or beta")
+        r = _resolve_reordering(a, permuted)
+        rhs = np.asarray(b, dtype=np.float64)
+        gather, scatter = (r._row_perm, r.perm) if transpose else (r.perm, r._row_perm)
+        x = rhs if gather is None else rhs[gather]
+        return _scatter(_core.spmm_axpby(r._handle, x, None, bool(transpose), float(alpha), 0.0), scatter)
+    a = _as_sparse(a)
+    if out is None and not transpose and alpha == 1.0 and beta == 0.0:
+        return _core.spmm(a, np.asarray(b, dtype=np.float64))
+    return _core.spmm_axpby(a, np.asarray(b, dtype=np.float64), out, bool(transpose), float(alpha), float(beta))
+
+
+def normal_matmul(a, b):
+    """Return ``a.T @ (a @ b)`` in one native call, without forming ``a.T`` or ``a.T @ a``."""
+    return _core.normal_spmm(_as_sparse(a), np.asarray(b, dtype=np.float64))
+
+
+def sddmm(a, x, y):
+    """Sampled dense-dense product ``a ⊙ (x @ y.T)`` evaluated only at the stored entries of `a`.
+
+    ``x`` is ``(m, k)`` and ``y`` is ``(n, k)`` for an ``(m, n)`` matrix ``a``. Returns a CSC
+    matrix with the sparsity pattern of ``a`` (explicit zeros included).
+    """
+    _require_scipy()
+    return _core.sddmm(_as_sparse(a), np.asarray(x, dtype=np.float64), np.asarray(y, dtype=np.float64))
 
 
 def spspmm(a, b):
     """Multiply sparse matrix `a` by sparse matrix `b`."""
-    sp = _require_scipy()
-    if not sp.issparse(a):
-        a = sp.csc_matrix(a)
-    if not sp.issparse(b):
-        b = sp.csc_matrix(b)
-    return _core.spspmm(a, b)
+    _require_scipy()
+    return _core.spspmm(_as_sparse(a), _as_sparse(b))
+
+
+PRECISIONS = ("double", "mixed")
+
+
+def _check_precision(precision: str, method: str, permuted) -> None:
+    if precision not in PRECISIONS:
+        raise ValueError("precision must be 'double' or 'mixed'")
+    if precision == "mixed":
+        if method not in ("auto", "lu"):
+            raise ValueError("precision='mixed' requires a direct method ('auto' or 'lu')")
+        if permuted is not None:
+            raise ValueError("precision='mixed' cannot be combined with permuted")
 
 
 def solve(
@@ -54,14 +304,57 @@ def solve(
     preconditioner: str = "none",
     ilu_fill_factor: int = 10,
     ilu_drop_tol: float = 1e-4,
+    permuted=None,
+    precision: str = "double",
 ):
-    """Solve sparse linear system a x = b."""
-    sp = _require_scipy()
-    if not sp.issparse(a):
-        a = sp.csc_matrix(a)
+    """Solve sparse linear system a x = b.
+
+    ``a`` may also be a :class:`LinearOperator`; it is then solved matrix-free with CG or
+    BiCGSTAB (``method="auto"`` selects BiCGSTAB).
+
+    ``permuted`` (a :class:`Reordering` or an ordering name) solves with the reordered
+    matrix; the direct path then factors with that ordering instead of SparseLU's COLAMD.
+
+    ``precision="mixed"`` (direct methods only) factors in float32 and refines in float64;
+    see :func:`factorize`.
+    """
+    _check_precision(precision, method, permuted)
+    if isinstance(a, LinearOperator):
+        if precision != "double":
+            raise ValueError("precision='mixed' is not supported for LinearOperator inputs")
+        if permuted is not None:
+            raise ValueError("permuted is not supported for LinearOperator inputs")
+        if method == "auto":
+            method = "bicgstab"
+        rhs, squeezed = _as_2d_rhs(b)
+        x = _core.operator_solve(a._op, rhs, method, tol, 0 if maxiter is None else maxiter, preconditioner)
+        return x[:, 0] if squeezed else x
     rhs, squeezed = _as_2d_rhs(b)
+    if precision == "mixed":
+        x = factorize(a, precision=precision).solve(rhs)
+        return x[:, 0] if squeezed else x
+    if permuted is not None:
+        r = _resolve_reordering(a, permuted)
+        if method in ("auto", "lu"):
+            x = factorize(a, permuted=r).solve(rhs)
+            return x[:, 0] if squeezed else x
+        if method == "cg" and not r.symmetric:
+            raise ValueError("method='cg' requires a symmetric ordering (rcm, amd or nd)")
+        rows = r._row_perm
+        x = _core.sparse_solve(
+            r._handle,
+            rhs if rows is None else np.ascontiguousarray(rhs[rows]),
+            method,
+            tol,
+            0 if maxiter is None else maxiter,
+            preconditioner,
+            ilu_fill_factor,
+            ilu_drop_tol,
+        )
+        x = _scatter(x, r.perm)
+        return x[:, 0] if squeezed else x
     x = _core.sparse_solve(
-        a,
+        _as_sparse(a),
         rhs,
         method,
         tol,
@@ -77,22 +370,40 @@ def solve_stats(
     a,
     b,
     *,
-    method: str = "cg",
+    method: str | None = None,
     tol: float = 1e-8,
     maxiter: int | None = None,
     preconditioner: str = "none",
     ilu_fill_factor: int = 10,
     ilu_drop_tol: float = 1e-4,
+    precision: str = "double",
 ):
-    """Return iteration count and estimated error for an iterative CG solve."""
-    sp = _require_scipy()
-    if not sp.issparse(a):
-        a = sp.csc_matrix(a)
+    """Return iteration count and estimated error for an iterative CG solve.
+
+    With ``precision="mixed"`` the stats instead describe the float32 LU plus float64
+    refinement: correction ``iterations``, backward ``error`` and ``fallback``. ``method``
+    defaults to ``"lu"`` for mixed precision and ``"cg"`` otherwise.
+    """
+    if method is None:
+        method = "lu" if precision == "mixed" else "cg"
     rhs, squeezed = _as_2d_rhs(b)
     if not squeezed and rhs.shape[1] != 1:
         raise ValueError("solve_stats requires a single RHS column")
+    if precision == "mixed":
+        if method != "lu":
+            raise ValueError("precision='mixed' requires method='lu'")
+        if isinstance(a, LinearOperator):
+            raise ValueError("precision='mixed' is not supported for LinearOperator inputs")
+        _, stats = factorize(a, precision=precision).solve_stats(rhs)
+        return stats
+    if precision != "double":
+        raise ValueError("precision must be 'double' or 'mixed'")
+    if isinstance(a, LinearOperator):
+        if method != "cg":
+            raise ValueError("solve_stats is only supported for method='cg'")
+        return _core.operator_solve_stats(a._op, rhs, tol, 0 if maxiter is None else maxiter, preconditioner)
     return _core.sparse_solve_stats(
-        a,
+        _as_sparse(a),
         rhs,
         method,
         tol,
@@ -103,22 +414,131 @@ def solve_stats(
     )
 
 
-def factorize(a, *, method: str = "auto"):
-    """Factorize sparse matrix and return reusable solver object."""
+LSTSQ_METHODS = ("qr", "lscg")
+
+
+def lstsq(
+    a,
+    b,
+    *,
+    method: str = "qr",
+    tol: float = 1e-8,
+    maxiter: int | None = None,
+    pivot_threshold: float | None = None,
+):
+    """Least-squares solution of ``min ||a x - b||_2`` for rectangular sparse ``a``.
+
+    ``method="qr"`` factors ``a`` with SparseQR under a COLAMD ordering (minimum-norm
+    solution when ``a`` has fewer rows than columns); ``"lscg"`` runs least-squares
+    conjugate gradient to relative tolerance ``tol``. Use ``factorize(a, method="qr")`` to
+    reuse the QR factors across right-hand sides.
+    """
+    if method not in LSTSQ_METHODS:
+        raise ValueError("method must be one of: qr, lscg")
+    return _core.sparse_lstsq(
+        _as_sparse(a),
+        np.asarray(b, dtype=np.float64),
+        method,
+        tol,
+        0 if maxiter is None else maxiter,
+        -1.0 if pivot_threshold is None else pivot_threshold,
+    )
+
+
+def factorize(a, *, method: str = "auto", permuted=None, precision: str = "double"):
+    """Factorize sparse matrix and return reusable solver object.
+
+    With ``permuted`` (a :class:`Reordering` or an ordering name) the reordered matrix is
+    factored with that ordering in place of SparseLU's default COLAMD; ``solve`` still
+    takes and returns vectors in the original ordering.
+
+    ``precision="mixed"`` runs SparseLU in float32 and refines each solve in float64,
+    switching to a float64 factorization when refinement does not converge. The factor's
+    ``stats`` property accumulates ``solves``, ``iterations`` and ``fallbacks``.
+
+    ``method="qr"`` accepts rectangular ``a`` and returns a ``SparseQRFactorized`` whose
+    ``solve`` gives the least-squares solution (see :func:`lstsq`).
+    """
+    if method == "qr":
+        if permuted is not None or precision != "double":
+            raise ValueError("method='qr' does not support permuted or precision")
+        return _core.sparse_factorize_qr(_as_sparse(a))
     if method != "auto":
-        raise ValueError("only method='auto' is currently supported")
-    sp = _require_scipy()
-    if not sp.issparse(a):
-        a = sp.csc_matrix(a)
-    return _core.sparse_factorize(a)
+        raise ValueError("method must be 'auto' or 'qr'")
+    _check_precision(precision, "lu", permuted)
+    if precision == "mixed":
+        return _core.sparse_factorize(_as_sparse(a), precision)
+    if permuted is not None:
+        r = _resolve_reordering(a, permuted)
+        return _core.sparse_factorize_permuted(r._handle, r._row_perm, r.perm)
+    return _core.sparse_factorize(_as_sparse(a))
 
 
 def to_dense(a):
-    """Convert sparse matrix to dense ndarray."""
+    """Convert sparse matrix (SciPy or :class:`Matrix`) to dense ndarray."""
     return np.asarray(a.toarray(), dtype=np.float64)
 
 
+def _as_index_array(x, name: str) -> np.ndarray:
+    arr = np.asarray(x)
+    if arr.ndim != 1:
+        raise ValueError(f"{name} must be a 1D array")
+    if arr.size and not np.issubdtype(arr.dtype, np.integer):
+        raise ValueError(f"{name} must contain integers")
+    if arr.dtype != np.int32 and arr.size and (arr.min() < 0 or arr.max() > np.iinfo(np.int32).max):
+        raise ValueError(f"{name} index out of bounds")
+    return np.ascontiguousarray(arr, dtype=np.int32)
+
+
+def _as_shape(shape) -> tuple[int, int]:
+    rows, cols = (int(v) for v in shape)
+    return rows, cols
+
+
 def from_coo(data, row, col, shape):
-    """Build sparse matrix from COO inputs."""
-    sp = _require_scipy()
-    return sp.coo_matrix((data, (row, col)), shape=shape).tocsc()
+    """Build a CSC matrix from COO inputs; duplicate entries are summed."""
+    _require_scipy()
+    rows, cols = _as_shape(shape)
+    values = np.ascontiguousarray(np.asarray(data, dtype=np.float64))
+    return _core.coo_to_csc(values, _as_index_array(row, "row"), _as_index_array(col, "col"), rows, cols)
+
+
+class CooPattern:
+    """Reusable COO -> CSC assembly for a fixed sparsity pattern.
+
+    The CSC structure and the triplet-to-slot map are computed once from ``row``/``col``.
+    :meth:`assemble` then only sums the triplet values into place, so reassembling a
+    matrix with new values (e.g. in a finite-element loop) skips sorting entirely.
+    """
+
+    def __init__(self, row, col, shape):
+        _require_scipy()
+        rows, cols = _as_shape(shape)
+        self._pattern = _core.CooPattern(_as_index_array(row, "row"), _as_index_array(col, "col"), rows, cols)
+
+    @property
+    def shape(self) -> tuple[int, int]:
+        return tuple(self._pattern.shape)
+
+    @property
+    def nnz(self) -> int:
+        """Stored entries after merging duplicates."""
+        return int(self._pattern.nnz)
+
+    @property
+    def n_triplets(self) -> int:
+        return int(self._pattern.triplets)
+
+    def assemble(self, data, *, out=None):
+        """Return the CSC matrix for triplet values ``data`` (same order as ``row``/``col``).
+
+        With ``out`` (a matrix previously returned by this pattern's ``assemble``) the
+        values are written into ``out.data`` in place and ``out`` is returned.
+        """
+        values = np.ascontiguousarray(np.asarray(data, dtype=np.float64))
+        if out is None:
+            return self._pattern.assemble(values)
+        if tuple(out.shape) != self.shape or out.nnz != self.nnz:
+            raise ValueError("out was not assembled from this pattern")
+        self._pattern.assemble_into(values, out.data)
+        return out
@@ -0,0 +1,71 @@
+"""Runtime thread controls for Eigen, OpenMP and the linked BLAS/LAPACK backend."""
+
+from __future__ import annotations
+
+from . import _core
+
+_LAYERS = ("eigen", "openmp", "blas")
+
+
+def set_num_threads(n: int) -> None:
+    """Set the thread count used by Eigen, OpenMP and the BLAS backend.
+
+    ``n=0`` restores the default (number of available cores).
+    """
+    _core.set_num_threads(int(n), "all")
+
+
+def get_num_threads() -> int:
+    """Return the thread count Eigen's parallel kernels will use."""
+    return int(_core.get_num_threads())
+
+
+def thread_info() -> dict:
+    """Return the effective per-layer thread counts.
+
+    ``blas`` is ``-1`` when the linked BLAS exposes no runtime threading API
+    (e.g. Apple Accelerate or reference BLAS).
+    """
+    return dict(_core.thread_info())
+
+
+class threadpool_limits:
+    """Context manager limiting Eigen, OpenMP and BLAS threads for a block.
+
+    ``limits=None`` leaves the current settings untouched. ``user_api`` restricts
+    the limit to a single layer (``"eigen"``, ``"openmp"`` or ``"blas"``).
+    Previous per-layer settings are restored on exit.
+    """
+
+    def __init__(self, limits: int | None = None, *, user_api: str | None = None):
+        if user_api is not None and user_api not in _LAYERS:
+            raise ValueError("user_api must be one of: eigen, openmp, blas")
+        if limits is not None and limits < 1:
+            raise ValueError("limits must be a positive integer or None")
+        self._limits = limits
+        self._user_api = user_api
+        self._saved: dict | None = None
+        self._apply()
+
+    def _apply(self) -> None:
+        self._saved = thread_info()
+        if self._limits is not None:
+            _core.set_num_threads(int(self._limits), self._user_api or "all")
+
+    def restore_original_limits(self) -> None:
+        if self._saved is None:
+            return
+        for layer in _LAYERS:
+            previous = self._saved[layer]
+            if previous > 0:
+                _core.set_num_threads(int(previous), layer)
+        self._saved = None
+
+    def __enter__(self) -> "threadpool_limits":
+        return self
+
+    def __exit__(self, exc_type, exc, tb) -> None:
+        self.restore_original_limits()
+
+
+__all__ = ["set_num_threads", "get_num_threads", "thread_info", "threadpool_limits"]
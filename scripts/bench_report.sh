@@ -3,3 +3,4 @@ set -euo pipefail
 
 python benchmarks/bench_dense.py
 python benchmarks/bench_sparse.py
+python benchmarks/bench_threads.py
@@ -1,6 +1,13 @@
-#include <cmath>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstring>
+#include <exception>
+#include <functional>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -12,24 +19,22 @@
 
 #include <Eigen/Core>
 #include <Eigen/Dense>
-#include <Eigen/IterativeLinearSolvers>
 #include <Eigen/Sparse>
 #include <Eigen/SparseLU>
 
-#if defined(PEIGEN_LAPACK_ENABLED)
-#include <lapack/lapack.h>
-
-using lapack_int = int;
-
-// Not declared in Eigen's bundled lapack.h (used for divide-and-conquer / MRRR paths).
-extern "C" {
-EIGEN_LAPACK_API void BLASFUNC(dsyevd)(const char *, const char *, int *, double *, int *, double *, double *, int *,
-                                       int *, int *, int *);
-EIGEN_LAPACK_API void BLASFUNC(dsyevr)(const char *, const char *, const char *, int *, double *, int *,
-                                       double *, double *, int *, int *, double *, int *, double *, double *, int *,
-                                       int *, double *, int *, int *, int *, int *);
-}
-#endif
+#include "core/assembly.h"
+#include "core/batched.h"
+#include "core/cholesky.h"
+#include "core/common.h"
+#include "core/dense.h"
+#include "core/dispatch.h"
+#include "core/factor_cache.h"
+#include "core/least_squares.h"
+#include "core/linear_operator.h"
+#include "core/ordering.h"
+#include "core/sparse.h"
+#include "core/task_pool.h"
+#include "core/threads.h"
 
 namespace py = pybind11;
 
@@ -49,16 +54,15 @@ namespace py = pybind11;
 #define PEIGEN_OPENMP_ENABLED 0
 #endif
 
-using RowMatrix = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
-using ColMatrix = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor>;
-using Vector = Eigen::Matrix<double, Eigen::Dynamic, 1>;
-using Sparse = Eigen::SparseMatrix<double, Eigen::ColMajor, int>;
-
-struct SvdFactors {
-  ColMatrix u;
-  Eigen::VectorXd s;
-  ColMatrix vt;
-};
+using peigen::ColMatrix;
+using peigen::EighFactors;
+using peigen::LinearOperator;
+using peigen::LinearOperatorPtr;
+using peigen::RowMatrix;
+using peigen::RowSparse;
+using peigen::SparseHandle;
+using peigen::Sparse;
+using peigen::SvdFactors;
 
 static void validate_2d(const py::array &arr, const std::string &name) {
   if (arr.ndim() != 2) {
@@ -155,320 +159,27 @@ static py::array_t<double> vector_to_numpy(const Eigen::VectorXd &v) {
   return arr;
 }
 
-static std::string resolve_svd_method(const std::string &method) {
-  if (method == "auto") {
-#if defined(PEIGEN_LAPACK_ENABLED)
-    return "lapack";
-#else
-    return "bdcsvd";
-#endif
-  }
-  if (method == "bdcsvd" || method == "lapack") {
-#if !defined(PEIGEN_LAPACK_ENABLED)
-    if (method == "lapack") {
-      throw py::value_error("LAPACK SVD requested but this build was compiled without LAPACK support");
-    }
-#endif
-    return method;
-  }
-  throw py::value_error("method must be one of: auto, bdcsvd, lapack");
-}
-
-static SvdFactors compute_svd_bdcsvd(const ColMatrix &matrix, bool full_matrices) {
-  if (full_matrices) {
-    Eigen::BDCSVD<ColMatrix, Eigen::ComputeFullU | Eigen::ComputeFullV> svd(matrix);
-    if (svd.info() != Eigen::Success) {
-      throw std::runtime_error("BDCSVD failed");
-    }
-    SvdFactors out;
-    out.u = svd.matrixU();
-    out.s = svd.singularValues();
-    out.vt = svd.matrixV().adjoint();
-    return out;
-  }
-
-  Eigen::BDCSVD<ColMatrix, Eigen::ComputeThinU | Eigen::ComputeThinV> svd(matrix);
-  if (svd.info() != Eigen::Success) {
-    throw std::runtime_error("BDCSVD failed");
-  }
-
-  SvdFactors out;
-  out.u = svd.matrixU();
-  out.s = svd.singularValues();
-  out.vt = svd.matrixV().adjoint();
-  return out;
-}
-
-#if defined(PEIGEN_LAPACK_ENABLED)
-static SvdFactors compute_svd_lapack(ColMatrix matrix, bool full_matrices) {
-  lapack_int m = static_cast<lapack_int>(matrix.rows());
-  lapack_int n = static_cast<lapack_int>(matrix.cols());
-  const lapack_int k = std::min(m, n);
-  char jobz = full_matrices ? 'A' : 'S';
-
-  SvdFactors out;
-  out.s = Eigen::VectorXd::Zero(k);
-
-  const lapack_int u_cols = (jobz == 'A') ? m : k;
-  const lapack_int vt_rows = (jobz == 'A') ? n : k;
-  out.u = ColMatrix::Zero(m, u_cols);
-  ColMatrix vt = ColMatrix::Zero(vt_rows, n);
-
-  lapack_int lda = static_cast<lapack_int>(matrix.outerStride());
-  lapack_int ldu = static_cast<lapack_int>(out.u.outerStride());
-  lapack_int ldvt = static_cast<lapack_int>(vt.outerStride());
-  lapack_int lwork = -1;
-  double work_query = 0.0;
-  lapack_int info = 0;
-  std::vector<lapack_int> iwork(static_cast<std::size_t>(8) * static_cast<std::size_t>(k));
-
-  BLASFUNC(dgesdd)(&jobz, &m, &n, matrix.data(), &lda, out.s.data(), out.u.data(), &ldu, vt.data(), &ldvt,
-                   &work_query, &lwork, iwork.data(), &info);
-  if (info != 0) {
-    throw std::runtime_error("LAPACK dgesdd workspace query failed with info=" + std::to_string(info));
-  }
-
-  lwork = static_cast<lapack_int>(work_query);
-  std::vector<double> work(static_cast<std::size_t>(lwork));
-
-  BLASFUNC(dgesdd)(&jobz, &m, &n, matrix.data(), &lda, out.s.data(), out.u.data(), &ldu, vt.data(), &ldvt,
-                   work.data(), &lwork, iwork.data(), &info);
-  if (info != 0) {
-    throw std::runtime_error("LAPACK dgesdd failed with info=" + std::to_string(info));
-  }
-
-  out.vt = vt;
-  return out;
-}
-#endif
-
-static SvdFactors compute_svd(const ColMatrix &matrix, bool full_matrices, const std::string &method) {
-  const std::string resolved = resolve_svd_method(method);
-  if (resolved == "lapack") {
-#if defined(PEIGEN_LAPACK_ENABLED)
-    return compute_svd_lapack(matrix, full_matrices);
-#else
-    throw py::value_error("LAPACK SVD requested but LAPACK is unavailable in this build");
-#endif
-  }
-  return compute_svd_bdcsvd(matrix, full_matrices);
-}
-
-struct EighFactors {
-  Eigen::VectorXd w;
-  ColMatrix v;
-};
-
-static std::string resolve_eigh_method(const std::string &method) {
-  if (method == "auto") {
-#if defined(PEIGEN_LAPACK_ENABLED)
-    return "lapack";
-#else
-    return "eigen";
-#endif
-  }
-  if (method == "eigen" || method == "lapack") {
-#if !defined(PEIGEN_LAPACK_ENABLED)
-    if (method == "lapack") {
-      throw py::value_error("LAPACK eigh requested but this build was compiled without LAPACK support");
-    }
-#endif
-    return method;
-  }
-  throw py::value_error("method must be one of: auto, eigen, lapack");
-}
-
-static std::string resolve_lapack_eigen_method(const std::string &method, const char *routine) {
-  if (method == "auto") {
-#if defined(PEIGEN_LAPACK_ENABLED)
-    return "lapack";
-#else
-    return "eigen";
-#endif
-  }
-  if (method == "eigen" || method == "lapack") {
-#if !defined(PEIGEN_LAPACK_ENABLED)
-    if (method == "lapack") {
-      throw py::value_error(std::string("LAPACK ") + routine +
-                            " requested but this build was compiled without LAPACK support");
-    }
-#endif
-    return method;
-  }
-  throw py::value_error("method must be one of: auto, eigen, lapack");
-}
-
-static ColMatrix dense_col_from_row_ref(const Eigen::Ref<const RowMatrix> &rhs) {
-  ColMatrix out(rhs.rows(), rhs.cols());
-  out = rhs;
-  return out;
-}
-
-static EighFactors compute_eigh_eigen(const ColMatrix &matrix, bool lower, bool eigenvectors) {
-  const unsigned options = eigenvectors ? Eigen::ComputeEigenvectors : Eigen::EigenvaluesOnly;
-  Eigen::SelfAdjointEigenSolver<ColMatrix> solver;
-  if (lower) {
-    solver.compute(matrix, options);
-  } else {
-    solver.compute(matrix.selfadjointView<Eigen::Upper>(), options);
-  }
-
-  if (solver.info() != Eigen::Success) {
-    throw std::runtime_error("SelfAdjointEigenSolver failed");
-  }
-
-  EighFactors out;
-  out.w = solver.eigenvalues();
-  if (eigenvectors) {
-    out.v = solver.eigenvectors();
-  }
-  return out;
-}
-
-#if defined(PEIGEN_LAPACK_ENABLED)
-static void lapack_dsyev_values(ColMatrix &matrix, bool lower, Eigen::VectorXd &w) {
-  lapack_int n = static_cast<lapack_int>(matrix.rows());
-  char jobz = 'N';
-  char uplo = lower ? 'L' : 'U';
-  lapack_int lda = static_cast<lapack_int>(matrix.outerStride());
-  lapack_int lwork = -1;
-  lapack_int info = 0;
-  double work_query = 0.0;
-
-  BLASFUNC(dsyev)(&jobz, &uplo, &n, matrix.data(), &lda, w.data(), &work_query, &lwork, &info);
-  if (info != 0) {
-    throw std::runtime_error("LAPACK dsyev workspace query failed with info=" + std::to_string(info));
-  }
-
-  lwork = static_cast<lapack_int>(work_query);
-  std::vector<double> work(static_cast<std::size_t>(lwork));
-
-  BLASFUNC(dsyev)(&jobz, &uplo, &n, matrix.data(), &lda, w.data(), work.data(), &lwork, &info);
-  if (info != 0) {
-    throw std::runtime_error("LAPACK dsyev failed with info=" + std::to_string(info));
-  }
-}
-
-static bool lapack_dsyevr_values(ColMatrix &matrix, bool lower, Eigen::VectorXd &w) {
-  lapack_int n = static_cast<lapack_int>(matrix.rows());
-  char jobz = 'N';
-  char range = 'A';
-  char uplo = lower ? 'L' : 'U';
-  lapack_int lda = static_cast<lapack_int>(matrix.outerStride());
-  double vl = 0.0;
-  double vu = 0.0;
-  lapack_int il = 1;
-  lapack_int iu = n;
-  double abstol = 0.0;
-  lapack_int m = 0;
-  lapack_int ldz = 1;
-  lapack_int lwork = -1;
-  lapack_int liwork = -1;
-  lapack_int info = 0;
-  double work_query = 0.0;
-  lapack_int iwork_query = 0;
-
-  BLASFUNC(dsyevr)(&jobz, &range, &uplo, &n, matrix.data(), &lda, &vl, &vu, &il, &iu, &abstol, &m, w.data(),
-                   nullptr, &ldz, nullptr, &work_query, &lwork, &iwork_query, &liwork, &info);
-  if (info != 0) {
-    return false;
-  }
-
-  lwork = static_cast<lapack_int>(work_query);
-  liwork = iwork_query;
-  std::vector<double> work(static_cast<std::size_t>(lwork));
-  std::vector<lapack_int> iwork(static_cast<std::size_t>(liwork));
-
-  BLASFUNC(dsyevr)(&jobz, &range, &uplo, &n, matrix.data(), &lda, &vl, &vu, &il, &iu, &abstol, &m, w.data(),
-                   nullptr, &ldz, nullptr, work.data(), &lwork, iwork.data(), &liwork, &info);
-  if (info != 0 || m != n) {
-    return false;
-  }
-  return true;
-}
-
-static EighFactors compute_eigh_lapack_vals(ColMatrix matrix, bool lower) {
-  if (matrix.rows() != matrix.cols()) {
-    throw py::value_error("eigh requires square matrix");
-  }
-
-  const lapack_int n = static_cast<lapack_int>(matrix.rows());
-  EighFactors out;
-  out.w = Eigen::VectorXd::Zero(n);
-
-  if (!lapack_dsyevr_values(matrix, lower, out.w)) {
-    lapack_dsyev_values(matrix, lower, out.w);
-  }
-  return out;
-}
-
-static EighFactors compute_eigh_lapack(ColMatrix matrix, bool lower, bool eigenvectors) {
-  if (matrix.rows() != matrix.cols()) {
-    throw py::value_error("eigh requires square matrix");
-  }
-
-  if (!eigenvectors) {
-    return compute_eigh_lapack_vals(matrix, lower);
-  }
-
-  lapack_int n = static_cast<lapack_int>(matrix.rows());
-  char jobz = 'V';
-  char uplo = lower ? 'L' : 'U';
-  lapack_int lda = static_cast<lapack_int>(matrix.outerStride());
-  lapack_int lwork = -1;
-  lapack_int liwork = -1;
-  double work_query = 0.0;
-  lapack_int iwork_query = 0;
-  lapack_int info = 0;
-
-  EighFactors out;
-  out.w = Eigen::VectorXd::Zero(n);
-
-  BLASFUNC(dsyevd)(&jobz, &uplo, &n, matrix.data(), &lda, out.w.data(), &work_query, &lwork, &iwork_query,
-                   &liwork, &info);
-  if (info != 0) {
-    throw std::runtime_error("LAPACK dsyevd workspace query failed with info=" + std::to_string(info));
-  }
-
-  lwork = static_cast<lapack_int>(work_query);
-  liwork = iwork_query;
-  std::vector<double> work(static_cast<std::size_t>(lwork));
-  std::vector<lapack_int> iwork(static_cast<std::size_t>(liwork));
-
-  BLASFUNC(dsyevd)(&jobz, &uplo, &n, matrix.data(), &lda, out.w.data(), work.data(), &lwork, iwork.data(), &liwork,
-                   &info);
-  if (info != 0) {
-    throw std::runtime_error("LAPACK dsyevd failed with info=" + std::to_string(info));
-  }
-
-  out.v = std::move(matrix);
-  return out;
-}
-#endif
-
-static EighFactors compute_eigh(const ColMatrix &matrix, bool lower, bool eigenvectors,
-                                const std::string &method) {
-  const std::string resolved = resolve_eigh_method(method);
-  if (resolved == "lapack") {
-#if defined(PEIGEN_LAPACK_ENABLED)
-    return compute_eigh_lapack(matrix, lower, eigenvectors);
-#else
-    throw py::value_error("LAPACK eigh requested but LAPACK is unavailable in this build");
-#endif
-  }
-  return compute_eigh_eigen(matrix, lower, eigenvectors);
-}
-
 static py::tuple svd_to_python(const SvdFactors &factors) {
   return py::make_tuple(assign_to_output(factors.u), vector_to_numpy(factors.s), assign_to_output(factors.vt));
 }
 
+// Keeps the SciPy matrix and its (possibly converted) index/value arrays alive for as long
+// as `mat` is used.
 struct SparseCscView {
   py::object owner;
+  py::object indptr;
+  py::object indices;
+  py::object data;
   Eigen::Map<const Sparse> mat;
 };
 
 static SparseCscView map_sparse_csc(py::object matrix_obj, bool allow_csr = false) {
+  // peigen.sparse.Matrix handles already own validated CSC storage.
+  if (py::isinstance<SparseHandle>(matrix_obj)) {
+    const Eigen::Map<const Sparse> mat = matrix_obj.cast<const SparseHandle &>().map();
+    return SparseCscView{std::move(matrix_obj), py::object(), py::object(), py::object(), mat};
+  }
+
   py::module_ scipy_sparse = py::module_::import("scipy.sparse");
   py::object csc_type = scipy_sparse.attr("csc_matrix");
   py::object csr_type = scipy_sparse.attr("csr_matrix");
@@ -490,30 +201,38 @@ static SparseCscView map_sparse_csc(py::object matrix_obj, bool allow_csr = fals
   auto indices = csc_obj.attr("indices").cast<py::array_t<int, py::array::forcecast>>();
   auto data = csc_obj.attr("data").cast<py::array_t<double, py::array::forcecast>>();
 
-  return SparseCscView{
-      std::move(csc_obj),
-      Eigen::Map<const Sparse>(rows, cols, static_cast<int>(data.size()), indptr.data(),
-                               indices.data(), data.data()),
-  };
+  const Eigen::Map<const Sparse> mat(rows, cols, static_cast<int>(data.size()), indptr.data(), indices.data(),
+                                     data.data());
+  return SparseCscView{std::move(csc_obj), std::move(indptr), std::move(indices), std::move(data), mat};
 }
 
-static py::object to_scipy_csc(const Sparse &mat) {
+// Copies compressed storage into a new scipy.sparse csc_matrix / csr_matrix.
+static py::object make_scipy_compressed(const char *type, Eigen::Index rows, Eigen::Index cols,
+                                        const int *outer, Eigen::Index outer_size, const int *inner,
+                                        const double *values, Eigen::Index nnz) {
   py::module_ sparse_mod = py::module_::import("scipy.sparse");
 
-  Sparse cpy = mat;
-  cpy.makeCompressed();
-
-  py::array_t<double> data(cpy.nonZeros());
-  py::array_t<int> indices(cpy.nonZeros());
-  py::array_t<int> indptr(cpy.outerSize() + 1);
+  py::array_t<double> data(nnz);
+  py::array_t<int> indices(nnz);
+  py::array_t<int> indptr(outer_size + 1);
 
-  std::memcpy(data.mutable_data(), cpy.valuePtr(), sizeof(double) * cpy.nonZeros());
-  std::memcpy(indices.mutable_data(), cpy.innerIndexPtr(), sizeof(int) * cpy.nonZeros());
-  std::memcpy(indptr.mutable_data(), cpy.outerIndexPtr(), sizeof(int) * (cpy.outerSize() + 1));
+  std::memcpy(data.mutable_data(), values, sizeof(double) * nnz);
+  std::memcpy(indices.mutable_data(), inner, sizeof(int) * nnz);
+  std::memcpy(indptr.mutable_data(), outer, sizeof(int) * (outer_size + 1));
 
-  py::tuple shape = py::make_tuple(cpy.rows(), cpy.cols());
+  py::tuple shape = py::make_tuple(rows, cols);
   py::tuple args = py::make_tuple(py::make_tuple(data, indices, indptr), shape);
-  return sparse_mod.attr("csc_matrix")(*args);
+  return sparse_mod.attr(type)(*args);
+}
+
+static py::object to_scipy_csc(const Sparse &mat) {
+  if (mat.isCompressed()) {
+    return make_scipy_compressed("csc_matrix", mat.rows(), mat.cols(), mat.outerIndexPtr(), mat.outerSize(),
+                                 mat.innerIndexPtr(), mat.valuePtr(), mat.nonZeros());
+  }
+  Sparse cpy = mat;
+  cpy.makeCompressed();
+  return to_scipy_csc(cpy);
 }
 
 static py::array_t<double> core_matmul(const py::array_t<double, py::array::forcecast> &a,
@@ -528,27 +247,44 @@ static py::array_t<double> core_matmul(const py::array_t<double, py::array::forc
   }
 
   py::array_t<double> out_arr = make_output_array(lhs.rows(), rhs.cols());
-  Eigen::Map<RowMatrix> out(out_arr.mutable_data(), lhs.rows(), rhs.cols());
-  out.noalias() = lhs * rhs;
+  peigen::gemm(lhs, rhs, Eigen::Map<RowMatrix>(out_arr.mutable_data(), lhs.rows(), rhs.cols()));
   return out_arr;
 }
 
-#if defined(PEIGEN_LAPACK_ENABLED)
-static py::array_t<double> solve_lapack(ColMatrix lhs, ColMatrix rhs) {
-  lapack_int n = static_cast<lapack_int>(lhs.rows());
-  lapack_int nrhs = static_cast<lapack_int>(rhs.cols());
-  lapack_int lda = static_cast<lapack_int>(lhs.outerStride());
-  lapack_int ldb = static_cast<lapack_int>(rhs.outerStride());
-  lapack_int info = 0;
-  std::vector<lapack_int> ipiv(static_cast<std::size_t>(n));
+static py::array_t<double> core_gram(const py::array_t<double, py::array::forcecast> &a, bool trans, bool lower,
+                                     bool mirror) {
+  std::unique_ptr<RowMatrix> owned_a;
+  const Eigen::Ref<const RowMatrix> m = dense_row_ref(a, "a", owned_a);
+  const Eigen::Index n = trans ? m.cols() : m.rows();
+  py::array_t<double> out_arr = make_output_array(n, n);
+  peigen::gram(m, trans, lower, mirror, Eigen::Map<RowMatrix>(out_arr.mutable_data(), n, n));
+  return out_arr;
+}
 
-  BLASFUNC(dgesv)(&n, &nrhs, lhs.data(), &lda, ipiv.data(), rhs.data(), &ldb, &info);
-  if (info != 0) {
-    throw py::value_error("matrix is singular or ill-conditioned");
-  }
-  return assign_to_output(rhs);
+static py::array_t<double> core_trmm(const py::array_t<double, py::array::forcecast> &a,
+                                     const py::array_t<double, py::array::forcecast> &b, bool lower,
+                                     bool unit_diagonal, bool left) {
+  std::unique_ptr<RowMatrix> owned_a;
+  std::unique_ptr<RowMatrix> owned_b;
+  const Eigen::Ref<const RowMatrix> lhs = dense_row_ref(a, "a", owned_a);
+  const Eigen::Ref<const RowMatrix> rhs = dense_row_ref(b, "b", owned_b);
+  py::array_t<double> out_arr = make_output_array(rhs.rows(), rhs.cols());
+  peigen::triangular_multiply(lhs, rhs, lower, unit_diagonal, left,
+                              Eigen::Map<RowMatrix>(out_arr.mutable_data(), rhs.rows(), rhs.cols()));
+  return out_arr;
+}
+
+static py::array_t<double> core_symm(const py::array_t<double, py::array::forcecast> &a,
+                                     const py::array_t<double, py::array::forcecast> &b, bool lower, bool left) {
+  std::unique_ptr<RowMatrix> owned_a;
+  std::unique_ptr<RowMatrix> owned_b;
+  const Eigen::Ref<const RowMatrix> lhs = dense_row_ref(a, "a", owned_a);
+  const Eigen::Ref<const RowMatrix> rhs = dense_row_ref(b, "b", owned_b);
+  py::array_t<double> out_arr = make_output_array(rhs.rows(), rhs.cols());
+  peigen::symmetric_multiply(lhs, rhs, lower, left,
+                             Eigen::Map<RowMatrix>(out_arr.mutable_data(), rhs.rows(), rhs.cols()));
+  return out_arr;
 }
-#endif
 
 static double core_norm(const py::array_t<double, py::array::forcecast> &a) {
   validate_2d(a, "a");
@@ -558,44 +294,44 @@ static double core_norm(const py::array_t<double, py::array::forcecast> &a) {
 
   if (is_c_contiguous(a) || is_f_contiguous(a)) {
     const auto *data = static_cast<const double *>(a.data());
-    return Eigen::Map<const Vector>(data, size).norm();
+    return peigen::kernels().norm(data, size);
   }
 
   std::unique_ptr<RowMatrix> owned_a;
   const Eigen::Ref<const RowMatrix> m = dense_row_ref(a, "a", owned_a);
-  return m.norm();
+  return peigen::kernels().norm(m.data(), size);
 }
 
 static py::array_t<double> core_solve(const py::array_t<double, py::array::forcecast> &a,
                                       const py::array_t<double, py::array::forcecast> &b,
                                       const std::string &method) {
-  const ColMatrix lhs = dense_col_for_factorization(a, "a");
+  ColMatrix lhs = dense_col_for_factorization(a, "a");
   std::unique_ptr<RowMatrix> owned_b;
   const Eigen::Ref<const RowMatrix> rhs = dense_row_ref(b, "b", owned_b);
+  return assign_to_output(peigen::solve_dense(std::move(lhs), peigen::dense_col_from_row_ref(rhs), method));
+}
 
-  if (lhs.rows() != lhs.cols()) {
-    throw py::value_error("a must be square");
-  }
-  if (lhs.rows() != rhs.rows()) {
-    throw py::value_error("a and b shape mismatch");
-  }
-
-  const std::string resolved = resolve_lapack_eigen_method(method, "solve");
-  if (resolved == "lapack") {
-#if defined(PEIGEN_LAPACK_ENABLED)
-    return solve_lapack(lhs, dense_col_from_row_ref(rhs));
-#else
-    throw py::value_error("LAPACK solve requested but LAPACK is unavailable in this build");
-#endif
-  }
-
-  Eigen::PartialPivLU<ColMatrix> lu(lhs);
-  if (lu.matrixLU().diagonal().cwiseAbs().minCoeff() < 1e-15) {
-    throw py::value_error("matrix is singular or ill-conditioned");
-  }
+static py::dict refinement_stats(const peigen::RefinementInfo &info) {
+  py::dict out;
+  out["precision"] = "mixed";
+  out["iterations"] = info.iterations;
+  out["error"] = info.backward_error;
+  out["fallback"] = info.fallback;
+  return out;
+}
 
-  ColMatrix rhs_col = dense_col_from_row_ref(rhs);
-  return assign_to_output(lu.solve(rhs_col));
+// Returns (x, stats) for precision="mixed"; stats["fallback"] reports whether the float LU
+// was abandoned for a full double-precision solve.
+static py::tuple core_solve_mixed(const py::array_t<double, py::array::forcecast> &a,
+                                  const py::array_t<double, py::array::forcecast> &b,
+                                  const std::string &method) {
+  const ColMatrix lhs = dense_col_for_factorization(a, "a");
+  std::unique_ptr<RowMatrix> owned_b;
+  const Eigen::Ref<const RowMatrix> rhs = dense_row_ref(b, "b", owned_b);
+  peigen::RefinementInfo info;
+  py::array_t<double> x =
+      assign_to_output(peigen::solve_dense_mixed(lhs, peigen::dense_col_from_row_ref(rhs), method, info));
+  return py::make_tuple(std::move(x), refinement_stats(info));
 }
 
 static py::tuple core_qr(const py::array_t<double, py::array::forcecast> &a,
@@ -624,14 +360,14 @@ static py::tuple core_svd(const py::array_t<double, py::array::forcecast> &a,
                           bool full_matrices,
                           const std::string &method) {
   const ColMatrix matrix = dense_col_for_factorization(a, "a");
-  return svd_to_python(compute_svd(matrix, full_matrices, method));
+  return svd_to_python(peigen::compute_svd(matrix, full_matrices, method));
 }
 
 static double core_svd_compute(const py::array_t<double, py::array::forcecast> &a,
                                bool full_matrices,
                                const std::string &method) {
   const ColMatrix matrix = dense_col_for_factorization(a, "a");
-  const SvdFactors factors = compute_svd(matrix, full_matrices, method);
+  const SvdFactors factors = peigen::compute_svd(matrix, full_matrices, method);
   return factors.s.sum();
 }
 
@@ -642,13 +378,131 @@ static py::object core_eigh(const py::array_t<double, py::array::forcecast> &a,
     throw py::value_error("eigh requires square matrix");
   }
 
-  const EighFactors factors = compute_eigh(m, lower, eigenvectors, method);
+  const EighFactors factors = peigen::compute_eigh(m, lower, eigenvectors, method);
+  if (eigenvectors) {
+    return py::make_tuple(vector_to_numpy(factors.w), assign_to_output(factors.v));
+  }
+  return vector_to_numpy(factors.w);
+}
+
+// b is an array or a CholeskyFactor of it (the factor is reused as is, so `lower` then only
+// applies to a). subset_lo < 0 returns every eigenpair.
+static py::object core_eigh_generalized(const py::array_t<double, py::array::forcecast> &a, const py::object &b,
+                                        int type, bool lower, bool eigenvectors, const std::string &method,
+                                        Eigen::Index subset_lo, Eigen::Index subset_hi) {
+  const ColMatrix m = dense_col_for_factorization(a, "a");
+  EighFactors factors;
+  if (py::isinstance<peigen::CholeskyFactor>(b)) {
+    factors = peigen::compute_generalized_eigh(m, b.cast<const peigen::CholeskyFactor &>(), type, lower,
+                                               eigenvectors, method, subset_lo, subset_hi);
+  } else {
+    const ColMatrix mass = dense_col_for_factorization(b.cast<py::array_t<double, py::array::forcecast>>(), "b");
+    factors = peigen::compute_generalized_eigh(m, mass, type, lower, eigenvectors, method, subset_lo, subset_hi);
+  }
   if (eigenvectors) {
     return py::make_tuple(vector_to_numpy(factors.w), assign_to_output(factors.v));
   }
   return vector_to_numpy(factors.w);
 }
 
+static std::shared_ptr<peigen::CholeskyFactor> core_cholesky_factor(const py::array_t<double, py::array::forcecast> &b,
+                                                                    bool lower) {
+  return std::make_shared<peigen::CholeskyFactor>(dense_col_for_factorization(b, "b"), lower);
+}
+
+// A 1D (n) or 2D (n x k) operand of a dense factor object, as n x k column-major.
+static ColMatrix factor_operand(const py::array_t<double, py::array::forcecast> &arr, Eigen::Index n,
+                                const std::string &name) {
+  if (arr.ndim() != 1 && arr.ndim() != 2) {
+    throw py::value_error(name + " must be a 1D or 2D array");
+  }
+  if (arr.shape(0) != n) {
+    throw py::value_error("factor and " + name + " shape mismatch");
+  }
+  if (arr.ndim() == 2) {
+    return dense_col_for_factorization(arr, name);
+  }
+  ColMatrix out(n, 1);
+  const auto buf = arr.unchecked<1>();
+  for (Eigen::Index i = 0; i < n; ++i) {
+    out(i, 0) = buf(i);
+  }
+  return out;
+}
+
+// The result has the shape of b. Factor methods keep the GIL: update() mutates in place and
+// must not overlap a solve on another thread.
+template <typename Factor>
+static py::array dense_factor_solve(const Factor &factor, const py::array_t<double, py::array::forcecast> &b) {
+  const ColMatrix x = factor.solve(factor_operand(b, factor.size(), "b"));
+  if (b.ndim() == 1) {
+    return vector_to_numpy(Eigen::VectorXd(x.col(0)));
+  }
+  return assign_to_output(x);
+}
+
+// In-place B + sign * U U^T for u of shape (n,) or (n, k).
+template <typename Factor>
+static void dense_factor_update(Factor &factor, const py::array_t<double, py::array::forcecast> &u, int sign) {
+  if (sign != 1 && sign != -1) {
+    throw py::value_error("sign must be +1 or -1");
+  }
+  factor.update(factor_operand(u, factor.size(), "u"), static_cast<double>(sign));
+}
+
+static std::shared_ptr<peigen::LDLTFactor> core_ldlt_factor(const py::array_t<double, py::array::forcecast> &a,
+                                                            bool lower) {
+  return std::make_shared<peigen::LDLTFactor>(dense_col_for_factorization(a, "a"), lower);
+}
+
+using BatchArray = py::array_t<double, py::array::c_style | py::array::forcecast>;
+
+static void validate_batch(const BatchArray &a, const char *routine) {
+  if (a.ndim() != 3 || a.shape(1) != a.shape(2)) {
+    throw py::value_error(std::string(routine) + " requires an array of shape (batch, n, n)");
+  }
+}
+
+// One call for a whole (batch, n, n) stack; the loop runs natively without the GIL.
+static py::object core_eigh_batched(const BatchArray &a, bool lower, bool eigenvectors, const std::string &method) {
+  validate_batch(a, "eigh_batched");
+  const py::ssize_t batch = a.shape(0);
+  const py::ssize_t n = a.shape(1);
+  py::array_t<double> w({batch, n});
+  py::array_t<double> v(eigenvectors ? std::vector<py::ssize_t>{batch, n, n} : std::vector<py::ssize_t>{0});
+  {
+    const double *in = a.data();
+    double *w_data = w.mutable_data();
+    double *v_data = eigenvectors ? v.mutable_data() : nullptr;
+    py::gil_scoped_release release;
+    peigen::batched_eigh(in, batch, static_cast<int>(n), lower, eigenvectors, method, w_data, v_data);
+  }
+  if (eigenvectors) {
+    return py::make_tuple(std::move(w), std::move(v));
+  }
+  return std::move(w);
+}
+
+// b has shape (batch, n) or (batch, n, k); x matches it.
+static py::array_t<double> core_solve_batched(const BatchArray &a, const BatchArray &b, bool positive_definite) {
+  validate_batch(a, "solve_batched");
+  const py::ssize_t batch = a.shape(0);
+  const py::ssize_t n = a.shape(1);
+  if ((b.ndim() != 2 && b.ndim() != 3) || b.shape(0) != batch || b.shape(1) != n) {
+    throw py::value_error("solve_batched requires b of shape (batch, n) or (batch, n, k)");
+  }
+  const py::ssize_t nrhs = b.ndim() == 3 ? b.shape(2) : 1;
+  py::array_t<double> x(std::vector<py::ssize_t>(b.shape(), b.shape() + b.ndim()));
+  {
+    const double *a_data = a.data();
+    const double *b_data = b.data();
+    double *x_data = x.mutable_data();
+    py::gil_scoped_release release;
+    peigen::batched_solve(a_data, b_data, batch, static_cast<int>(n), nrhs, positive_definite, x_data);
+  }
+  return x;
+}
+
 static double core_eigh_compute(const py::array_t<double, py::array::forcecast> &a, bool lower,
                                 const std::string &method) {
   const ColMatrix m = dense_col_for_factorization(a, "a");
@@ -656,7 +510,7 @@ static double core_eigh_compute(const py::array_t<double, py::array::forcecast>
     throw py::value_error("eigh requires square matrix");
   }
 
-  const EighFactors factors = compute_eigh(m, lower, false, method);
+  const EighFactors factors = peigen::compute_eigh(m, lower, false, method);
   return factors.w.sum();
 }
 
@@ -670,23 +524,128 @@ class SparseFactorized {
     }
   }
 
+  // Factors an already reordered matrix a = A[row_perm][:, col_perm] as is (no COLAMD on
+  // top) and maps right-hand sides and solutions through the permutations in solve_into.
+  // An empty row_perm means the rows were not permuted.
+  SparseFactorized(const Sparse &a, std::vector<int> row_perm, std::vector<int> col_perm)
+      : natural_lu_(std::make_unique<Eigen::SparseLU<Sparse, Eigen::NaturalOrdering<int>>>()),
+        row_perm_(std::move(row_perm)),
+        col_perm_(std::move(col_perm)) {
+    natural_lu_->analyzePattern(a);
+    natural_lu_->factorize(a);
+    if (natural_lu_->info() != Eigen::Success) {
+      throw std::runtime_error("sparse factorization failed");
+    }
+  }
+
+  // Mixed precision: float SparseLU refined in double (see peigen::MixedSparseLU).
+  explicit SparseFactorized(std::unique_ptr<peigen::MixedSparseLU> mixed) : mixed_(std::move(mixed)) {}
+
   py::array_t<double> solve(const py::array_t<double, py::array::forcecast> &b) const {
     std::unique_ptr<RowMatrix> owned_b;
     const Eigen::Ref<const RowMatrix> rhs = dense_row_ref(b, "b", owned_b);
-    if (rhs.rows() != lu_->rows()) {
+    py::array_t<double> out_arr = make_output_array(rhs.rows(), rhs.cols());
+    solve_into(rhs, Eigen::Map<RowMatrix>(out_arr.mutable_data(), rhs.rows(), rhs.cols()));
+    return out_arr;
+  }
+
+  // Mixed-precision solve of a single column; returns (x, stats) for sparse.solve_stats.
+  py::tuple solve_stats(const py::array_t<double, py::array::forcecast> &b) const {
+    if (!mixed_) {
+      throw py::value_error("solve_stats requires a mixed-precision factorization");
+    }
+    std::unique_ptr<RowMatrix> owned_b;
+    const Eigen::Ref<const RowMatrix> rhs = dense_row_ref(b, "b", owned_b);
+    if (rhs.rows() != mixed_->rows() || rhs.cols() != 1) {
       throw py::value_error("factorized matrix and rhs shape mismatch");
     }
+    py::array_t<double> out_arr = make_output_array(rhs.rows(), 1);
+    peigen::RefinementInfo info;
+    solve_into(rhs, Eigen::Map<RowMatrix>(out_arr.mutable_data(), rhs.rows(), 1), &info);
+    return py::make_tuple(std::move(out_arr), refinement_stats(info));
+  }
+
+  // GIL-free solve used by both the synchronous binding and async tasks. `summary`, when
+  // given, receives the refinement outcome aggregated over the columns (mixed mode only).
+  void solve_into(const Eigen::Ref<const RowMatrix> &rhs, Eigen::Map<RowMatrix> out,
+                  peigen::RefinementInfo *summary = nullptr) const {
+    if (mixed_) {
+      if (rhs.rows() != mixed_->rows()) {
+        throw std::invalid_argument("factorized matrix and rhs shape mismatch");
+      }
+      Eigen::VectorXd x(rhs.rows());
+      for (Eigen::Index col = 0; col < rhs.cols(); ++col) {
+        const peigen::RefinementInfo info = mixed_->solve(rhs.col(col), x);
+        out.col(col) = x;
+        record(info);
+        if (summary != nullptr) {
+          summary->iterations = std::max(summary->iterations, info.iterations);
+          summary->backward_error = std::max(summary->backward_error, info.backward_error);
+          summary->fallback = summary->fallback || info.fallback;
+        }
+      }
+      return;
+    }
+    if (!natural_lu_) {
+      if (rhs.rows() != lu_->rows()) {
+        throw std::invalid_argument("factorized matrix and rhs shape mismatch");
+      }
+      for (Eigen::Index col = 0; col < rhs.cols(); ++col) {
+        out.col(col) = lu_->solve(rhs.col(col));
+      }
+      return;
+    }
 
-    py::array_t<double> out_arr = make_output_array(rhs.rows(), rhs.cols());
-    Eigen::Map<RowMatrix> out(out_arr.mutable_data(), rhs.rows(), rhs.cols());
-    for (int col = 0; col < rhs.cols(); ++col) {
-      out.col(col) = lu_->solve(rhs.col(col));
+    const Eigen::Index n = natural_lu_->rows();
+    if (rhs.rows() != n) {
+      throw std::invalid_argument("factorized matrix and rhs shape mismatch");
+    }
+    Eigen::VectorXd permuted_rhs(n);
+    Eigen::VectorXd permuted_x(n);
+    for (Eigen::Index col = 0; col < rhs.cols(); ++col) {
+      for (Eigen::Index k = 0; k < n; ++k) {
+        permuted_rhs[k] = rhs(row_perm_.empty() ? k : row_perm_[k], col);
+      }
+      permuted_x = natural_lu_->solve(permuted_rhs);
+      for (Eigen::Index k = 0; k < n; ++k) {
+        out(col_perm_[k], col) = permuted_x[k];
+      }
     }
-    return out_arr;
+  }
+
+  // Refinement counters accumulated over all mixed-precision solves so far.
+  py::dict stats() const {
+    py::dict out;
+    out["precision"] = mixed_ ? "mixed" : "double";
+    out["single_precision"] = mixed_ && mixed_->single_precision();
+    out["solves"] = solves_.load();
+    out["iterations"] = iterations_.load();
+    out["max_iterations"] = max_iterations_.load();
+    out["fallbacks"] = fallbacks_.load();
+    return out;
   }
 
  private:
+  void record(const peigen::RefinementInfo &info) const {
+    ++solves_;
+    iterations_ += info.iterations;
+    if (info.fallback) {
+      ++fallbacks_;
+    }
+    int seen = max_iterations_.load();
+    while (info.iterations > seen && !max_iterations_.compare_exchange_weak(seen, info.iterations)) {
+    }
+  }
+
   std::unique_ptr<Eigen::SparseLU<Sparse>> lu_;
+  std::unique_ptr<Eigen::SparseLU<Sparse, Eigen::NaturalOrdering<int>>> natural_lu_;
+  std::unique_ptr<peigen::MixedSparseLU> mixed_;
+  std::vector<int> row_perm_;
+  std::vector<int> col_perm_;
+  mutable std::atomic<long long> solves_{0};
+  mutable std::atomic<long long> iterations_{0};
+  mutable std::atomic<int> max_iterations_{0};
+  mutable std::atomic<long long> fallbacks_{0};
 };
 
 static py::array_t<double> core_spmm(py::object a, const py::array_t<double, py::array::forcecast> &b) {
@@ -698,172 +657,146 @@ static py::array_t<double> core_spmm(py::object a, const py::array_t<double, py:
     throw py::value_error("spmm dimension mismatch");
   }
 
-  return assign_to_output(sparse.mat * rhs);
+  py::array_t<double> out_arr = make_output_array(sparse.mat.rows(), rhs.cols());
+  peigen::spmm(sparse.mat, rhs.data(), rhs.cols(), out_arr.mutable_data());
+  return out_arr;
 }
 
-static py::object core_spspmm(py::object a, py::object b) {
-  SparseCscView sparse_a = map_sparse_csc(a, true);
-  SparseCscView sparse_b = map_sparse_csc(b, true);
-
-  if (sparse_a.mat.cols() != sparse_b.mat.rows()) {
-    throw py::value_error("spspmm dimension mismatch");
-  }
-
-  Sparse out = (sparse_a.mat * sparse_b.mat).pruned();
-  out.makeCompressed();
-  return to_scipy_csc(out);
+static bool buffers_overlap(const void *a, py::ssize_t a_bytes, const void *b, py::ssize_t b_bytes) {
+  const char *pa = static_cast<const char *>(a);
+  const char *pb = static_cast<const char *>(b);
+  return pa < pb + b_bytes && pb < pa + a_bytes;
 }
 
-template <typename Preconditioner>
-static void run_conjugate_gradient(const Sparse &mat,
-                                   const Eigen::Ref<const RowMatrix> &rhs,
-                                   Eigen::Map<RowMatrix> &out,
-                                   double effective_tol,
-                                   int effective_maxiter) {
-  Eigen::ConjugateGradient<Sparse, Eigen::Lower | Eigen::Upper, Preconditioner> cg;
-  cg.setTolerance(effective_tol);
-  cg.setMaxIterations(effective_maxiter);
-  cg.compute(mat);
-  if (cg.info() != Eigen::Success) {
-    throw std::runtime_error("ConjugateGradient setup failed");
-  }
-  for (int col = 0; col < rhs.cols(); ++col) {
-    out.col(col) = cg.solve(rhs.col(col));
-    if (cg.info() != Eigen::Success) {
-      throw std::runtime_error(
-          "ConjugateGradient did not converge (iters=" + std::to_string(cg.iterations()) +
-          ", error=" + std::to_string(cg.error()) + ")");
-    }
+// out = alpha * op(a) @ b + beta * out. Without `out` a new array is returned and beta must be 0.
+static py::array core_spmm_axpby(py::object a,
+                                 const py::array_t<double, py::array::c_style | py::array::forcecast> &b,
+                                 py::object out,
+                                 bool transpose,
+                                 double alpha,
+                                 double beta) {
+  SparseCscView sparse = map_sparse_csc(a, true);
+  if (b.ndim() != 1 && b.ndim() != 2) {
+    throw py::value_error("b must be a 1D or 2D array");
+  }
+  const Eigen::Index in_rows = transpose ? sparse.mat.rows() : sparse.mat.cols();
+  const Eigen::Index out_rows = transpose ? sparse.mat.cols() : sparse.mat.rows();
+  const Eigen::Index k = b.ndim() == 1 ? 1 : b.shape(1);
+  if (b.shape(0) != in_rows) {
+    throw py::value_error("spmm dimension mismatch");
   }
-}
 
-template <typename Preconditioner>
-static std::pair<int, double> conjugate_gradient_stats(const Sparse &mat,
-                                                       const Eigen::VectorXd &rhs,
-                                                       double effective_tol,
-                                                       int effective_maxiter) {
-  Eigen::ConjugateGradient<Sparse, Eigen::Lower | Eigen::Upper, Preconditioner> cg;
-  cg.setTolerance(effective_tol);
-  cg.setMaxIterations(effective_maxiter);
-  cg.compute(mat);
-  if (cg.info() != Eigen::Success) {
-    throw std::runtime_error("ConjugateGradient setup failed");
-  }
-  Eigen::VectorXd x = cg.solve(rhs);
-  if (cg.info() != Eigen::Success) {
-    throw std::runtime_error(
-        "ConjugateGradient did not converge (iters=" + std::to_string(cg.iterations()) +
-        ", error=" + std::to_string(cg.error()) + ")");
-  }
-  (void)x;
-  return {static_cast<int>(cg.iterations()), cg.error()};
-}
-
-static void run_conjugate_gradient_ilu(const Sparse &mat,
-                                       const Eigen::Ref<const RowMatrix> &rhs,
-                                       Eigen::Map<RowMatrix> &out,
-                                       double effective_tol,
-                                       int effective_maxiter,
-                                       int ilu_fill_factor,
-                                       double ilu_drop_tol) {
-  Eigen::ConjugateGradient<Sparse, Eigen::Lower | Eigen::Upper, Eigen::IncompleteLUT<double> > cg;
-  cg.preconditioner().setFillfactor(ilu_fill_factor);
-  cg.preconditioner().setDroptol(ilu_drop_tol);
-  cg.setTolerance(effective_tol);
-  cg.setMaxIterations(effective_maxiter);
-  cg.compute(mat);
-  if (cg.info() != Eigen::Success) {
-    throw std::runtime_error("ConjugateGradient setup failed");
-  }
-  for (int col = 0; col < rhs.cols(); ++col) {
-    out.col(col) = cg.solve(rhs.col(col));
-    if (cg.info() != Eigen::Success) {
-      throw std::runtime_error(
-          "ConjugateGradient did not converge (iters=" + std::to_string(cg.iterations()) +
-          ", error=" + std::to_string(cg.error()) + ")");
+  py::array result;
+  if (out.is_none()) {
+    if (beta != 0.0) {
+      throw py::value_error("beta requires an out array to accumulate into");
+    }
+    result = b.ndim() == 1 ? py::array_t<double>(out_rows) : make_output_array(out_rows, k);
+  } else {
+    if (!py::isinstance<py::array>(out)) {
+      throw py::value_error("out must be a NumPy array");
+    }
+    result = out.cast<py::array>();
+    if (!result.dtype().is(py::dtype::of<double>()) || !(result.flags() & py::array::c_style)) {
+      throw py::value_error("out must be a C-contiguous float64 array");
+    }
+    if (result.ndim() != b.ndim() || result.shape(0) != out_rows || (b.ndim() == 2 && result.shape(1) != k)) {
+      throw py::value_error("out has the wrong shape");
+    }
+    if (!result.writeable()) {
+      throw py::value_error("out is read-only");
+    }
+    if (buffers_overlap(result.data(), result.nbytes(), b.data(), b.nbytes())) {
+      throw py::value_error("out must not overlap b");
     }
   }
+
+  peigen::spmm_axpby(sparse.mat, transpose, alpha, b.data(), k, beta, static_cast<double *>(result.mutable_data()));
+  return result;
 }
 
-static std::pair<int, double> conjugate_gradient_ilu_stats(const Sparse &mat,
-                                                           const Eigen::VectorXd &rhs,
-                                                           double effective_tol,
-                                                           int effective_maxiter,
-                                                           int ilu_fill_factor,
-                                                           double ilu_drop_tol) {
-  Eigen::ConjugateGradient<Sparse, Eigen::Lower | Eigen::Upper, Eigen::IncompleteLUT<double> > cg;
-  cg.preconditioner().setFillfactor(ilu_fill_factor);
-  cg.preconditioner().setDroptol(ilu_drop_tol);
-  cg.setTolerance(effective_tol);
-  cg.setMaxIterations(effective_maxiter);
-  cg.compute(mat);
-  if (cg.info() != Eigen::Success) {
-    throw std::runtime_error("ConjugateGradient setup failed");
+static py::array core_normal_spmm(py::object a,
+                                  const py::array_t<double, py::array::c_style | py::array::forcecast> &b) {
+  SparseCscView sparse = map_sparse_csc(a, true);
+  if (b.ndim() != 1 && b.ndim() != 2) {
+    throw py::value_error("b must be a 1D or 2D array");
   }
-  Eigen::VectorXd x = cg.solve(rhs);
-  if (cg.info() != Eigen::Success) {
-    throw std::runtime_error(
-        "ConjugateGradient did not converge (iters=" + std::to_string(cg.iterations()) +
-        ", error=" + std::to_string(cg.error()) + ")");
+  if (b.shape(0) != sparse.mat.cols()) {
+    throw py::value_error("normal_matmul dimension mismatch");
   }
-  (void)x;
-  return {static_cast<int>(cg.iterations()), cg.error()};
+  const Eigen::Index k = b.ndim() == 1 ? 1 : b.shape(1);
+  py::array_t<double> out =
+      b.ndim() == 1 ? py::array_t<double>(sparse.mat.cols()) : make_output_array(sparse.mat.cols(), k);
+  peigen::normal_spmm(sparse.mat, b.data(), k, out.mutable_data());
+  return out;
 }
 
-static void dispatch_conjugate_gradient(const Sparse &mat,
-                                        const Eigen::Ref<const RowMatrix> &rhs,
-                                        Eigen::Map<RowMatrix> &out,
-                                        const std::string &preconditioner,
-                                        double effective_tol,
-                                        int effective_maxiter,
-                                        int ilu_fill_factor,
-                                        double ilu_drop_tol) {
-  if (preconditioner == "none") {
-    run_conjugate_gradient<Eigen::IdentityPreconditioner>(mat, rhs, out, effective_tol,
-                                                          effective_maxiter);
-  } else if (preconditioner == "jacobi") {
-    run_conjugate_gradient<Eigen::DiagonalPreconditioner<double> >(mat, rhs, out, effective_tol,
-                                                                   effective_maxiter);
-  } else if (preconditioner == "ilu") {
-    if (ilu_fill_factor <= 0) {
-      throw py::value_error("ilu_fill_factor must be positive when preconditioner='ilu'");
-    }
-    if (ilu_drop_tol < 0.0) {
-      throw py::value_error("ilu_drop_tol must be non-negative when preconditioner='ilu'");
-    }
-    run_conjugate_gradient_ilu(mat, rhs, out, effective_tol, effective_maxiter, ilu_fill_factor,
-                               ilu_drop_tol);
-  } else {
-    throw py::value_error("preconditioner must be one of: none, jacobi, ilu");
+static py::object core_sddmm(py::object a,
+                             const py::array_t<double, py::array::c_style | py::array::forcecast> &x,
+                             const py::array_t<double, py::array::c_style | py::array::forcecast> &y) {
+  SparseCscView sparse = map_sparse_csc(a, true);
+  validate_2d(x, "x");
+  validate_2d(y, "y");
+  if (x.shape(0) != sparse.mat.rows() || y.shape(0) != sparse.mat.cols() || x.shape(1) != y.shape(1)) {
+    throw py::value_error("sddmm requires x of shape (rows, k) and y of shape (cols, k)");
+  }
+  std::vector<double> values(static_cast<std::size_t>(sparse.mat.nonZeros()));
+  peigen::sddmm(sparse.mat, x.data(), y.data(), x.shape(1), values.data());
+  return make_scipy_compressed("csc_matrix", sparse.mat.rows(), sparse.mat.cols(), sparse.mat.outerIndexPtr(),
+                               sparse.mat.outerSize(), sparse.mat.innerIndexPtr(), values.data(),
+                               sparse.mat.nonZeros());
+}
+
+static py::object core_spspmm(py::object a, py::object b) {
+  SparseCscView sparse_a = map_sparse_csc(a, true);
+  SparseCscView sparse_b = map_sparse_csc(b, true);
+
+  if (sparse_a.mat.cols() != sparse_b.mat.rows()) {
+    throw py::value_error("spspmm dimension mismatch");
   }
+
+  Sparse out = (sparse_a.mat * sparse_b.mat).pruned();
+  out.makeCompressed();
+  return to_scipy_csc(out);
 }
 
-static std::pair<int, double> dispatch_conjugate_gradient_stats(const Sparse &mat,
-                                                                const Eigen::VectorXd &rhs,
-                                                                const std::string &preconditioner,
-                                                                double effective_tol,
-                                                                int effective_maxiter,
-                                                                int ilu_fill_factor,
-                                                                double ilu_drop_tol) {
-  if (preconditioner == "none") {
-    return conjugate_gradient_stats<Eigen::IdentityPreconditioner>(mat, rhs, effective_tol,
-                                                                 effective_maxiter);
+// GIL-free part of sparse.solve, shared with the async path.
+static void sparse_solve_into(const Eigen::Map<const Sparse> &mat,
+                              const Eigen::Ref<const RowMatrix> &rhs,
+                              Eigen::Map<RowMatrix> out,
+                              const std::string &method,
+                              double tol,
+                              int maxiter,
+                              const std::string &preconditioner,
+                              int ilu_fill_factor,
+                              double ilu_drop_tol) {
+  if (mat.rows() != mat.cols()) {
+    throw std::invalid_argument("sparse solve requires square matrix");
   }
-  if (preconditioner == "jacobi") {
-    return conjugate_gradient_stats<Eigen::DiagonalPreconditioner<double> >(mat, rhs, effective_tol,
-                                                                           effective_maxiter);
+  if (mat.rows() != rhs.rows()) {
+    throw std::invalid_argument("sparse solve shape mismatch");
   }
-  if (preconditioner == "ilu") {
-    if (ilu_fill_factor <= 0) {
-      throw py::value_error("ilu_fill_factor must be positive when preconditioner='ilu'");
-    }
-    if (ilu_drop_tol < 0.0) {
-      throw py::value_error("ilu_drop_tol must be non-negative when preconditioner='ilu'");
-    }
-    return conjugate_gradient_ilu_stats(mat, rhs, effective_tol, effective_maxiter, ilu_fill_factor,
-                                        ilu_drop_tol);
+
+  const int effective_maxiter = maxiter > 0 ? maxiter : static_cast<int>(mat.rows() * 2);
+  const double effective_tol = tol > 0.0 ? tol : 1e-8;
+
+  if (method != "cg" && preconditioner != "none") {
+    throw std::invalid_argument("preconditioner is only supported for method='cg'");
   }
-  throw py::value_error("preconditioner must be one of: none, jacobi, ilu");
+
+  if (method == "auto" || method == "lu") {
+    peigen::sparse_lu_solve(mat, rhs, out);
+    return;
+  }
+
+  if (method == "cg" || method == "bicgstab") {
+    const peigen_iterative_params params = peigen::resolve_iterative_params(
+        method, preconditioner, effective_tol, effective_maxiter, ilu_fill_factor, ilu_drop_tol);
+    peigen::run_iterative_kernel(mat, rhs.data(), rhs.cols(), out.data(), params);
+    return;
+  }
+
+  throw std::invalid_argument("method must be one of: auto, lu, cg, bicgstab");
 }
 
 static py::array_t<double> core_sparse_solve(py::object a,
@@ -878,65 +811,10 @@ static py::array_t<double> core_sparse_solve(py::object a,
   std::unique_ptr<RowMatrix> owned_b;
   const Eigen::Ref<const RowMatrix> rhs = dense_row_ref(b, "b", owned_b);
 
-  if (sparse.mat.rows() != sparse.mat.cols()) {
-    throw py::value_error("sparse solve requires square matrix");
-  }
-  if (sparse.mat.rows() != rhs.rows()) {
-    throw py::value_error("sparse solve shape mismatch");
-  }
-
   py::array_t<double> out_arr = make_output_array(rhs.rows(), rhs.cols());
-  Eigen::Map<RowMatrix> out(out_arr.mutable_data(), rhs.rows(), rhs.cols());
-
-  const int effective_maxiter = maxiter > 0 ? maxiter : static_cast<int>(sparse.mat.rows() * 2);
-  const double effective_tol = tol > 0.0 ? tol : 1e-8;
-
-  if (method != "cg" && preconditioner != "none") {
-    throw py::value_error("preconditioner is only supported for method='cg'");
-  }
-
-  if (method == "auto" || method == "lu") {
-    Eigen::SparseLU<Sparse> lu;
-    lu.analyzePattern(sparse.mat);
-    lu.factorize(sparse.mat);
-    if (lu.info() != Eigen::Success) {
-      throw std::runtime_error("SparseLU factorization failed");
-    }
-    for (int col = 0; col < rhs.cols(); ++col) {
-      out.col(col) = lu.solve(rhs.col(col));
-      if (lu.info() != Eigen::Success) {
-        throw std::runtime_error("SparseLU solve failed");
-      }
-    }
-    return out_arr;
-  }
-
-  if (method == "cg") {
-    dispatch_conjugate_gradient(sparse.mat, rhs, out, preconditioner, effective_tol, effective_maxiter,
-                                ilu_fill_factor, ilu_drop_tol);
-    return out_arr;
-  }
-
-  if (method == "bicgstab") {
-    Eigen::BiCGSTAB<Sparse> solver;
-    solver.setTolerance(effective_tol);
-    solver.setMaxIterations(effective_maxiter);
-    solver.compute(sparse.mat);
-    if (solver.info() != Eigen::Success) {
-      throw std::runtime_error("BiCGSTAB setup failed");
-    }
-    for (int col = 0; col < rhs.cols(); ++col) {
-      out.col(col) = solver.solve(rhs.col(col));
-      if (solver.info() != Eigen::Success) {
-        throw std::runtime_error(
-            "BiCGSTAB did not converge (iters=" + std::to_string(solver.iterations()) +
-            ", error=" + std::to_string(solver.error()) + ")");
-      }
-    }
-    return out_arr;
-  }
-
-  throw py::value_error("method must be one of: auto, lu, cg, bicgstab");
+  sparse_solve_into(sparse.mat, rhs, Eigen::Map<RowMatrix>(out_arr.mutable_data(), rhs.rows(), rhs.cols()), method,
+                    tol, maxiter, preconditioner, ilu_fill_factor, ilu_drop_tol);
+  return out_arr;
 }
 
 static py::dict core_sparse_solve_stats(py::object a,
@@ -968,22 +846,961 @@ static py::dict core_sparse_solve_stats(py::object a,
   const int effective_maxiter = maxiter > 0 ? maxiter : static_cast<int>(sparse.mat.rows() * 2);
   const double effective_tol = tol > 0.0 ? tol : 1e-8;
 
-  const auto stats = dispatch_conjugate_gradient_stats(
-      sparse.mat, rhs.col(0), preconditioner, effective_tol, effective_maxiter, ilu_fill_factor,
-      ilu_drop_tol);
+  const peigen_iterative_params params = peigen::resolve_iterative_params(
+      method, preconditioner, effective_tol, effective_maxiter, ilu_fill_factor, ilu_drop_tol);
+  Eigen::VectorXd x(rhs.rows());
+  const peigen_iterative_result stats = peigen::run_iterative_kernel(sparse.mat, rhs.data(), 1, x.data(), params);
 
   py::dict out;
-  out["iterations"] = stats.first;
-  out["error"] = stats.second;
+  out["iterations"] = stats.iterations;
+  out["error"] = stats.error;
   return out;
 }
 
-static std::shared_ptr<SparseFactorized> core_sparse_factorize(py::object a) {
+static std::shared_ptr<SparseFactorized> make_sparse_factorized(const Sparse &mat, const std::string &precision) {
+  if (mat.rows() != mat.cols()) {
+    throw py::value_error("factorize requires square sparse matrix");
+  }
+  if (precision == "mixed") {
+    return std::make_shared<SparseFactorized>(std::make_unique<peigen::MixedSparseLU>(mat));
+  }
+  if (precision != "double") {
+    throw py::value_error("precision must be 'double' or 'mixed'");
+  }
+  return std::make_shared<SparseFactorized>(mat);
+}
+
+static std::shared_ptr<SparseFactorized> core_sparse_factorize(py::object a, const std::string &precision) {
+  if (py::isinstance<SparseHandle>(a)) {
+    return make_sparse_factorized(a.cast<const SparseHandle &>().csc(), precision);
+  }
   SparseCscView sparse = map_sparse_csc(a, true);
+  return make_sparse_factorized(Sparse(sparse.mat), precision);
+}
+
+// b (rows,) or (rows, k) -> x (cols,) or (cols, k); the QR factors are shared read-only.
+static py::array sparse_qr_solve(const peigen::SparseLeastSquaresQR &qr,
+                                 const py::array_t<double, py::array::c_style | py::array::forcecast> &b) {
+  if (b.ndim() != 1 && b.ndim() != 2) {
+    throw py::value_error("b must be a 1D or 2D array");
+  }
+  if (b.shape(0) != qr.rows()) {
+    throw py::value_error("factorized matrix and rhs shape mismatch");
+  }
+  const Eigen::Index k = b.ndim() == 1 ? 1 : b.shape(1);
+  py::array_t<double> out = b.ndim() == 1 ? py::array_t<double>(qr.cols()) : make_output_array(qr.cols(), k);
+  qr.solve(Eigen::Map<const RowMatrix>(b.data(), qr.rows(), k),
+           Eigen::Map<RowMatrix>(out.mutable_data(), qr.cols(), k));
+  return out;
+}
+
+static std::shared_ptr<peigen::SparseLeastSquaresQR> core_sparse_factorize_qr(py::object a, double pivot_threshold) {
+  if (py::isinstance<SparseHandle>(a)) {
+    return std::make_shared<peigen::SparseLeastSquaresQR>(a.cast<const SparseHandle &>().csc(), pivot_threshold);
+  }
+  const SparseCscView sparse = map_sparse_csc(std::move(a), true);
+  return std::make_shared<peigen::SparseLeastSquaresQR>(Sparse(sparse.mat), pivot_threshold);
+}
+
+static py::array core_sparse_lstsq(py::object a,
+                                   const py::array_t<double, py::array::c_style | py::array::forcecast> &b,
+                                   const std::string &method,
+                                   double tol,
+                                   int maxiter,
+                                   double pivot_threshold) {
+  if (method == "qr") {
+    return sparse_qr_solve(*core_sparse_factorize_qr(std::move(a), pivot_threshold), b);
+  }
+  if (method != "lscg") {
+    throw py::value_error("method must be one of: qr, lscg");
+  }
+  const SparseCscView sparse = map_sparse_csc(std::move(a), true);
+  if (b.ndim() != 1 && b.ndim() != 2) {
+    throw py::value_error("b must be a 1D or 2D array");
+  }
+  if (b.shape(0) != sparse.mat.rows()) {
+    throw py::value_error("lstsq shape mismatch");
+  }
+  const Eigen::Index cols = sparse.mat.cols();
+  const Eigen::Index k = b.ndim() == 1 ? 1 : b.shape(1);
+  py::array_t<double> out = b.ndim() == 1 ? py::array_t<double>(cols) : make_output_array(cols, k);
+  const int effective_maxiter = maxiter > 0 ? maxiter : static_cast<int>(cols * 2);
+  const double effective_tol = tol > 0.0 ? tol : 1e-8;
+  peigen::sparse_lscg_solve(sparse.mat, Eigen::Map<const RowMatrix>(b.data(), sparse.mat.rows(), k),
+                            Eigen::Map<RowMatrix>(out.mutable_data(), cols, k), effective_tol, effective_maxiter);
+  return out;
+}
+
+static std::vector<int> permutation_vector(const py::object &perm) {
+  if (perm.is_none()) {
+    return {};
+  }
+  const auto arr = perm.cast<py::array_t<int, py::array::c_style | py::array::forcecast>>();
+  if (arr.ndim() != 1) {
+    throw py::value_error("permutation must be a 1D array");
+  }
+  return std::vector<int>(arr.data(), arr.data() + arr.size());
+}
+
+static py::array_t<int> core_sparse_ordering(py::object a, const std::string &method) {
+  const SparseCscView sparse = map_sparse_csc(std::move(a), true);
+  const std::vector<int> perm = peigen::sparse_ordering(sparse.mat, method);
+  py::array_t<int> out(static_cast<py::ssize_t>(perm.size()));
+  std::copy(perm.begin(), perm.end(), out.mutable_data());
+  return out;
+}
+
+// A[row_perm][:, col_perm] as a new handle; None leaves that side in place.
+static std::shared_ptr<SparseHandle> core_sparse_permute(py::object a, const py::object &row_perm,
+                                                         const py::object &col_perm) {
+  const SparseCscView sparse = map_sparse_csc(std::move(a), true);
+  return std::make_shared<SparseHandle>(
+      peigen::permute_sparse(sparse.mat, permutation_vector(row_perm), permutation_vector(col_perm)));
+}
+
+// `a` is the reordered matrix; the permutations map the caller's vectors onto it.
+static std::shared_ptr<SparseFactorized> core_sparse_factorize_permuted(py::object a, const py::object &row_perm,
+                                                                        const py::object &col_perm) {
+  const SparseCscView sparse = map_sparse_csc(std::move(a), true);
   if (sparse.mat.rows() != sparse.mat.cols()) {
     throw py::value_error("factorize requires square sparse matrix");
   }
-  return std::make_shared<SparseFactorized>(sparse.mat);
+  std::vector<int> rows = permutation_vector(row_perm);
+  std::vector<int> cols = permutation_vector(col_perm);
+  if (!rows.empty()) {
+    peigen::validate_permutation(rows, sparse.mat.rows());
+  }
+  peigen::validate_permutation(cols, sparse.mat.cols());
+  return std::make_shared<SparseFactorized>(Sparse(sparse.mat), std::move(rows), std::move(cols));
+}
+
+static std::shared_ptr<SparseHandle> core_sparse_handle(py::object a) {
+  const SparseCscView sparse = map_sparse_csc(std::move(a), true);
+  return std::make_shared<SparseHandle>(Sparse(sparse.mat));
+}
+
+static py::object sparse_handle_to_scipy(const SparseHandle &handle, const std::string &format) {
+  if (format == "csc") {
+    return to_scipy_csc(handle.csc());
+  }
+  if (format == "csr") {
+    const Eigen::Map<const RowSparse> csr = handle.csr();
+    return make_scipy_compressed("csr_matrix", csr.rows(), csr.cols(), csr.outerIndexPtr(), csr.outerSize(),
+                                 csr.innerIndexPtr(), csr.valuePtr(), csr.nonZeros());
+  }
+  throw py::value_error("format must be 'csc' or 'csr'");
+}
+
+static py::array_t<double> sparse_handle_matmul(const SparseHandle &handle,
+                                                const py::array_t<double, py::array::forcecast> &b) {
+  if (b.ndim() == 1) {
+    if (b.shape(0) != handle.csc().cols()) {
+      throw py::value_error("spmm dimension mismatch");
+    }
+    const auto x = b.unchecked<1>();
+    Eigen::VectorXd rhs(b.shape(0));
+    for (py::ssize_t i = 0; i < b.shape(0); ++i) {
+      rhs[i] = x(i);
+    }
+    return vector_to_numpy(handle.csc() * rhs);
+  }
+  std::unique_ptr<RowMatrix> owned_b;
+  const Eigen::Ref<const RowMatrix> rhs = dense_row_ref(b, "b", owned_b);
+  if (handle.csc().cols() != rhs.rows()) {
+    throw py::value_error("spmm dimension mismatch");
+  }
+  py::array_t<double> out_arr = make_output_array(handle.csc().rows(), rhs.cols());
+  peigen::spmm(handle.map(), rhs.data(), rhs.cols(), out_arr.mutable_data());
+  return out_arr;
+}
+
+static void validate_coo_indices(const py::array &row, const py::array &col) {
+  if (row.ndim() != 1 || col.ndim() != 1) {
+    throw py::value_error("row and col must be 1D arrays");
+  }
+  if (row.size() != col.size()) {
+    throw py::value_error("row and col must have the same length");
+  }
+}
+
+static py::object core_coo_to_csc(const py::array_t<double, py::array::c_style | py::array::forcecast> &data,
+                                  const py::array_t<int, py::array::c_style | py::array::forcecast> &row,
+                                  const py::array_t<int, py::array::c_style | py::array::forcecast> &col,
+                                  Eigen::Index rows,
+                                  Eigen::Index cols) {
+  validate_coo_indices(row, col);
+  if (data.ndim() != 1 || data.size() != row.size()) {
+    throw py::value_error("data must be a 1D array with the same length as row and col");
+  }
+  return to_scipy_csc(peigen::assemble_coo(rows, cols, row.data(), col.data(), data.data(), row.size()));
+}
+
+// Index arrays for SparseMatrix.from_coo: any integer dtype, narrowed to the 32-bit storage
+// index. Bounds against the shape are checked by assemble_coo.
+static std::vector<int> coo_index_vector(const py::array &arr, const char *name) {
+  if (arr.ndim() != 1) {
+    throw py::value_error(std::string(name) + " must be a 1D array");
+  }
+  if (arr.size() > 0 && arr.dtype().kind() != 'i' && arr.dtype().kind() != 'u') {
+    throw py::value_error(std::string(name) + " must contain integers");
+  }
+  const auto wide = py::array_t<long long, py::array::c_style | py::array::forcecast>::ensure(arr);
+  std::vector<int> out(static_cast<std::size_t>(wide.size()));
+  const long long *src = wide.data();
+  for (std::size_t i = 0; i < out.size(); ++i) {
+    if (src[i] < 0 || src[i] > std::numeric_limits<int>::max()) {
+      throw py::value_error(std::string(name) + " index out of bounds");
+    }
+    out[i] = static_cast<int>(src[i]);
+  }
+  return out;
+}
+
+static std::shared_ptr<SparseHandle> core_sparse_handle_from_coo(
+    const py::array_t<double, py::array::c_style | py::array::forcecast> &data,
+    const py::array &row,
+    const py::array &col,
+    const py::tuple &shape) {
+  if (shape.size() != 2) {
+    throw py::value_error("shape must be a (rows, cols) tuple");
+  }
+  const std::vector<int> row_idx = coo_index_vector(row, "row");
+  const std::vector<int> col_idx = coo_index_vector(col, "col");
+  if (row_idx.size() != col_idx.size()) {
+    throw py::value_error("row and col must have the same length");
+  }
+  if (data.ndim() != 1 || data.size() != static_cast<py::ssize_t>(row_idx.size())) {
+    throw py::value_error("data must be a 1D array with the same length as row and col");
+  }
+  return std::make_shared<SparseHandle>(peigen::assemble_coo(shape[0].cast<Eigen::Index>(),
+                                                             shape[1].cast<Eigen::Index>(), row_idx.data(),
+                                                             col_idx.data(), data.data(), data.size()));
+}
+
+static std::shared_ptr<peigen::CooPattern> core_coo_pattern(
+    const py::array_t<int, py::array::c_style | py::array::forcecast> &row,
+    const py::array_t<int, py::array::c_style | py::array::forcecast> &col,
+    Eigen::Index rows,
+    Eigen::Index cols) {
+  validate_coo_indices(row, col);
+  return std::make_shared<peigen::CooPattern>(rows, cols, row.data(), col.data(), row.size());
+}
+
+static const double *coo_pattern_values(const peigen::CooPattern &pattern,
+                                        const py::array_t<double, py::array::c_style | py::array::forcecast> &data) {
+  if (data.ndim() != 1 || data.size() != pattern.triplets()) {
+    throw py::value_error("data must be a 1D array with one value per pattern triplet");
+  }
+  return data.data();
+}
+
+static py::object coo_pattern_assemble(const peigen::CooPattern &pattern,
+                                       const py::array_t<double, py::array::c_style | py::array::forcecast> &data) {
+  const double *values = coo_pattern_values(pattern, data);
+  py::array_t<double> out_data(pattern.nnz());
+  py::array_t<int> out_indices(pattern.nnz());
+  py::array_t<int> out_indptr(pattern.cols() + 1);
+  pattern.assemble(values, out_data.mutable_data());
+  std::memcpy(out_indices.mutable_data(), pattern.inner().data(), sizeof(int) * pattern.inner().size());
+  std::memcpy(out_indptr.mutable_data(), pattern.outer().data(), sizeof(int) * pattern.outer().size());
+
+  py::module_ sparse_mod = py::module_::import("scipy.sparse");
+  py::tuple shape = py::make_tuple(pattern.rows(), pattern.cols());
+  py::tuple args = py::make_tuple(py::make_tuple(out_data, out_indices, out_indptr), shape);
+  return sparse_mod.attr("csc_matrix")(*args);
+}
+
+// Writes the assembled values into `values` (e.g. the .data array of a matrix returned by
+// assemble()) without allocating.
+static void coo_pattern_assemble_into(const peigen::CooPattern &pattern,
+                                      const py::array_t<double, py::array::c_style | py::array::forcecast> &data,
+                                      py::array values) {
+  const double *input = coo_pattern_values(pattern, data);
+  if (!values.dtype().is(py::dtype::of<double>()) || values.ndim() != 1 || values.size() != pattern.nnz() ||
+      !(values.flags() & py::array::c_style)) {
+    throw py::value_error("out must be a contiguous float64 array with one value per stored entry");
+  }
+  if (!values.writeable()) {
+    throw py::value_error("out is read-only");
+  }
+  pattern.assemble(input, static_cast<double *>(values.mutable_data()));
+}
+
+static LinearOperatorPtr core_linop_sparse(py::object a) {
+  if (py::isinstance<SparseHandle>(a)) {
+    return peigen::make_sparse_operator(a.cast<std::shared_ptr<SparseHandle>>());
+  }
+  const SparseCscView sparse = map_sparse_csc(a, true);
+  return peigen::make_sparse_operator(Sparse(sparse.mat));
+}
+
+static LinearOperatorPtr core_linop_dense(const py::array_t<double, py::array::forcecast> &a) {
+  return peigen::make_dense_operator(dense_col_for_factorization(a, "a"));
+}
+
+static py::array_t<double> linop_apply(const LinearOperator &op,
+                                       const py::array_t<double, py::array::forcecast> &x,
+                                       bool transpose) {
+  const ColMatrix in = dense_col_for_factorization(x, "x");
+  const Eigen::Index in_rows = transpose ? op.rows() : op.cols();
+  const Eigen::Index out_rows = transpose ? op.cols() : op.rows();
+  if (in.rows() != in_rows) {
+    throw py::value_error("linear operator dimension mismatch");
+  }
+  ColMatrix out(out_rows, in.cols());
+  transpose ? op.apply_transpose(in, out) : op.apply(in, out);
+  return assign_to_output(out);
+}
+
+static py::array_t<double> core_operator_solve(const LinearOperator &op,
+                                               const py::array_t<double, py::array::forcecast> &b,
+                                               const std::string &method,
+                                               double tol,
+                                               int maxiter,
+                                               const std::string &preconditioner) {
+  if (method != "cg" && method != "bicgstab") {
+    throw py::value_error("linear operators require method='cg' or 'bicgstab'");
+  }
+  if (method != "cg" && preconditioner != "none") {
+    throw py::value_error("preconditioner is only supported for method='cg'");
+  }
+  std::unique_ptr<RowMatrix> owned_b;
+  const Eigen::Ref<const RowMatrix> rhs = dense_row_ref(b, "b", owned_b);
+
+  const int effective_maxiter = maxiter > 0 ? maxiter : static_cast<int>(op.rows() * 2);
+  const double effective_tol = tol > 0.0 ? tol : 1e-8;
+  const peigen_iterative_params params =
+      peigen::resolve_iterative_params(method, preconditioner, effective_tol, effective_maxiter, 10, 1e-4);
+
+  py::array_t<double> out_arr = make_output_array(rhs.rows(), rhs.cols());
+  peigen::operator_iterative_solve(op, rhs, Eigen::Map<RowMatrix>(out_arr.mutable_data(), rhs.rows(), rhs.cols()),
+                                   params);
+  return out_arr;
+}
+
+static py::dict core_operator_solve_stats(const LinearOperator &op,
+                                          const py::array_t<double, py::array::forcecast> &b,
+                                          double tol,
+                                          int maxiter,
+                                          const std::string &preconditioner) {
+  std::unique_ptr<RowMatrix> owned_b;
+  const Eigen::Ref<const RowMatrix> rhs = dense_row_ref(b, "b", owned_b);
+  if (rhs.cols() != 1) {
+    throw py::value_error("solve_stats requires a single RHS column");
+  }
+
+  const int effective_maxiter = maxiter > 0 ? maxiter : static_cast<int>(op.rows() * 2);
+  const double effective_tol = tol > 0.0 ? tol : 1e-8;
+  const peigen_iterative_params params =
+      peigen::resolve_iterative_params("cg", preconditioner, effective_tol, effective_maxiter, 10, 1e-4);
+
+  RowMatrix x(rhs.rows(), 1);
+  const peigen_iterative_result stats =
+      peigen::operator_iterative_solve(op, rhs, Eigen::Map<RowMatrix>(x.data(), x.rows(), 1), params);
+
+  py::dict out;
+  out["iterations"] = stats.iterations;
+  out["error"] = stats.error;
+  return out;
+}
+
+// Asynchronous execution. Each submitted op becomes one task on the native work-stealing
+// pool; its inputs are converted (and pinned) on the calling thread, the numeric work runs
+// without the GIL, and results stay in native form so dependent tasks (e.g. solves fed by
+// a factorization) consume them directly. Conversion to Python objects happens only when a
+// result is requested.
+struct AsyncValue {
+  std::vector<RowMatrix> matrices;
+  std::vector<Eigen::VectorXd> vectors;
+  std::shared_ptr<SparseFactorized> factor;
+  std::shared_ptr<peigen::SparseLeastSquaresQR> qr;
+};
+
+using AsyncConverter = py::object (*)(const AsyncValue &);
+
+class AsyncState {
+ public:
+  bool done() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return done_;
+  }
+
+  void wait() const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return done_; });
+  }
+
+  bool wait_for(double seconds) const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return cv_.wait_for(lock, std::chrono::duration<double>(seconds), [this] { return done_; });
+  }
+
+  // value() and error() are only meaningful once done() is true.
+  const AsyncValue &value() const { return value_; }
+  std::exception_ptr error() const { return error_; }
+
+  // Runs `fn` on the pool once this state is finished (immediately if it already is).
+  void then(peigen::TaskPool::Task fn) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!done_) {
+        continuations_.push_back(std::move(fn));
+        return;
+      }
+    }
+    peigen::TaskPool::instance().submit(std::move(fn));
+  }
+
+  void finish(AsyncValue value, std::exception_ptr error) {
+    std::vector<peigen::TaskPool::Task> continuations;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      value_ = std::move(value);
+      error_ = std::move(error);
+      done_ = true;
+      continuations.swap(continuations_);
+    }
+    cv_.notify_all();
+    for (peigen::TaskPool::Task &fn : continuations) {
+      peigen::TaskPool::instance().submit(std::move(fn));
+    }
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  mutable std::condition_variable cv_;
+  bool done_ = false;
+  AsyncValue value_;
+  std::exception_ptr error_;
+  std::vector<peigen::TaskPool::Task> continuations_;
+};
+
+class AsyncTask {
+ public:
+  AsyncTask(std::shared_ptr<AsyncState> state, AsyncConverter converter)
+      : state_(std::move(state)), converter_(converter) {}
+
+  const std::shared_ptr<AsyncState> &state() const { return state_; }
+
+  bool done() const { return state_->done(); }
+
+  bool wait(const py::object &timeout) const {
+    if (timeout.is_none()) {
+      py::gil_scoped_release release;
+      state_->wait();
+      return true;
+    }
+    const double seconds = timeout.cast<double>();
+    py::gil_scoped_release release;
+    return state_->wait_for(seconds);
+  }
+
+  py::object result() const {
+    if (!state_->done()) {
+      py::gil_scoped_release release;
+      state_->wait();
+    }
+    if (state_->error()) {
+      std::rethrow_exception(state_->error());
+    }
+    return converter_(state_->value());
+  }
+
+  // `fn()` is called on a pool thread with the GIL held once the task has finished.
+  void add_done_callback(py::function fn) {
+    std::shared_ptr<py::object> callback(new py::object(std::move(fn)), [](py::object *obj) {
+      py::gil_scoped_acquire gil;
+      delete obj;
+    });
+    py::gil_scoped_release release;
+    state_->then([callback] {
+      py::gil_scoped_acquire gil;
+      try {
+        (*callback)();
+      } catch (py::error_already_set &e) {
+        e.discard_as_unraisable("peigen async done callback");
+      }
+    });
+  }
+
+ private:
+  std::shared_ptr<AsyncState> state_;
+  AsyncConverter converter_;
+};
+
+// Python objects referenced by a running task. The last reference may be dropped on a pool
+// thread, so the deleter takes the GIL when there is anything to release.
+using PinnedObjects = std::shared_ptr<std::vector<py::object>>;
+
+static PinnedObjects make_pins() {
+  return PinnedObjects(new std::vector<py::object>(), [](std::vector<py::object> *pins) {
+    if (pins->empty()) {
+      delete pins;
+      return;
+    }
+    py::gil_scoped_acquire gil;
+    delete pins;
+  });
+}
+
+// A dense operand: either a pinned C-contiguous array or the single matrix produced by
+// another task.
+struct AsyncDense {
+  std::shared_ptr<AsyncState> dep;
+  const double *data = nullptr;
+  Eigen::Index rows = 0;
+  Eigen::Index cols = 0;
+
+  bool known() const { return !dep; }
+
+  Eigen::Map<const RowMatrix> get() const {
+    if (!dep) {
+      return Eigen::Map<const RowMatrix>(data, rows, cols);
+    }
+    const AsyncValue &value = dep->value();
+    if (value.matrices.size() != 1 || !value.vectors.empty()) {
+      throw std::invalid_argument("dependency does not produce a single array");
+    }
+    const RowMatrix &m = value.matrices.front();
+    return Eigen::Map<const RowMatrix>(m.data(), m.rows(), m.cols());
+  }
+};
+
+struct AsyncInputs {
+  PinnedObjects pins = make_pins();
+  std::vector<std::shared_ptr<AsyncState>> deps;
+
+  std::shared_ptr<AsyncState> dependency(const py::object &obj) {
+    std::shared_ptr<AsyncState> state = obj.cast<const AsyncTask &>().state();
+    deps.push_back(state);
+    return state;
+  }
+
+  AsyncDense dense(const py::object &obj, const std::string &name) {
+    AsyncDense out;
+    if (py::isinstance<AsyncTask>(obj)) {
+      out.dep = dependency(obj);
+      return out;
+    }
+    auto arr = py::array_t<double, py::array::c_style | py::array::forcecast>::ensure(obj);
+    if (!arr) {
+      throw py::type_error(name + " must be convertible to a float64 array");
+    }
+    validate_2d(arr, name);
+    out.data = arr.data();
+    out.rows = arr.shape(0);
+    out.cols = arr.shape(1);
+    pins->push_back(std::move(arr));
+    return out;
+  }
+
+  Eigen::Map<const Sparse> sparse(const py::object &obj) {
+    SparseCscView view = map_sparse_csc(obj, true);
+    for (py::object *obj : {&view.owner, &view.indptr, &view.indices, &view.data}) {
+      if (*obj) {
+        pins->push_back(std::move(*obj));
+      }
+    }
+    return view.mat;
+  }
+};
+
+static std::shared_ptr<AsyncTask> launch_async(AsyncInputs inputs, AsyncConverter converter,
+                                               std::function<AsyncValue()> work) {
+  auto state = std::make_shared<AsyncState>();
+  const std::vector<std::shared_ptr<AsyncState>> deps = inputs.deps;
+  auto run = [state, deps, pins = std::move(inputs.pins), work = std::move(work)]() {
+    AsyncValue value;
+    std::exception_ptr error;
+    try {
+      for (const std::shared_ptr<AsyncState> &dep : deps) {
+        if (dep->error()) {
+          std::rethrow_exception(dep->error());
+        }
+      }
+      value = work();
+    } catch (...) {
+      error = std::current_exception();
+    }
+    state->finish(std::move(value), std::move(error));
+  };
+
+  {
+    // Submission may wait on the pool's lifecycle lock; never hold the GIL there.
+    py::gil_scoped_release release;
+    if (deps.empty()) {
+      peigen::TaskPool::instance().submit(std::move(run));
+    } else {
+      auto remaining = std::make_shared<std::atomic<std::size_t>>(deps.size());
+      auto shared_run = std::make_shared<decltype(run)>(std::move(run));
+      for (const std::shared_ptr<AsyncState> &dep : deps) {
+        dep->then([remaining, shared_run] {
+          if (remaining->fetch_sub(1) == 1) {
+            (*shared_run)();
+          }
+        });
+      }
+    }
+  }
+  return std::make_shared<AsyncTask>(std::move(state), converter);
+}
+
+static py::object async_to_array(const AsyncValue &v) {
+  return assign_to_output(v.matrices.front());
+}
+
+static py::object async_to_eigh(const AsyncValue &v) {
+  if (v.matrices.empty()) {
+    return vector_to_numpy(v.vectors.front());
+  }
+  return py::make_tuple(vector_to_numpy(v.vectors.front()), assign_to_output(v.matrices.front()));
+}
+
+static py::object async_to_svd(const AsyncValue &v) {
+  return py::make_tuple(assign_to_output(v.matrices[0]), vector_to_numpy(v.vectors.front()),
+                        assign_to_output(v.matrices[1]));
+}
+
+static py::object async_to_factor(const AsyncValue &v) {
+  return v.qr ? py::cast(v.qr) : py::cast(v.factor);
+}
+
+static std::shared_ptr<AsyncTask> core_async_matmul(const py::object &a, const py::object &b) {
+  AsyncInputs inputs;
+  const AsyncDense lhs = inputs.dense(a, "a");
+  const AsyncDense rhs = inputs.dense(b, "b");
+  if (lhs.known() && rhs.known() && lhs.cols != rhs.rows) {
+    throw py::value_error("matmul dimension mismatch");
+  }
+  return launch_async(std::move(inputs), async_to_array, [lhs, rhs] {
+    const Eigen::Map<const RowMatrix> l = lhs.get();
+    const Eigen::Map<const RowMatrix> r = rhs.get();
+    AsyncValue value;
+    value.matrices.emplace_back(l.rows(), r.cols());
+    RowMatrix &out = value.matrices.front();
+    peigen::gemm(l, r, Eigen::Map<RowMatrix>(out.data(), out.rows(), out.cols()));
+    return value;
+  });
+}
+
+static std::shared_ptr<AsyncTask> core_async_solve(const py::object &a, const py::object &b,
+                                                   const std::string &method, const std::string &precision) {
+  peigen::resolve_lapack_eigen_method(method, "solve");
+  if (precision != "double" && precision != "mixed") {
+    throw py::value_error("precision must be 'double' or 'mixed'");
+  }
+  AsyncInputs inputs;
+  const AsyncDense lhs = inputs.dense(a, "a");
+  const AsyncDense rhs = inputs.dense(b, "b");
+  if (lhs.known() && lhs.rows != lhs.cols) {
+    throw py::value_error("a must be square");
+  }
+  if (lhs.known() && rhs.known() && lhs.rows != rhs.rows) {
+    throw py::value_error("a and b shape mismatch");
+  }
+  return launch_async(std::move(inputs), async_to_array, [lhs, rhs, method, precision] {
+    AsyncValue value;
+    if (precision == "mixed") {
+      peigen::RefinementInfo info;
+      value.matrices.emplace_back(peigen::solve_dense_mixed(ColMatrix(lhs.get()), ColMatrix(rhs.get()), method, info));
+    } else {
+      value.matrices.emplace_back(peigen::solve_dense(ColMatrix(lhs.get()), ColMatrix(rhs.get()), method));
+    }
+    return value;
+  });
+}
+
+static std::shared_ptr<AsyncTask> core_async_eigh(const py::object &a, bool lower, bool eigenvectors,
+                                                  const std::string &method) {
+  peigen::resolve_eigh_method(method);
+  AsyncInputs inputs;
+  const AsyncDense m = inputs.dense(a, "a");
+  if (m.known() && m.rows != m.cols) {
+    throw py::value_error("eigh requires square matrix");
+  }
+  return launch_async(std::move(inputs), async_to_eigh, [m, lower, eigenvectors, method] {
+    EighFactors factors = peigen::compute_eigh(ColMatrix(m.get()), lower, eigenvectors, method);
+    AsyncValue value;
+    value.vectors.push_back(std::move(factors.w));
+    if (eigenvectors) {
+      value.matrices.emplace_back(factors.v);
+    }
+    return value;
+  });
+}
+
+// Async form of eigh_generalized. A CholeskyFactor `b` is copied at submission, so a later
+// update() on the caller's factor cannot race with the task.
+static std::shared_ptr<AsyncTask> core_async_eigh_generalized(const py::object &a, const py::object &b, int type,
+                                                              bool lower, bool eigenvectors, const std::string &method,
+                                                              Eigen::Index subset_lo, Eigen::Index subset_hi) {
+  peigen::resolve_eigh_method(method);
+  AsyncInputs inputs;
+  const AsyncDense m = inputs.dense(a, "a");
+  if (m.known() && m.rows != m.cols) {
+    throw py::value_error("eigh requires square matrix");
+  }
+  std::shared_ptr<const peigen::CholeskyFactor> factor;
+  AsyncDense mass;
+  if (py::isinstance<peigen::CholeskyFactor>(b)) {
+    factor = std::make_shared<const peigen::CholeskyFactor>(b.cast<const peigen::CholeskyFactor &>());
+  } else {
+    mass = inputs.dense(b, "b");
+  }
+  const Eigen::Index n = factor ? factor->size() : mass.rows;
+  if (m.known() && (factor || mass.known()) && m.rows != n) {
+    throw py::value_error("a and b shape mismatch");
+  }
+  return launch_async(std::move(inputs), async_to_eigh,
+                      [m, factor, mass, type, lower, eigenvectors, method, subset_lo, subset_hi] {
+                        const ColMatrix lhs(m.get());
+                        EighFactors factors =
+                            factor ? peigen::compute_generalized_eigh(lhs, *factor, type, lower, eigenvectors, method,
+                                                                      subset_lo, subset_hi)
+                                   : peigen::compute_generalized_eigh(lhs, ColMatrix(mass.get()), type, lower,
+                                                                      eigenvectors, method, subset_lo, subset_hi);
+                        AsyncValue value;
+                        value.vectors.push_back(std::move(factors.w));
+                        if (eigenvectors) {
+                          value.matrices.emplace_back(factors.v);
+                        }
+                        return value;
+                      });
+}
+
+static std::shared_ptr<AsyncTask> core_async_svd(const py::object &a, bool full_matrices,
+                                                 const std::string &method) {
+  peigen::resolve_svd_method(method);
+  AsyncInputs inputs;
+  const AsyncDense m = inputs.dense(a, "a");
+  return launch_async(std::move(inputs), async_to_svd, [m, full_matrices, method] {
+    SvdFactors factors = peigen::compute_svd(ColMatrix(m.get()), full_matrices, method);
+    AsyncValue value;
+    value.matrices.emplace_back(factors.u);
+    value.matrices.emplace_back(factors.vt);
+    value.vectors.push_back(std::move(factors.s));
+    return value;
+  });
+}
+
+// alpha * op(a) @ b into a new array; the fused kernel's beta/out accumulation has no async
+// form because the task would write into a caller-owned buffer.
+static std::shared_ptr<AsyncTask> core_async_spmm(const py::object &a, const py::object &b, bool transpose,
+                                                  double alpha) {
+  AsyncInputs inputs;
+  const Eigen::Map<const Sparse> mat = inputs.sparse(a);
+  const AsyncDense rhs = inputs.dense(b, "b");
+  const Eigen::Index in_rows = transpose ? mat.rows() : mat.cols();
+  if (rhs.known() && in_rows != rhs.rows) {
+    throw py::value_error("spmm dimension mismatch");
+  }
+  return launch_async(std::move(inputs), async_to_array, [mat, rhs, transpose, alpha, in_rows] {
+    const Eigen::Map<const RowMatrix> r = rhs.get();
+    if (in_rows != r.rows()) {
+      throw std::invalid_argument("spmm dimension mismatch");
+    }
+    AsyncValue value;
+    value.matrices.emplace_back(transpose ? mat.cols() : mat.rows(), r.cols());
+    double *out = value.matrices.front().data();
+    if (!transpose && alpha == 1.0) {
+      peigen::spmm(mat, r.data(), r.cols(), out);
+    } else {
+      peigen::spmm_axpby(mat, transpose, alpha, r.data(), r.cols(), 0.0, out);
+    }
+    return value;
+  });
+}
+
+static std::shared_ptr<AsyncTask> core_async_sparse_solve(const py::object &a,
+                                                          const py::object &b,
+                                                          const std::string &method,
+                                                          double tol,
+                                                          int maxiter,
+                                                          const std::string &preconditioner,
+                                                          int ilu_fill_factor,
+                                                          double ilu_drop_tol) {
+  AsyncInputs inputs;
+  const Eigen::Map<const Sparse> mat = inputs.sparse(a);
+  const AsyncDense rhs = inputs.dense(b, "b");
+  return launch_async(std::move(inputs), async_to_array,
+                      [mat, rhs, method, tol, maxiter, preconditioner, ilu_fill_factor, ilu_drop_tol] {
+                        const Eigen::Map<const RowMatrix> r = rhs.get();
+                        AsyncValue value;
+                        value.matrices.emplace_back(r.rows(), r.cols());
+                        RowMatrix &out = value.matrices.front();
+                        sparse_solve_into(mat, r, Eigen::Map<RowMatrix>(out.data(), out.rows(), out.cols()), method,
+                                          tol, maxiter, preconditioner, ilu_fill_factor, ilu_drop_tol);
+                        return value;
+                      });
+}
+
+static std::shared_ptr<AsyncTask> core_async_sparse_factorize(const py::object &a, const std::string &precision) {
+  AsyncInputs inputs;
+  const Eigen::Map<const Sparse> mat = inputs.sparse(a);
+  if (mat.rows() != mat.cols()) {
+    throw py::value_error("factorize requires square sparse matrix");
+  }
+  if (precision != "double" && precision != "mixed") {
+    throw py::value_error("precision must be 'double' or 'mixed'");
+  }
+  return launch_async(std::move(inputs), async_to_factor, [mat, precision] {
+    AsyncValue value;
+    value.factor = make_sparse_factorized(Sparse(mat), precision);
+    return value;
+  });
+}
+
+// Async form of sparse_factorize_permuted: `a` is already reordered and the permutations
+// are validated and copied at submission.
+static std::shared_ptr<AsyncTask> core_async_sparse_factorize_permuted(const py::object &a,
+                                                                       const py::object &row_perm,
+                                                                       const py::object &col_perm) {
+  AsyncInputs inputs;
+  const Eigen::Map<const Sparse> mat = inputs.sparse(a);
+  if (mat.rows() != mat.cols()) {
+    throw py::value_error("factorize requires square sparse matrix");
+  }
+  std::vector<int> rows = permutation_vector(row_perm);
+  std::vector<int> cols = permutation_vector(col_perm);
+  if (!rows.empty()) {
+    peigen::validate_permutation(rows, mat.rows());
+  }
+  peigen::validate_permutation(cols, mat.cols());
+  return launch_async(std::move(inputs), async_to_factor, [mat, rows = std::move(rows), cols = std::move(cols)] {
+    AsyncValue value;
+    value.factor = std::make_shared<SparseFactorized>(Sparse(mat), rows, cols);
+    return value;
+  });
+}
+
+static std::shared_ptr<AsyncTask> core_async_sparse_factorize_qr(const py::object &a, double pivot_threshold) {
+  AsyncInputs inputs;
+  const Eigen::Map<const Sparse> mat = inputs.sparse(a);
+  return launch_async(std::move(inputs), async_to_factor, [mat, pivot_threshold] {
+    AsyncValue value;
+    value.qr = std::make_shared<peigen::SparseLeastSquaresQR>(Sparse(mat), pivot_threshold);
+    return value;
+  });
+}
+
+static RowMatrix async_qr_solve(const peigen::SparseLeastSquaresQR &qr, const Eigen::Map<const RowMatrix> &rhs) {
+  RowMatrix out(qr.cols(), rhs.cols());
+  qr.solve(rhs, Eigen::Map<RowMatrix>(out.data(), out.rows(), out.cols()));
+  return out;
+}
+
+static std::shared_ptr<AsyncTask> core_async_sparse_lstsq(const py::object &a, const py::object &b,
+                                                          const std::string &method, double tol, int maxiter,
+                                                          double pivot_threshold) {
+  if (method != "qr" && method != "lscg") {
+    throw py::value_error("method must be one of: qr, lscg");
+  }
+  AsyncInputs inputs;
+  const Eigen::Map<const Sparse> mat = inputs.sparse(a);
+  const AsyncDense rhs = inputs.dense(b, "b");
+  if (rhs.known() && rhs.rows != mat.rows()) {
+    throw py::value_error("lstsq shape mismatch");
+  }
+  return launch_async(std::move(inputs), async_to_array, [mat, rhs, method, tol, maxiter, pivot_threshold] {
+    const Eigen::Map<const RowMatrix> r = rhs.get();
+    AsyncValue value;
+    if (method == "qr") {
+      value.matrices.emplace_back(async_qr_solve(peigen::SparseLeastSquaresQR(Sparse(mat), pivot_threshold), r));
+      return value;
+    }
+    value.matrices.emplace_back(mat.cols(), r.cols());
+    RowMatrix &out = value.matrices.front();
+    peigen::sparse_lscg_solve(mat, r, Eigen::Map<RowMatrix>(out.data(), out.rows(), out.cols()),
+                              tol > 0.0 ? tol : 1e-8, maxiter > 0 ? maxiter : static_cast<int>(mat.cols() * 2));
+    return value;
+  });
+}
+
+// `factor` is a SparseFactorized, a SparseQRFactorized or a pending factorize task; in the
+// latter case the solve is chained natively and starts as soon as the factorization finishes.
+static std::shared_ptr<AsyncTask> core_async_factorized_solve(const py::object &factor, const py::object &b) {
+  AsyncInputs inputs;
+  std::shared_ptr<SparseFactorized> ready;
+  std::shared_ptr<peigen::SparseLeastSquaresQR> ready_qr;
+  std::shared_ptr<AsyncState> pending;
+  if (py::isinstance<AsyncTask>(factor)) {
+    pending = inputs.dependency(factor);
+  } else if (py::isinstance<peigen::SparseLeastSquaresQR>(factor)) {
+    ready_qr = factor.cast<std::shared_ptr<peigen::SparseLeastSquaresQR>>();
+  } else {
+    ready = factor.cast<std::shared_ptr<SparseFactorized>>();
+  }
+  const AsyncDense rhs = inputs.dense(b, "b");
+  return launch_async(std::move(inputs), async_to_array, [ready, ready_qr, pending, rhs] {
+    const Eigen::Map<const RowMatrix> r = rhs.get();
+    AsyncValue value;
+    const peigen::SparseLeastSquaresQR *qr = ready_qr ? ready_qr.get() : pending ? pending->value().qr.get() : nullptr;
+    if (qr != nullptr) {
+      value.matrices.emplace_back(async_qr_solve(*qr, r));
+      return value;
+    }
+    const SparseFactorized *solver = ready ? ready.get() : pending->value().factor.get();
+    if (solver == nullptr) {
+      throw std::invalid_argument("dependency does not produce a factorization");
+    }
+    value.matrices.emplace_back(r.rows(), r.cols());
+    RowMatrix &out = value.matrices.front();
+    solver->solve_into(r, Eigen::Map<RowMatrix>(out.data(), out.rows(), out.cols()));
+    return value;
+  });
+}
+
+static void core_async_set_workers(int n) {
+  py::gil_scoped_release release;
+  peigen::TaskPool::instance().resize(n);
+}
+
+static int core_async_get_workers() {
+  return peigen::TaskPool::instance().size();
+}
+
+static void core_async_shutdown() {
+  py::gil_scoped_release release;
+  peigen::TaskPool::instance().shutdown();
+}
+
+static void core_set_num_threads(int n, const std::string &layer) {
+  peigen::set_num_threads(n, layer);
+}
+
+static int core_get_num_threads() {
+  return peigen::get_num_threads();
+}
+
+static void core_set_factor_cache(py::ssize_t max_bytes) {
+  if (max_bytes < 0) {
+    throw py::value_error("max_bytes must be non-negative");
+  }
+  peigen::set_factor_cache_limit(static_cast<std::size_t>(max_bytes));
+}
+
+static py::dict core_factor_cache_info() {
+  const peigen::FactorCacheStats stats = peigen::factor_cache_stats();
+  py::dict out;
+  out["enabled"] = stats.max_bytes > 0;
+  out["hits"] = stats.hits;
+  out["misses"] = stats.misses;
+  out["evictions"] = stats.evictions;
+  out["entries"] = stats.entries;
+  out["bytes"] = stats.bytes;
+  out["max_bytes"] = stats.max_bytes;
+  return out;
+}
+
+static py::dict core_thread_info() {
+  const peigen::ThreadInfo threads = peigen::thread_info();
+  py::dict info;
+  info["eigen"] = threads.eigen;
+  info["openmp"] = threads.openmp;
+  info["blas"] = threads.blas;
+  info["blas_threading_api"] = threads.blas_threading_api;
+  info["default"] = threads.default_threads;
+  return info;
 }
 
 static py::dict core_build_config() {
@@ -1013,28 +1830,137 @@ static py::dict core_build_config() {
   cfg["vectorization_enabled"] = false;
 #endif
   cfg["eigen_mpl2_only"] = true;
+  const peigen::ThreadInfo threads = peigen::thread_info();
+  cfg["num_threads"] = threads.eigen;
+  cfg["openmp_max_threads"] = threads.openmp;
+  cfg["blas_num_threads"] = threads.blas;
+  cfg["blas_threading_api"] = threads.blas_threading_api;
+  const peigen::KernelDispatch &dispatch = peigen::kernel_dispatch();
+  std::vector<std::string> variants = {peigen::baseline_isa()};
+  variants.insert(variants.end(), dispatch.variants.begin(), dispatch.variants.end());
+  cfg["kernel_isa"] = dispatch.table->isa;
+  cfg["kernel_isa_variants"] = variants;
+  cfg["cpu_isa_supported"] = dispatch.cpu_supported;
+  cfg["kernel_isa_forced"] = dispatch.forced;
+  cfg["kernel_isa_note"] = dispatch.note;
+  cfg["async_workers"] = peigen::TaskPool::instance().size();
   return cfg;
 }
 
 PYBIND11_MODULE(_core, m) {
   m.doc() = "pEigen core extension";
 
+  peigen::init_kernel_dispatch();
+  const peigen::KernelDispatch &dispatch = peigen::kernel_dispatch();
+  if (dispatch.forced && !dispatch.note.empty()) {
+    if (PyErr_WarnEx(PyExc_RuntimeWarning, dispatch.note.c_str(), 1) != 0) {
+      throw py::error_already_set();
+    }
+  }
+
+  py::class_<peigen::SparseLeastSquaresQR, std::shared_ptr<peigen::SparseLeastSquaresQR>>(m, "SparseQRFactorized")
+      .def("solve", &sparse_qr_solve, py::arg("b"))
+      .def_property_readonly(
+          "shape", [](const peigen::SparseLeastSquaresQR &qr) { return py::make_tuple(qr.rows(), qr.cols()); })
+      .def_property_readonly("rank", &peigen::SparseLeastSquaresQR::rank);
+
+  py::class_<peigen::CholeskyFactor, std::shared_ptr<peigen::CholeskyFactor>>(
+      m, "CholeskyFactor", "Dense Cholesky factor B = L L^T, reusable across solves and generalized eigh calls.")
+      .def(py::init(&core_cholesky_factor), py::arg("b"), py::arg("lower") = true)
+      .def("solve", &dense_factor_solve<peigen::CholeskyFactor>, py::arg("b"))
+      .def("update", &dense_factor_update<peigen::CholeskyFactor>, py::arg("u"), py::arg("sign") = 1)
+      .def_property_readonly("shape",
+                             [](const peigen::CholeskyFactor &f) { return py::make_tuple(f.size(), f.size()); })
+      .def_property_readonly("L", [](const peigen::CholeskyFactor &f) { return assign_to_output(f.matrix_l()); });
+
+  py::class_<peigen::LDLTFactor, std::shared_ptr<peigen::LDLTFactor>>(
+      m, "LDLTFactor", "Dense pivoted LDL^T factor of a symmetric (possibly indefinite) matrix with low-rank updates.")
+      .def(py::init(&core_ldlt_factor), py::arg("a"), py::arg("lower") = true)
+      .def("solve", &dense_factor_solve<peigen::LDLTFactor>, py::arg("b"))
+      .def("update", &dense_factor_update<peigen::LDLTFactor>, py::arg("u"), py::arg("sign") = 1)
+      .def_property_readonly("shape", [](const peigen::LDLTFactor &f) { return py::make_tuple(f.size(), f.size()); })
+      .def_property_readonly("positive_definite", &peigen::LDLTFactor::positive_definite);
+
   py::class_<SparseFactorized, std::shared_ptr<SparseFactorized>>(m, "SparseFactorized")
-      .def("solve", &SparseFactorized::solve, py::arg("b"));
+      .def("solve", &SparseFactorized::solve, py::arg("b"))
+      .def("solve_stats", &SparseFactorized::solve_stats, py::arg("b"))
+      .def_property_readonly("stats", &SparseFactorized::stats);
+
+  py::class_<SparseHandle, std::shared_ptr<SparseHandle>>(
+      m, "SparseMatrix",
+      "Persistent sparse matrix owning native CSC storage; diagonal, transpose and CSR are cached.")
+      .def(py::init(&core_sparse_handle), py::arg("a"))
+      .def_static("from_coo", &core_sparse_handle_from_coo, py::arg("data"), py::arg("row"), py::arg("col"),
+                  py::arg("shape"))
+      .def_property_readonly("shape",
+                             [](const SparseHandle &h) { return py::make_tuple(h.csc().rows(), h.csc().cols()); })
+      .def_property_readonly("nnz", [](const SparseHandle &h) { return h.csc().nonZeros(); })
+      .def_property_readonly("T", &SparseHandle::transpose)
+      .def("diagonal", [](const SparseHandle &h) { return vector_to_numpy(h.diagonal()); })
+      .def("to_scipy", &sparse_handle_to_scipy, py::arg("format") = "csc")
+      .def("toarray", [](const SparseHandle &h) { return assign_to_output(ColMatrix(h.csc())); })
+      .def("__matmul__", &sparse_handle_matmul, py::arg("b"))
+      .def("__repr__", [](const SparseHandle &h) {
+        return "<peigen.sparse.Matrix shape=(" + std::to_string(h.csc().rows()) + ", " +
+               std::to_string(h.csc().cols()) + ") nnz=" + std::to_string(h.csc().nonZeros()) + ">";
+      });
+
+  py::class_<peigen::CooPattern, std::shared_ptr<peigen::CooPattern>>(m, "CooPattern")
+      .def(py::init(&core_coo_pattern), py::arg("row"), py::arg("col"), py::arg("rows"), py::arg("cols"))
+      .def_property_readonly("shape",
+                             [](const peigen::CooPattern &p) { return py::make_tuple(p.rows(), p.cols()); })
+      .def_property_readonly("nnz", &peigen::CooPattern::nnz)
+      .def_property_readonly("triplets", &peigen::CooPattern::triplets)
+      .def("assemble", &coo_pattern_assemble, py::arg("data"))
+      .def("assemble_into", &coo_pattern_assemble_into, py::arg("data"), py::arg("values"));
+
+  py::class_<LinearOperator, LinearOperatorPtr>(m, "LinearOperator")
+      .def_property_readonly("shape", [](const LinearOperator &op) { return py::make_tuple(op.rows(), op.cols()); })
+      .def("matvec", [](const LinearOperator &op, const py::array_t<double, py::array::forcecast> &x) {
+        return linop_apply(op, x, false);
+      }, py::arg("x"))
+      .def("rmatvec", [](const LinearOperator &op, const py::array_t<double, py::array::forcecast> &x) {
+        return linop_apply(op, x, true);
+      }, py::arg("x"))
+      .def("diagonal", [](const LinearOperator &op) { return vector_to_numpy(op.diagonal()); });
+
+  py::class_<AsyncTask, std::shared_ptr<AsyncTask>>(m, "AsyncTask")
+      .def("done", &AsyncTask::done)
+      .def("wait", &AsyncTask::wait, py::arg("timeout") = py::none())
+      .def("result", &AsyncTask::result)
+      .def("add_done_callback", &AsyncTask::add_done_callback, py::arg("fn"));
 
   m.def("matmul", &core_matmul, py::arg("a"), py::arg("b"));
+  m.def("gram", &core_gram, py::arg("a"), py::arg("trans") = true, py::arg("lower") = true,
+        py::arg("mirror") = true);
+  m.def("trmm", &core_trmm, py::arg("a"), py::arg("b"), py::arg("lower") = true, py::arg("unit_diagonal") = false,
+        py::arg("left") = true);
+  m.def("symm", &core_symm, py::arg("a"), py::arg("b"), py::arg("lower") = true, py::arg("left") = true);
   m.def("solve", &core_solve, py::arg("a"), py::arg("b"), py::arg("method") = "auto");
+  m.def("solve_mixed", &core_solve_mixed, py::arg("a"), py::arg("b"), py::arg("method") = "auto");
   m.def("qr", &core_qr, py::arg("a"), py::arg("mode") = "reduced");
   m.def("svd", &core_svd, py::arg("a"), py::arg("full_matrices") = false, py::arg("method") = "auto");
   m.def("svd_compute", &core_svd_compute, py::arg("a"), py::arg("full_matrices") = false,
         py::arg("method") = "auto");
   m.def("eigh", &core_eigh, py::arg("a"), py::arg("lower") = true, py::arg("eigenvectors") = true,
         py::arg("method") = "auto");
+  m.def("eigh_generalized", &core_eigh_generalized, py::arg("a"), py::arg("b"), py::arg("type") = 1,
+        py::arg("lower") = true, py::arg("eigenvectors") = true, py::arg("method") = "auto", py::arg("subset_lo") = -1,
+        py::arg("subset_hi") = -1);
   m.def("eigh_compute", &core_eigh_compute, py::arg("a"), py::arg("lower") = true, py::arg("method") = "auto");
+  m.def("eigh_batched", &core_eigh_batched, py::arg("a"), py::arg("lower") = true, py::arg("eigenvectors") = true,
+        py::arg("method") = "auto");
+  m.def("solve_batched", &core_solve_batched, py::arg("a"), py::arg("b"), py::arg("positive_definite") = false);
   m.def("norm", &core_norm, py::arg("a"));
 
   m.def("spmm", &core_spmm, py::arg("a"), py::arg("b"));
+  m.def("spmm_axpby", &core_spmm_axpby, py::arg("a"), py::arg("b"), py::arg("out"), py::arg("transpose"),
+        py::arg("alpha"), py::arg("beta"));
+  m.def("normal_spmm", &core_normal_spmm, py::arg("a"), py::arg("b"));
+  m.def("sddmm", &core_sddmm, py::arg("a"), py::arg("x"), py::arg("y"));
   m.def("spspmm", &core_spspmm, py::arg("a"), py::arg("b"));
+  m.def("sparse_ordering", &core_sparse_ordering, py::arg("a"), py::arg("method"));
+  m.def("sparse_permute", &core_sparse_permute, py::arg("a"), py::arg("row_perm"), py::arg("col_perm"));
   m.def("sparse_solve", &core_sparse_solve,
         py::arg("a"),
         py::arg("b"),
@@ -1053,6 +1979,72 @@ PYBIND11_MODULE(_core, m) {
         py::arg("preconditioner") = "none",
         py::arg("ilu_fill_factor") = 10,
         py::arg("ilu_drop_tol") = 1e-4);
-  m.def("sparse_factorize", &core_sparse_factorize, py::arg("a"));
+  m.def("sparse_factorize_qr", &core_sparse_factorize_qr, py::arg("a"), py::arg("pivot_threshold") = -1.0);
+  m.def("sparse_lstsq", &core_sparse_lstsq, py::arg("a"), py::arg("b"), py::arg("method") = "qr",
+        py::arg("tol") = 1e-8, py::arg("maxiter") = 0, py::arg("pivot_threshold") = -1.0);
+  m.def("sparse_factorize", &core_sparse_factorize, py::arg("a"), py::arg("precision") = "double");
+  m.def("sparse_factorize_permuted", &core_sparse_factorize_permuted, py::arg("a"), py::arg("row_perm"),
+        py::arg("col_perm"));
+  m.def("coo_to_csc", &core_coo_to_csc, py::arg("data"), py::arg("row"), py::arg("col"), py::arg("rows"),
+        py::arg("cols"));
+  m.def("linop_sparse", &core_linop_sparse, py::arg("a"));
+  m.def("linop_dense", &core_linop_dense, py::arg("a"));
+  m.def("linop_identity", &peigen::make_identity_operator, py::arg("n"));
+  m.def("linop_sum", &peigen::make_sum_operator, py::arg("terms"));
+  m.def("linop_scaled", &peigen::make_scaled_operator, py::arg("alpha"), py::arg("op"));
+  m.def("linop_product", &peigen::make_product_operator, py::arg("factors"));
+  m.def("linop_transpose", &peigen::make_transpose_operator, py::arg("op"));
+  m.def("linop_kron", &peigen::make_kron_operator, py::arg("a"), py::arg("b"));
+  m.def("linop_block_diag", &peigen::make_block_diag_operator, py::arg("blocks"));
+  m.def("operator_solve", &core_operator_solve,
+        py::arg("op"),
+        py::arg("b"),
+        py::arg("method") = "cg",
+        py::arg("tol") = 1e-8,
+        py::arg("maxiter") = 0,
+        py::arg("preconditioner") = "none");
+  m.def("operator_solve_stats", &core_operator_solve_stats,
+        py::arg("op"),
+        py::arg("b"),
+        py::arg("tol") = 1e-8,
+        py::arg("maxiter") = 0,
+        py::arg("preconditioner") = "none");
+  m.def("async_matmul", &core_async_matmul, py::arg("a"), py::arg("b"));
+  m.def("async_solve", &core_async_solve, py::arg("a"), py::arg("b"), py::arg("method") = "auto",
+        py::arg("precision") = "double");
+  m.def("async_eigh", &core_async_eigh, py::arg("a"), py::arg("lower") = true, py::arg("eigenvectors") = true,
+        py::arg("method") = "auto");
+  m.def("async_eigh_generalized", &core_async_eigh_generalized, py::arg("a"), py::arg("b"), py::arg("type") = 1,
+        py::arg("lower") = true, py::arg("eigenvectors") = true, py::arg("method") = "auto", py::arg("subset_lo") = -1,
+        py::arg("subset_hi") = -1);
+  m.def("async_svd", &core_async_svd, py::arg("a"), py::arg("full_matrices") = false, py::arg("method") = "auto");
+  m.def("async_spmm", &core_async_spmm, py::arg("a"), py::arg("b"), py::arg("transpose") = false,
+        py::arg("alpha") = 1.0);
+  m.def("async_sparse_solve", &core_async_sparse_solve,
+        py::arg("a"),
+        py::arg("b"),
+        py::arg("method") = "auto",
+        py::arg("tol") = 1e-8,
+        py::arg("maxiter") = 0,
+        py::arg("preconditioner") = "none",
+        py::arg("ilu_fill_factor") = 10,
+        py::arg("ilu_drop_tol") = 1e-4);
+  m.def("async_sparse_factorize", &core_async_sparse_factorize, py::arg("a"), py::arg("precision") = "double");
+  m.def("async_sparse_factorize_permuted", &core_async_sparse_factorize_permuted, py::arg("a"), py::arg("row_perm"),
+        py::arg("col_perm"));
+  m.def("async_sparse_factorize_qr", &core_async_sparse_factorize_qr, py::arg("a"),
+        py::arg("pivot_threshold") = -1.0);
+  m.def("async_sparse_lstsq", &core_async_sparse_lstsq, py::arg("a"), py::arg("b"), py::arg("method") = "qr",
+        py::arg("tol") = 1e-8, py::arg("maxiter") = 0, py::arg("pivot_threshold") = -1.0);
+  m.def("async_factorized_solve", &core_async_factorized_solve, py::arg("factor"), py::arg("b"));
+  m.def("async_set_workers", &core_async_set_workers, py::arg("n"));
+  m.def("async_get_workers", &core_async_get_workers);
+  m.def("async_shutdown", &core_async_shutdown);
   m.def("build_config", &core_build_config);
+  m.def("set_num_threads", &core_set_num_threads, py::arg("n"), py::arg("layer") = "all");
+  m.def("get_num_threads", &core_get_num_threads);
+  m.def("thread_info", &core_thread_info);
+  m.def("set_factor_cache", &core_set_factor_cache, py::arg("max_bytes"));
+  m.def("factor_cache_info", &core_factor_cache_info);
+  m.def("clear_factor_cache", &peigen::clear_factor_cache);
 }
@@ -0,0 +1,155 @@
+#include "core/assembly.h"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "core/threads.h"
+
+namespace peigen {
+
+namespace {
+
+// Minimum number of triplets before the value pass is split across OpenMP threads.
+constexpr Eigen::Index kParallelAssemblyThreshold = 1 << 15;
+
+void validate_coo(Eigen::Index rows, Eigen::Index cols, const int *row, const int *col, Eigen::Index count) {
+  if (rows < 0 || cols < 0) {
+    throw std::invalid_argument("shape must be non-negative");
+  }
+  if (rows > std::numeric_limits<int>::max() || cols > std::numeric_limits<int>::max() ||
+      count > std::numeric_limits<int>::max()) {
+    throw std::invalid_argument("COO input exceeds 32-bit index range");
+  }
+  for (Eigen::Index k = 0; k < count; ++k) {
+    if (row[k] < 0 || row[k] >= rows) {
+      throw std::invalid_argument("row index out of bounds");
+    }
+    if (col[k] < 0 || col[k] >= cols) {
+      throw std::invalid_argument("column index out of bounds");
+    }
+  }
+}
+
+// Forward iterator over parallel COO arrays in the shape setFromTriplets expects
+// (it->row(), it->col(), it->value()), so no triplet copy is made.
+class CooIterator {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = CooIterator;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const CooIterator *;
+  using reference = const CooIterator &;
+
+  CooIterator(const int *row, const int *col, const double *data, Eigen::Index k)
+      : row_(row), col_(col), data_(data), k_(k) {}
+
+  int row() const { return row_[k_]; }
+  int col() const { return col_[k_]; }
+  double value() const { return data_[k_]; }
+
+  reference operator*() const { return *this; }
+  pointer operator->() const { return this; }
+  CooIterator &operator++() {
+    ++k_;
+    return *this;
+  }
+  bool operator==(const CooIterator &other) const { return k_ == other.k_; }
+  bool operator!=(const CooIterator &other) const { return k_ != other.k_; }
+
+ private:
+  const int *row_;
+  const int *col_;
+  const double *data_;
+  Eigen::Index k_;
+};
+
+}  // namespace
+
+Sparse assemble_coo(Eigen::Index rows, Eigen::Index cols, const int *row, const int *col, const double *data,
+                    Eigen::Index count) {
+  validate_coo(rows, cols, row, col, count);
+  Sparse out(rows, cols);
+  out.setFromTriplets(CooIterator(row, col, data, 0), CooIterator(row, col, data, count));
+  out.makeCompressed();
+  return out;
+}
+
+CooPattern::CooPattern(Eigen::Index rows, Eigen::Index cols, const int *row, const int *col, Eigen::Index count)
+    : rows_(rows), cols_(cols) {
+  validate_coo(rows, cols, row, col, count);
+
+  // Counting sort of triplet ids by column.
+  std::vector<int> col_start(static_cast<std::size_t>(cols) + 1, 0);
+  for (Eigen::Index k = 0; k < count; ++k) {
+    ++col_start[static_cast<std::size_t>(col[k]) + 1];
+  }
+  for (Eigen::Index j = 0; j < cols; ++j) {
+    col_start[j + 1] += col_start[j];
+  }
+  order_.resize(static_cast<std::size_t>(count));
+  {
+    std::vector<int> cursor(col_start.begin(), col_start.end() - 1);
+    for (Eigen::Index k = 0; k < count; ++k) {
+      order_[cursor[col[k]]++] = static_cast<int>(k);
+    }
+  }
+
+  // Within each column: order by row (stable, so duplicates keep input order) and count
+  // distinct rows.
+  std::vector<int> unique_per_col(static_cast<std::size_t>(cols), 0);
+#if defined(PEIGEN_USE_OPENMP)
+#pragma omp parallel for schedule(dynamic, 64) if (count >= kParallelAssemblyThreshold) \
+    num_threads(openmp_num_threads())
+#endif
+  for (Eigen::Index j = 0; j < cols; ++j) {
+    const auto first = order_.begin() + col_start[j];
+    const auto last = order_.begin() + col_start[j + 1];
+    std::stable_sort(first, last, [row](int a, int b) { return row[a] < row[b]; });
+    int distinct = 0;
+    for (auto it = first; it != last; ++it) {
+      if (it == first || row[*it] != row[*(it - 1)]) {
+        ++distinct;
+      }
+    }
+    unique_per_col[j] = distinct;
+  }
+
+  outer_.assign(static_cast<std::size_t>(cols) + 1, 0);
+  for (Eigen::Index j = 0; j < cols; ++j) {
+    outer_[j + 1] = outer_[j] + unique_per_col[j];
+  }
+  inner_.resize(static_cast<std::size_t>(outer_.back()));
+  slot_begin_.resize(inner_.size() + 1);
+  slot_begin_.back() = static_cast<int>(count);
+
+  for (Eigen::Index j = 0; j < cols; ++j) {
+    int slot = outer_[j] - 1;
+    for (int pos = col_start[j]; pos < col_start[j + 1]; ++pos) {
+      if (pos == col_start[j] || row[order_[pos]] != row[order_[pos - 1]]) {
+        ++slot;
+        inner_[slot] = row[order_[pos]];
+        slot_begin_[slot] = pos;
+      }
+    }
+  }
+}
+
+void CooPattern::assemble(const double *data, double *values) const {
+  const Eigen::Index n = nnz();
+#if defined(PEIGEN_USE_OPENMP)
+#pragma omp parallel for schedule(static) if (triplets() >= kParallelAssemblyThreshold) \
+    num_threads(openmp_num_threads())
+#endif
+  for (Eigen::Index slot = 0; slot < n; ++slot) {
+    double sum = 0.0;
+    for (int pos = slot_begin_[slot]; pos < slot_begin_[slot + 1]; ++pos) {
+      sum += data[order_[pos]];
+    }
+    values[slot] = sum;
+  }
+}
+
+}  // namespace peigen
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <vector>
+
+#include "core/common.h"
+
+namespace peigen {
+
+// One-shot COO -> CSC assembly with Eigen's setFromTriplets (bucket sort by column, duplicates
+// summed). row/col/data hold `count` triplets; indices are validated against the shape.
+Sparse assemble_coo(Eigen::Index rows, Eigen::Index cols, const int *row, const int *col, const double *data,
+                    Eigen::Index count);
+
+// Two-phase assembly for repeated reassembly with a fixed pattern. The constructor computes
+// the CSC structure and a triplet -> CSC slot map once; assemble() then only sums values into
+// an existing value array (no sorting, no allocation). The map is stored grouped by slot, so
+// duplicate summation runs in parallel without atomics and in a fixed order.
+class CooPattern {
+ public:
+  CooPattern(Eigen::Index rows, Eigen::Index cols, const int *row, const int *col, Eigen::Index count);
+
+  Eigen::Index rows() const { return rows_; }
+  Eigen::Index cols() const { return cols_; }
+  // Stored entries after merging duplicates.
+  Eigen::Index nnz() const { return static_cast<Eigen::Index>(inner_.size()); }
+  Eigen::Index triplets() const { return static_cast<Eigen::Index>(order_.size()); }
+  const std::vector<int> &outer() const { return outer_; }
+  const std::vector<int> &inner() const { return inner_; }
+
+  // values[slot] = sum of the triplet values mapped to slot; `data` has triplets() entries
+  // and `values` nnz() entries.
+  void assemble(const double *data, double *values) const;
+
+ private:
+  Eigen::Index rows_;
+  Eigen::Index cols_;
+  std::vector<int> outer_;
+  std::vector<int> inner_;
+  std::vector<int> slot_begin_;  // nnz() + 1 offsets into order_
+  std::vector<int> order_;       // triplet ids grouped by CSC slot
+};
+
+}  // namespace peigen
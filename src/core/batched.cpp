@@ -0,0 +1,178 @@
+#include "core/batched.h"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+
+#include <Eigen/Dense>
+
+#include "core/threads.h"
+
+namespace peigen {
+
+namespace {
+
+// Below this many matrices the OpenMP fork costs more than the work.
+constexpr std::int64_t kParallelBatch = 256;
+
+template <int N>
+using SquareMatrix = Eigen::Matrix<double, N, N>;
+template <int N>
+using RowSquareMatrix = Eigen::Matrix<double, N, N, Eigen::RowMajor>;
+
+// Lowest failing index across threads, or -1.
+class FirstFailure {
+ public:
+  void record(std::int64_t index) {
+    std::int64_t seen = index_.load();
+    while ((seen < 0 || index < seen) && !index_.compare_exchange_weak(seen, index)) {
+    }
+  }
+  std::int64_t index() const { return index_.load(); }
+
+ private:
+  std::atomic<std::int64_t> index_{-1};
+};
+
+template <int N>
+void eigh_batch(const double *a, std::int64_t batch, int n, bool lower, bool eigenvectors, bool direct, double *w,
+                double *v) {
+  const Eigen::Index stride = static_cast<Eigen::Index>(n) * n;
+  const int options = eigenvectors ? Eigen::ComputeEigenvectors : Eigen::EigenvaluesOnly;
+#if defined(PEIGEN_USE_OPENMP)
+#pragma omp parallel if (batch >= kParallelBatch) num_threads(openmp_num_threads())
+#endif
+  {
+    SquareMatrix<N> m(n, n);
+    Eigen::SelfAdjointEigenSolver<SquareMatrix<N>> solver(n);
+#if defined(PEIGEN_USE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+    for (std::int64_t i = 0; i < batch; ++i) {
+      const Eigen::Map<const RowSquareMatrix<N>> src(a + i * stride, n, n);
+      // The solver reads the lower triangle; the transpose moves the upper one there.
+      if (lower) {
+        m = src;
+      } else {
+        m = src.transpose();
+      }
+      if (direct) {
+        solver.computeDirect(m, options);
+      } else {
+        solver.compute(m, options);
+      }
+      Eigen::Map<Eigen::Matrix<double, N, 1>>(w + i * n, n) = solver.eigenvalues();
+      if (eigenvectors) {
+        Eigen::Map<RowSquareMatrix<N>>(v + i * stride, n, n) = solver.eigenvectors();
+      }
+    }
+  }
+}
+
+template <int N>
+std::int64_t solve_batch(const double *a, const double *b, std::int64_t batch, int n, std::int64_t nrhs,
+                         bool positive_definite, double *x) {
+  using Rhs = Eigen::Matrix<double, N, Eigen::Dynamic, Eigen::RowMajor>;
+  const Eigen::Index stride = static_cast<Eigen::Index>(n) * n;
+  const Eigen::Index rhs_stride = static_cast<Eigen::Index>(n) * nrhs;
+  FirstFailure failure;
+#if defined(PEIGEN_USE_OPENMP)
+#pragma omp parallel if (batch >= kParallelBatch) num_threads(openmp_num_threads())
+#endif
+  {
+    SquareMatrix<N> m(n, n);
+    Eigen::PartialPivLU<SquareMatrix<N>> lu(n);
+    Eigen::LLT<SquareMatrix<N>> llt(n);
+#if defined(PEIGEN_USE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+    for (std::int64_t i = 0; i < batch; ++i) {
+      m = Eigen::Map<const RowSquareMatrix<N>>(a + i * stride, n, n);
+      const Eigen::Map<const Rhs> rhs(b + i * rhs_stride, n, nrhs);
+      Eigen::Map<Rhs> out(x + i * rhs_stride, n, nrhs);
+      if (positive_definite) {
+        llt.compute(m);
+        if (llt.info() != Eigen::Success) {
+          failure.record(i);
+          continue;
+        }
+        out = llt.solve(rhs);
+      } else {
+        lu.compute(m);
+        // Same pivot threshold as solve_dense's Eigen path.
+        if (!(lu.matrixLU().diagonal().cwiseAbs().minCoeff() >= 1e-15)) {
+          failure.record(i);
+          continue;
+        }
+        out = lu.solve(rhs);
+      }
+    }
+  }
+  return failure.index();
+}
+
+}  // namespace
+
+void batched_eigh(const double *a, std::int64_t batch, int n, bool lower, bool eigenvectors,
+                  const std::string &method, double *w, double *v) {
+  if (method != "auto" && method != "direct" && method != "iterative") {
+    throw std::invalid_argument("method must be one of: auto, direct, iterative");
+  }
+  if (method == "direct" && n > 3) {
+    throw std::invalid_argument("method='direct' is only available for n <= 3");
+  }
+  if (batch == 0 || n == 0) {
+    return;
+  }
+  // The closed form loses relative accuracy on clustered eigenvalues; "iterative" keeps QL.
+  const bool direct = method != "iterative" && n <= 3;
+  switch (n) {
+    case 2:
+      return eigh_batch<2>(a, batch, n, lower, eigenvectors, direct, w, v);
+    case 3:
+      return eigh_batch<3>(a, batch, n, lower, eigenvectors, direct, w, v);
+    case 4:
+      return eigh_batch<4>(a, batch, n, lower, eigenvectors, direct, w, v);
+    case 5:
+      return eigh_batch<5>(a, batch, n, lower, eigenvectors, direct, w, v);
+    case 6:
+      return eigh_batch<6>(a, batch, n, lower, eigenvectors, direct, w, v);
+    default:
+      return eigh_batch<Eigen::Dynamic>(a, batch, n, lower, eigenvectors, direct, w, v);
+  }
+}
+
+void batched_solve(const double *a, const double *b, std::int64_t batch, int n, std::int64_t nrhs,
+                   bool positive_definite, double *x) {
+  if (batch == 0 || n == 0 || nrhs == 0) {
+    return;
+  }
+  std::int64_t failed = -1;
+  switch (n) {
+    case 2:
+      failed = solve_batch<2>(a, b, batch, n, nrhs, positive_definite, x);
+      break;
+    case 3:
+      failed = solve_batch<3>(a, b, batch, n, nrhs, positive_definite, x);
+      break;
+    case 4:
+      failed = solve_batch<4>(a, b, batch, n, nrhs, positive_definite, x);
+      break;
+    case 5:
+      failed = solve_batch<5>(a, b, batch, n, nrhs, positive_definite, x);
+      break;
+    case 6:
+      failed = solve_batch<6>(a, b, batch, n, nrhs, positive_definite, x);
+      break;
+    default:
+      failed = solve_batch<Eigen::Dynamic>(a, b, batch, n, nrhs, positive_definite, x);
+      break;
+  }
+  if (failed >= 0) {
+    throw std::invalid_argument("matrix " + std::to_string(failed) + " in batch is " +
+                                (positive_definite ? "not positive definite" : "singular or ill-conditioned"));
+  }
+}
+
+}  // namespace peigen
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "core/common.h"
+
+namespace peigen {
+
+// Batched routines over `batch` contiguous row-major n x n matrices. Sizes 2..6 dispatch to
+// fixed-size Eigen kernels (stack storage, fully unrolled); other sizes use the same loop
+// with dynamic-size matrices. The batch is split across OpenMP threads when available.
+
+// Symmetric eigendecomposition of each matrix, reading only the `lower` (or upper) triangle.
+// w is batch x n (ascending), v is batch x n x n with eigenvectors in columns (ignored when
+// eigenvectors is false). method: auto (closed form for n <= 3), direct (closed form; n <= 3
+// only) or iterative (tridiagonal QL).
+void batched_eigh(const double *a, std::int64_t batch, int n, bool lower, bool eigenvectors,
+                  const std::string &method, double *w, double *v);
+
+// Solves A_i X_i = B_i with b and x of shape batch x n x nrhs. positive_definite selects LLT,
+// otherwise partial-pivot LU. Throws std::invalid_argument naming the first singular (or
+// non-positive-definite) matrix; x is unspecified in that case.
+void batched_solve(const double *a, const double *b, std::int64_t batch, int n, std::int64_t nrhs,
+                   bool positive_definite, double *x);
+
+}  // namespace peigen
@@ -0,0 +1,219 @@
+#include "core/cholesky.h"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include <Eigen/Dense>
+
+#include "core/lapack.h"
+
+namespace peigen {
+
+namespace {
+
+void check_update_args(const Eigen::Ref<const ColMatrix> &u, Eigen::Index n, double sigma) {
+  if (u.rows() != n) {
+    throw std::invalid_argument("factor and u shape mismatch");
+  }
+  if (!std::isfinite(sigma) || !u.allFinite()) {
+    throw std::invalid_argument("u and sigma must be finite");
+  }
+}
+
+// For B = R^T R and Q = R^-T U, B - U U^T is positive definite iff I - Q^T Q is (the
+// LINPACK dchdd test, k columns at once). Pivots below a rounding-level margin count as
+// failures so the update sweep that follows cannot hit a non-positive diagonal.
+bool downdate_keeps_definite(const ColMatrix &q) {
+  ColMatrix s = -(q.transpose() * q);
+  s.diagonal().array() += 1.0;
+  Eigen::LLT<ColMatrix> llt(s);
+  if (llt.info() != Eigen::Success) {
+    return false;
+  }
+  const double margin = static_cast<double>(q.rows()) * std::numeric_limits<double>::epsilon();
+  return llt.matrixLLT().diagonal().cwiseAbs2().minCoeff() > margin;
+}
+
+// Rank-k form of Eigen's llt_rank_update_lower: column j of L receives all k rank-1
+// corrections before moving on, so L is streamed through once instead of k times while w
+// (n x k, overwritten) is read as in k separate sweeps. Returns the first column whose new
+// diagonal would not be positive, or -1.
+Eigen::Index rank_update_lower(ColMatrix &l, ColMatrix &w, double sigma) {
+  const Eigen::Index n = l.rows();
+  const Eigen::Index k = w.cols();
+  Eigen::VectorXd beta = Eigen::VectorXd::Ones(k);
+  for (Eigen::Index j = 0; j < n; ++j) {
+    const Eigen::Index rest = n - j - 1;
+    for (Eigen::Index p = 0; p < k; ++p) {
+      const double ljj = l(j, j);
+      const double dj = ljj * ljj;
+      const double wj = w(j, p);
+      const double swj2 = sigma * wj * wj;
+      const double gamma = dj * beta(p) + swj2;
+      const double x = dj + swj2 / beta(p);
+      if (!(x > 0.0)) {
+        return j;
+      }
+      const double new_ljj = std::sqrt(x);
+      l(j, j) = new_ljj;
+      beta(p) += swj2 / dj;
+      if (rest > 0) {
+        w.col(p).tail(rest) -= (wj / ljj) * l.col(j).tail(rest);
+        if (gamma != 0.0) {
+          l.col(j).tail(rest) =
+              (new_ljj / ljj) * l.col(j).tail(rest) + (new_ljj * sigma * wj / gamma) * w.col(p).tail(rest);
+        }
+      }
+    }
+  }
+  return -1;
+}
+
+constexpr const char *kInvalidFactor = "factor was invalidated by a failed downdate and must be recomputed";
+
+}  // namespace
+
+CholeskyFactor::CholeskyFactor(const Eigen::Ref<const ColMatrix> &b, bool lower) {
+  if (b.rows() != b.cols()) {
+    throw std::invalid_argument("b must be square");
+  }
+  // Only the lower triangle is factored; the transpose moves an upper one there.
+  if (lower) {
+    l_ = b;
+  } else {
+    l_ = b.transpose();
+  }
+  if (l_.rows() == 0) {
+    return;
+  }
+#if defined(PEIGEN_LAPACK_ENABLED)
+  char uplo = 'L';
+  lapack_int n = static_cast<lapack_int>(l_.rows());
+  lapack_int lda = static_cast<lapack_int>(l_.outerStride());
+  lapack_int info = 0;
+  BLASFUNC(dpotrf)(&uplo, &n, l_.data(), &lda, &info);
+  if (info < 0) {
+    throw std::runtime_error("LAPACK dpotrf failed with info=" + std::to_string(info));
+  }
+  const bool ok = info == 0;
+#else
+  Eigen::LLT<Eigen::Ref<ColMatrix>> llt(l_);
+  const bool ok = llt.info() == Eigen::Success;
+#endif
+  if (!ok) {
+    throw std::invalid_argument("matrix is not positive definite");
+  }
+  l_.triangularView<Eigen::StrictlyUpper>().setZero();
+}
+
+void CholeskyFactor::check_valid() const {
+  if (!valid_) {
+    throw std::runtime_error(kInvalidFactor);
+  }
+}
+
+const ColMatrix &CholeskyFactor::matrix_l() const {
+  check_valid();
+  return l_;
+}
+
+ColMatrix CholeskyFactor::solve(ColMatrix rhs) const {
+  check_valid();
+  if (rhs.rows() != l_.rows()) {
+    throw std::invalid_argument("factor and rhs shape mismatch");
+  }
+  l_.triangularView<Eigen::Lower>().solveInPlace(rhs);
+  l_.transpose().triangularView<Eigen::Upper>().solveInPlace(rhs);
+  return rhs;
+}
+
+void CholeskyFactor::update(const Eigen::Ref<const ColMatrix> &u, double sigma) {
+  check_valid();
+  check_update_args(u, size(), sigma);
+  if (u.cols() == 0 || size() == 0 || sigma == 0.0) {
+    return;
+  }
+  ColMatrix w = u;
+  if (sigma < 0.0) {
+    ColMatrix q = l_.triangularView<Eigen::Lower>().solve(w);
+    q *= std::sqrt(-sigma);
+    if (!downdate_keeps_definite(q)) {
+      throw std::invalid_argument("downdate would make the matrix not positive definite");
+    }
+  }
+  if (rank_update_lower(l_, w, sigma) >= 0) {
+    valid_ = false;
+    throw std::runtime_error(kInvalidFactor);
+  }
+}
+
+LDLTFactor::LDLTFactor(const Eigen::Ref<const ColMatrix> &a, bool lower) {
+  if (a.rows() != a.cols()) {
+    throw std::invalid_argument("a must be square");
+  }
+  // LDLT reads the lower triangle; the transpose moves an upper one there.
+  if (lower) {
+    ldlt_.compute(a);
+  } else {
+    ldlt_.compute(a.transpose());
+  }
+  // Eigen reports NumericalIssue when a zero pivot is followed by a nonzero one, i.e. the
+  // matrix needed a 2x2 pivot.
+  if (ldlt_.info() != Eigen::Success || !ldlt_.vectorD().allFinite()) {
+    throw std::invalid_argument("LDLT factorization failed: the matrix needs 2x2 pivoting");
+  }
+}
+
+bool LDLTFactor::positive_definite() const {
+  check_valid();
+  return size() == 0 || ldlt_.vectorD().minCoeff() > 0.0;
+}
+
+void LDLTFactor::check_valid() const {
+  if (!valid_) {
+    throw std::runtime_error(kInvalidFactor);
+  }
+}
+
+ColMatrix LDLTFactor::solve(ColMatrix rhs) const {
+  check_valid();
+  if (rhs.rows() != size()) {
+    throw std::invalid_argument("factor and rhs shape mismatch");
+  }
+  return ldlt_.solve(rhs);
+}
+
+// Eigen only provides rank-1 LDLT updates, so the k columns are applied in turn.
+void LDLTFactor::update(const Eigen::Ref<const ColMatrix> &u, double sigma) {
+  check_valid();
+  check_update_args(u, size(), sigma);
+  if (u.cols() == 0 || size() == 0 || sigma == 0.0) {
+    return;
+  }
+  // rankUpdate divides by each pivot and silently stops at the first zero one.
+  if ((ldlt_.vectorD().array() == 0.0).any()) {
+    throw std::invalid_argument("update requires a factor without zero pivots");
+  }
+  const bool definite = positive_definite();
+  if (sigma < 0.0 && definite) {
+    // With A = P^T L D L^T P the check runs on Q = D^-1/2 L^-1 P U.
+    ColMatrix q = ldlt_.transpositionsP() * u;
+    ldlt_.matrixL().solveInPlace(q);
+    q = (ldlt_.vectorD().array().rsqrt() * std::sqrt(-sigma)).matrix().asDiagonal() * q;
+    if (!downdate_keeps_definite(q)) {
+      throw std::invalid_argument("downdate would make the matrix not positive definite");
+    }
+  }
+  for (Eigen::Index col = 0; col < u.cols(); ++col) {
+    ldlt_.rankUpdate(u.col(col), sigma);
+  }
+  const Eigen::ArrayXd d = ldlt_.vectorD();
+  if (!d.allFinite() || (d == 0.0).any() || (definite && !(d.minCoeff() > 0.0))) {
+    valid_ = false;
+    throw std::runtime_error(kInvalidFactor);
+  }
+}
+
+}  // namespace peigen
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <Eigen/Cholesky>
+
+#include "core/common.h"
+
+namespace peigen {
+
+// Dense Cholesky factor B = L L^T of a symmetric positive definite matrix, kept so the O(n^3)
+// factorization is paid once per B (generalized eigenproblems with a fixed mass matrix,
+// repeated solves, low-rank updates). Built with dpotrf when LAPACK is linked, Eigen LLT
+// otherwise; solves go through two triangular solves (dtrsm with BLAS). Concurrent solve()
+// calls are safe; update() must not run concurrently with any other use.
+class CholeskyFactor {
+ public:
+  // Reads the `lower` (or upper) triangle of b only. Throws std::invalid_argument when b is
+  // not square or not positive definite.
+  explicit CholeskyFactor(const Eigen::Ref<const ColMatrix> &b, bool lower = true);
+
+  Eigen::Index size() const { return l_.rows(); }
+
+  // L with a zero strict upper triangle.
+  const ColMatrix &matrix_l() const;
+
+  // Returns B^{-1} rhs.
+  ColMatrix solve(ColMatrix rhs) const;
+
+  // Refactors B + sigma U U^T in O(k n^2) for U of shape n x k, sweeping L once with all k
+  // columns (the rank-1 algorithm of LLT::rankUpdate applied per column of L). A downdate
+  // (sigma < 0) is checked first: if B + sigma U U^T would not be positive definite,
+  // std::invalid_argument is thrown and the factor is unchanged.
+  void update(const Eigen::Ref<const ColMatrix> &u, double sigma);
+
+ private:
+  void check_valid() const;
+
+  ColMatrix l_;
+  // Cleared if a downdate that passed the check still hits a non-positive pivot to rounding.
+  bool valid_ = true;
+};
+
+// Pivoted LDL^T factor P^T L D L^T P of a symmetric matrix (Eigen LDLT, square-root free).
+// Unlike CholeskyFactor, A may be indefinite or semidefinite: D then holds negative or zero
+// pivots. Eigen pivots on the diagonal only (no 2x2 blocks as in dsytrf), so a matrix
+// whose remaining diagonal vanishes before its off-diagonal part (e.g. [[0, 1], [1, 0]])
+// cannot be factored. Solves treat zero pivots through the pseudo-inverse of D.
+class LDLTFactor {
+ public:
+  // Throws std::invalid_argument when a is not square or needs a 2x2 pivot.
+  explicit LDLTFactor(const Eigen::Ref<const ColMatrix> &a, bool lower = true);
+
+  Eigen::Index size() const { return ldlt_.rows(); }
+
+  // True when every pivot of D is positive.
+  bool positive_definite() const;
+
+  ColMatrix solve(ColMatrix rhs) const;
+
+  // Refactors A + sigma U U^T with LDLT::rankUpdate, one column at a time. The pivots must
+  // be nonzero (std::invalid_argument otherwise). A downdate of a positive definite factor
+  // gets CholeskyFactor's definiteness check; an indefinite factor is updated as given, and
+  // a pivot that becomes zero or non-finite invalidates it.
+  void update(const Eigen::Ref<const ColMatrix> &u, double sigma);
+
+ private:
+  void check_valid() const;
+
+  Eigen::LDLT<ColMatrix> ldlt_;
+  bool valid_ = true;
+};
+
+}  // namespace peigen
@@ -0,0 +1,19 @@
+#pragma once
+
+// Shared types for the pybind11-free compute layer. Everything under src/core is linked
+// into both the Python extension and the native benchmark executable, so errors are
+// reported with standard exceptions: std::invalid_argument for bad input (surfaced as
+// ValueError by pybind11) and std::runtime_error for numerical failures.
+
+#include <Eigen/Core>
+#include <Eigen/Sparse>
+
+namespace peigen {
+
+using RowMatrix = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+using ColMatrix = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor>;
+using Vector = Eigen::Matrix<double, Eigen::Dynamic, 1>;
+using Sparse = Eigen::SparseMatrix<double, Eigen::ColMajor, int>;
+using RowSparse = Eigen::SparseMatrix<double, Eigen::RowMajor, int>;
+
+}  // namespace peigen
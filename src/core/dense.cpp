@@ -0,0 +1,880 @@
+#include "core/dense.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include "core/cholesky.h"
+#include "core/dispatch.h"
+#include "core/factor_cache.h"
+#include "core/lapack.h"
+
+namespace peigen {
+
+std::string resolve_svd_method(const std::string &method) {
+  if (method == "auto") {
+#if defined(PEIGEN_LAPACK_ENABLED)
+    return "lapack";
+#else
+    return "bdcsvd";
+#endif
+  }
+  if (method == "bdcsvd" || method == "lapack") {
+#if !defined(PEIGEN_LAPACK_ENABLED)
+    if (method == "lapack") {
+      throw std::invalid_argument("LAPACK SVD requested but this build was compiled without LAPACK support");
+    }
+#endif
+    return method;
+  }
+  throw std::invalid_argument("method must be one of: auto, bdcsvd, lapack");
+}
+
+static SvdFactors compute_svd_bdcsvd(const ColMatrix &matrix, bool full_matrices) {
+  if (full_matrices) {
+    Eigen::BDCSVD<ColMatrix, Eigen::ComputeFullU | Eigen::ComputeFullV> svd(matrix);
+    if (svd.info() != Eigen::Success) {
+      throw std::runtime_error("BDCSVD failed");
+    }
+    SvdFactors out;
+    out.u = svd.matrixU();
+    out.s = svd.singularValues();
+    out.vt = svd.matrixV().adjoint();
+    return out;
+  }
+
+  Eigen::BDCSVD<ColMatrix, Eigen::ComputeThinU | Eigen::ComputeThinV> svd(matrix);
+  if (svd.info() != Eigen::Success) {
+    throw std::runtime_error("BDCSVD failed");
+  }
+
+  SvdFactors out;
+  out.u = svd.matrixU();
+  out.s = svd.singularValues();
+  out.vt = svd.matrixV().adjoint();
+  return out;
+}
+
+#if defined(PEIGEN_LAPACK_ENABLED)
+static SvdFactors compute_svd_lapack(ColMatrix matrix, bool full_matrices) {
+  lapack_int m = static_cast<lapack_int>(matrix.rows());
+  lapack_int n = static_cast<lapack_int>(matrix.cols());
+  const lapack_int k = std::min(m, n);
+  char jobz = full_matrices ? 'A' : 'S';
+
+  SvdFactors out;
+  out.s = Eigen::VectorXd::Zero(k);
+
+  const lapack_int u_cols = (jobz == 'A') ? m : k;
+  const lapack_int vt_rows = (jobz == 'A') ? n : k;
+  out.u = ColMatrix::Zero(m, u_cols);
+  ColMatrix vt = ColMatrix::Zero(vt_rows, n);
+
+  lapack_int lda = static_cast<lapack_int>(matrix.outerStride());
+  lapack_int ldu = static_cast<lapack_int>(out.u.outerStride());
+  lapack_int ldvt = static_cast<lapack_int>(vt.outerStride());
+  lapack_int lwork = -1;
+  double work_query = 0.0;
+  lapack_int info = 0;
+  std::vector<lapack_int> iwork(static_cast<std::size_t>(8) * static_cast<std::size_t>(k));
+
+  BLASFUNC(dgesdd)(&jobz, &m, &n, matrix.data(), &lda, out.s.data(), out.u.data(), &ldu, vt.data(), &ldvt,
+                   &work_query, &lwork, iwork.data(), &info);
+  if (info != 0) {
+    throw std::runtime_error("LAPACK dgesdd workspace query failed with info=" + std::to_string(info));
+  }
+
+  lwork = static_cast<lapack_int>(work_query);
+  std::vector<double> work(static_cast<std::size_t>(lwork));
+
+  BLASFUNC(dgesdd)(&jobz, &m, &n, matrix.data(), &lda, out.s.data(), out.u.data(), &ldu, vt.data(), &ldvt,
+                   work.data(), &lwork, iwork.data(), &info);
+  if (info != 0) {
+    throw std::runtime_error("LAPACK dgesdd failed with info=" + std::to_string(info));
+  }
+
+  out.vt = vt;
+  return out;
+}
+#endif
+
+SvdFactors compute_svd(const ColMatrix &matrix, bool full_matrices, const std::string &method) {
+  const std::string resolved = resolve_svd_method(method);
+  if (resolved == "lapack") {
+#if defined(PEIGEN_LAPACK_ENABLED)
+    return compute_svd_lapack(matrix, full_matrices);
+#else
+    throw std::invalid_argument("LAPACK SVD requested but LAPACK is unavailable in this build");
+#endif
+  }
+  return compute_svd_bdcsvd(matrix, full_matrices);
+}
+
+std::string resolve_eigh_method(const std::string &method) {
+  if (method == "auto") {
+#if defined(PEIGEN_LAPACK_ENABLED)
+    return "lapack";
+#else
+    return "eigen";
+#endif
+  }
+  if (method == "eigen" || method == "lapack") {
+#if !defined(PEIGEN_LAPACK_ENABLED)
+    if (method == "lapack") {
+      throw std::invalid_argument("LAPACK eigh requested but this build was compiled without LAPACK support");
+    }
+#endif
+    return method;
+  }
+  throw std::invalid_argument("method must be one of: auto, eigen, lapack");
+}
+
+std::string resolve_lapack_eigen_method(const std::string &method, const char *routine) {
+  if (method == "auto") {
+#if defined(PEIGEN_LAPACK_ENABLED)
+    return "lapack";
+#else
+    return "eigen";
+#endif
+  }
+  if (method == "eigen" || method == "lapack") {
+#if !defined(PEIGEN_LAPACK_ENABLED)
+    if (method == "lapack") {
+      throw std::invalid_argument(std::string("LAPACK ") + routine +
+                            " requested but this build was compiled without LAPACK support");
+    }
+#endif
+    return method;
+  }
+  throw std::invalid_argument("method must be one of: auto, eigen, lapack");
+}
+
+ColMatrix dense_col_from_row_ref(const Eigen::Ref<const RowMatrix> &rhs) {
+  ColMatrix out(rhs.rows(), rhs.cols());
+  out = rhs;
+  return out;
+}
+
+void gemm(const Eigen::Ref<const RowMatrix> &lhs, const Eigen::Ref<const RowMatrix> &rhs, Eigen::Map<RowMatrix> out) {
+  if (lhs.cols() != rhs.rows()) {
+    throw std::invalid_argument("matmul dimension mismatch");
+  }
+#if defined(EIGEN_USE_BLAS)
+  out.noalias() = lhs * rhs;
+#else
+  kernels().gemm(lhs.data(), rhs.data(), out.data(), lhs.rows(), lhs.cols(), rhs.cols());
+#endif
+}
+
+void gram(const Eigen::Ref<const RowMatrix> &a, bool trans, bool lower, bool mirror, Eigen::Map<RowMatrix> out) {
+  const Eigen::Index n = trans ? a.cols() : a.rows();
+  if (out.rows() != n || out.cols() != n) {
+    throw std::invalid_argument("gram output shape mismatch");
+  }
+  out.setZero();
+  // rankUpdate(u) adds u u^T, so a^T a uses u = a^T.
+  if (lower) {
+    if (trans) {
+      out.selfadjointView<Eigen::Lower>().rankUpdate(a.transpose());
+    } else {
+      out.selfadjointView<Eigen::Lower>().rankUpdate(a);
+    }
+  } else if (trans) {
+    out.selfadjointView<Eigen::Upper>().rankUpdate(a.transpose());
+  } else {
+    out.selfadjointView<Eigen::Upper>().rankUpdate(a);
+  }
+  if (!mirror) {
+    return;
+  }
+  for (Eigen::Index i = 0; i < n; ++i) {
+    for (Eigen::Index j = i + 1; j < n; ++j) {
+      if (lower) {
+        out(i, j) = out(j, i);
+      } else {
+        out(j, i) = out(i, j);
+      }
+    }
+  }
+}
+
+template <unsigned Mode>
+static void triangular_multiply_mode(const Eigen::Ref<const RowMatrix> &a, const Eigen::Ref<const RowMatrix> &b,
+                                     bool left, Eigen::Map<RowMatrix> out) {
+  if (left) {
+    out.noalias() = a.triangularView<Mode>() * b;
+  } else {
+    out.noalias() = b * a.triangularView<Mode>();
+  }
+}
+
+static void check_structured_operands(const Eigen::Ref<const RowMatrix> &a, const Eigen::Ref<const RowMatrix> &b,
+                                      bool left, const Eigen::Map<RowMatrix> &out, const char *routine) {
+  if (a.rows() != a.cols()) {
+    throw std::invalid_argument(std::string(routine) + " requires square a");
+  }
+  if ((left ? b.rows() : b.cols()) != a.rows()) {
+    throw std::invalid_argument(std::string(routine) + " dimension mismatch");
+  }
+  if (out.rows() != b.rows() || out.cols() != b.cols()) {
+    throw std::invalid_argument(std::string(routine) + " output shape mismatch");
+  }
+}
+
+void triangular_multiply(const Eigen::Ref<const RowMatrix> &a, const Eigen::Ref<const RowMatrix> &b, bool lower,
+                         bool unit_diagonal, bool left, Eigen::Map<RowMatrix> out) {
+  check_structured_operands(a, b, left, out, "trmm");
+  if (lower) {
+    if (unit_diagonal) {
+      triangular_multiply_mode<Eigen::UnitLower>(a, b, left, out);
+    } else {
+      triangular_multiply_mode<Eigen::Lower>(a, b, left, out);
+    }
+  } else if (unit_diagonal) {
+    triangular_multiply_mode<Eigen::UnitUpper>(a, b, left, out);
+  } else {
+    triangular_multiply_mode<Eigen::Upper>(a, b, left, out);
+  }
+}
+
+void symmetric_multiply(const Eigen::Ref<const RowMatrix> &a, const Eigen::Ref<const RowMatrix> &b, bool lower,
+                        bool left, Eigen::Map<RowMatrix> out) {
+  check_structured_operands(a, b, left, out, "symm");
+  if (lower) {
+    if (left) {
+      out.noalias() = a.selfadjointView<Eigen::Lower>() * b;
+    } else {
+      out.noalias() = b * a.selfadjointView<Eigen::Lower>();
+    }
+  } else if (left) {
+    out.noalias() = a.selfadjointView<Eigen::Upper>() * b;
+  } else {
+    out.noalias() = b * a.selfadjointView<Eigen::Upper>();
+  }
+}
+
+static EighFactors compute_eigh_eigen(const ColMatrix &matrix, bool lower, bool eigenvectors) {
+  const unsigned options = eigenvectors ? Eigen::ComputeEigenvectors : Eigen::EigenvaluesOnly;
+  Eigen::SelfAdjointEigenSolver<ColMatrix> solver;
+  if (lower) {
+    solver.compute(matrix, options);
+  } else {
+    solver.compute(matrix.selfadjointView<Eigen::Upper>(), options);
+  }
+
+  if (solver.info() != Eigen::Success) {
+    throw std::runtime_error("SelfAdjointEigenSolver failed");
+  }
+
+  EighFactors out;
+  out.w = solver.eigenvalues();
+  if (eigenvectors) {
+    out.v = solver.eigenvectors();
+  }
+  return out;
+}
+
+#if defined(PEIGEN_LAPACK_ENABLED)
+static void lapack_dsyev_values(ColMatrix &matrix, bool lower, Eigen::VectorXd &w) {
+  lapack_int n = static_cast<lapack_int>(matrix.rows());
+  char jobz = 'N';
+  char uplo = lower ? 'L' : 'U';
+  lapack_int lda = static_cast<lapack_int>(matrix.outerStride());
+  lapack_int lwork = -1;
+  lapack_int info = 0;
+  double work_query = 0.0;
+
+  BLASFUNC(dsyev)(&jobz, &uplo, &n, matrix.data(), &lda, w.data(), &work_query, &lwork, &info);
+  if (info != 0) {
+    throw std::runtime_error("LAPACK dsyev workspace query failed with info=" + std::to_string(info));
+  }
+
+  lwork = static_cast<lapack_int>(work_query);
+  std::vector<double> work(static_cast<std::size_t>(lwork));
+
+  BLASFUNC(dsyev)(&jobz, &uplo, &n, matrix.data(), &lda, w.data(), work.data(), &lwork, &info);
+  if (info != 0) {
+    throw std::runtime_error("LAPACK dsyev failed with info=" + std::to_string(info));
+  }
+}
+
+static bool lapack_dsyevr_values(ColMatrix &matrix, bool lower, Eigen::VectorXd &w) {
+  lapack_int n = static_cast<lapack_int>(matrix.rows());
+  char jobz = 'N';
+  char range = 'A';
+  char uplo = lower ? 'L' : 'U';
+  lapack_int lda = static_cast<lapack_int>(matrix.outerStride());
+  double vl = 0.0;
+  double vu = 0.0;
+  lapack_int il = 1;
+  lapack_int iu = n;
+  double abstol = 0.0;
+  lapack_int m = 0;
+  lapack_int ldz = 1;
+  lapack_int lwork = -1;
+  lapack_int liwork = -1;
+  lapack_int info = 0;
+  double work_query = 0.0;
+  lapack_int iwork_query = 0;
+
+  BLASFUNC(dsyevr)(&jobz, &range, &uplo, &n, matrix.data(), &lda, &vl, &vu, &il, &iu, &abstol, &m, w.data(),
+                   nullptr, &ldz, nullptr, &work_query, &lwork, &iwork_query, &liwork, &info);
+  if (info != 0) {
+    return false;
+  }
+
+  lwork = static_cast<lapack_int>(work_query);
+  liwork = iwork_query;
+  std::vector<double> work(static_cast<std::size_t>(lwork));
+  std::vector<lapack_int> iwork(static_cast<std::size_t>(liwork));
+
+  BLASFUNC(dsyevr)(&jobz, &range, &uplo, &n, matrix.data(), &lda, &vl, &vu, &il, &iu, &abstol, &m, w.data(),
+                   nullptr, &ldz, nullptr, work.data(), &lwork, iwork.data(), &liwork, &info);
+  if (info != 0 || m != n) {
+    return false;
+  }
+  return true;
+}
+
+static EighFactors compute_eigh_lapack_vals(ColMatrix matrix, bool lower) {
+  if (matrix.rows() != matrix.cols()) {
+    throw std::invalid_argument("eigh requires square matrix");
+  }
+
+  const lapack_int n = static_cast<lapack_int>(matrix.rows());
+  EighFactors out;
+  out.w = Eigen::VectorXd::Zero(n);
+
+  if (!lapack_dsyevr_values(matrix, lower, out.w)) {
+    lapack_dsyev_values(matrix, lower, out.w);
+  }
+  return out;
+}
+
+static EighFactors compute_eigh_lapack(ColMatrix matrix, bool lower, bool eigenvectors) {
+  if (matrix.rows() != matrix.cols()) {
+    throw std::invalid_argument("eigh requires square matrix");
+  }
+
+  if (!eigenvectors) {
+    return compute_eigh_lapack_vals(matrix, lower);
+  }
+
+  lapack_int n = static_cast<lapack_int>(matrix.rows());
+  char jobz = 'V';
+  char uplo = lower ? 'L' : 'U';
+  lapack_int lda = static_cast<lapack_int>(matrix.outerStride());
+  lapack_int lwork = -1;
+  lapack_int liwork = -1;
+  double work_query = 0.0;
+  lapack_int iwork_query = 0;
+  lapack_int info = 0;
+
+  EighFactors out;
+  out.w = Eigen::VectorXd::Zero(n);
+
+  BLASFUNC(dsyevd)(&jobz, &uplo, &n, matrix.data(), &lda, out.w.data(), &work_query, &lwork, &iwork_query,
+                   &liwork, &info);
+  if (info != 0) {
+    throw std::runtime_error("LAPACK dsyevd workspace query failed with info=" + std::to_string(info));
+  }
+
+  lwork = static_cast<lapack_int>(work_query);
+  liwork = iwork_query;
+  std::vector<double> work(static_cast<std::size_t>(lwork));
+  std::vector<lapack_int> iwork(static_cast<std::size_t>(liwork));
+
+  BLASFUNC(dsyevd)(&jobz, &uplo, &n, matrix.data(), &lda, out.w.data(), work.data(), &lwork, iwork.data(), &liwork,
+                   &info);
+  if (info != 0) {
+    throw std::runtime_error("LAPACK dsyevd failed with info=" + std::to_string(info));
+  }
+
+  out.v = std::move(matrix);
+  return out;
+}
+#endif
+
+EighFactors compute_eigh(const ColMatrix &matrix, bool lower, bool eigenvectors,
+                                const std::string &method) {
+  const std::string resolved = resolve_eigh_method(method);
+  if (resolved == "lapack") {
+#if defined(PEIGEN_LAPACK_ENABLED)
+    return compute_eigh_lapack(matrix, lower, eigenvectors);
+#else
+    throw std::invalid_argument("LAPACK eigh requested but LAPACK is unavailable in this build");
+#endif
+  }
+  return compute_eigh_eigen(matrix, lower, eigenvectors);
+}
+
+static void check_generalized_eigh_args(const ColMatrix &a, Eigen::Index b_size, int type, Eigen::Index il,
+                                        Eigen::Index iu) {
+  if (a.rows() != a.cols()) {
+    throw std::invalid_argument("eigh requires square matrix");
+  }
+  if (b_size != a.rows()) {
+    throw std::invalid_argument("a and b shape mismatch");
+  }
+  if (type < 1 || type > 3) {
+    throw std::invalid_argument("type must be 1, 2 or 3");
+  }
+  if (il >= 0 && !(il <= iu && iu < a.rows())) {
+    throw std::invalid_argument("subset_by_index must satisfy 0 <= lo <= hi < n");
+  }
+}
+
+static void select_eigenpairs(EighFactors &factors, Eigen::Index il, Eigen::Index iu, bool eigenvectors) {
+  if (il < 0) {
+    return;
+  }
+  const Eigen::Index count = iu - il + 1;
+  factors.w = factors.w.segment(il, count).eval();
+  if (eigenvectors) {
+    factors.v = factors.v.middleCols(il, count).eval();
+  }
+}
+
+#if defined(PEIGEN_LAPACK_ENABLED)
+static void check_sygv_info(const char *routine, lapack_int info, lapack_int n) {
+  // info > n: the leading minor of order info - n of B is not positive definite.
+  if (info > n) {
+    throw std::invalid_argument("matrix is not positive definite");
+  }
+  if (info != 0) {
+    throw std::runtime_error(std::string("LAPACK ") + routine + " failed with info=" + std::to_string(info));
+  }
+}
+
+static EighFactors compute_generalized_eigh_lapack(ColMatrix a, ColMatrix b, int type, bool lower, bool eigenvectors,
+                                                   Eigen::Index il, Eigen::Index iu) {
+  lapack_int itype = type;
+  lapack_int n = static_cast<lapack_int>(a.rows());
+  char jobz = eigenvectors ? 'V' : 'N';
+  char uplo = lower ? 'L' : 'U';
+  lapack_int lda = static_cast<lapack_int>(a.outerStride());
+  lapack_int ldb = static_cast<lapack_int>(b.outerStride());
+  lapack_int lwork = -1;
+  lapack_int info = 0;
+  double work_query = 0.0;
+
+  EighFactors out;
+  out.w = Eigen::VectorXd::Zero(n);
+
+  if (il < 0) {
+    lapack_int liwork = -1;
+    lapack_int iwork_query = 0;
+    BLASFUNC(dsygvd)(&itype, &jobz, &uplo, &n, a.data(), &lda, b.data(), &ldb, out.w.data(), &work_query, &lwork,
+                     &iwork_query, &liwork, &info);
+    if (info != 0) {
+      throw std::runtime_error("LAPACK dsygvd workspace query failed with info=" + std::to_string(info));
+    }
+    lwork = static_cast<lapack_int>(work_query);
+    liwork = iwork_query;
+    std::vector<double> work(static_cast<std::size_t>(lwork));
+    std::vector<lapack_int> iwork(static_cast<std::size_t>(liwork));
+    BLASFUNC(dsygvd)(&itype, &jobz, &uplo, &n, a.data(), &lda, b.data(), &ldb, out.w.data(), work.data(), &lwork,
+                     iwork.data(), &liwork, &info);
+    check_sygv_info("dsygvd", info, n);
+    if (eigenvectors) {
+      out.v = std::move(a);
+    }
+    return out;
+  }
+
+  // Bisection + inverse iteration on the reduced tridiagonal matrix: only the requested
+  // eigenvectors are computed and back-transformed.
+  char range = 'I';
+  double vl = 0.0;
+  double vu = 0.0;
+  lapack_int il_1 = static_cast<lapack_int>(il + 1);
+  lapack_int iu_1 = static_cast<lapack_int>(iu + 1);
+  double abstol = 0.0;
+  lapack_int m = 0;
+  const Eigen::Index count = iu - il + 1;
+  ColMatrix z(n, eigenvectors ? count : 1);
+  lapack_int ldz = static_cast<lapack_int>(z.outerStride());
+  std::vector<lapack_int> iwork(5 * static_cast<std::size_t>(n));
+  std::vector<lapack_int> ifail(static_cast<std::size_t>(n));
+  BLASFUNC(dsygvx)(&itype, &jobz, &range, &uplo, &n, a.data(), &lda, b.data(), &ldb, &vl, &vu, &il_1, &iu_1, &abstol,
+                   &m, out.w.data(), z.data(), &ldz, &work_query, &lwork, iwork.data(), ifail.data(), &info);
+  if (info != 0) {
+    throw std::runtime_error("LAPACK dsygvx workspace query failed with info=" + std::to_string(info));
+  }
+  lwork = static_cast<lapack_int>(work_query);
+  std::vector<double> work(static_cast<std::size_t>(lwork));
+  BLASFUNC(dsygvx)(&itype, &jobz, &range, &uplo, &n, a.data(), &lda, b.data(), &ldb, &vl, &vu, &il_1, &iu_1, &abstol,
+                   &m, out.w.data(), z.data(), &ldz, work.data(), &lwork, iwork.data(), ifail.data(), &info);
+  check_sygv_info("dsygvx", info, n);
+  out.w.conservativeResize(m);
+  if (eigenvectors) {
+    out.v = std::move(z);
+  }
+  return out;
+}
+
+// Eigenpairs il..iu (0-based) of the symmetric matrix in the lower triangle of c, which is
+// overwritten. dsyevx is the standard-problem half of dsygvx, for a pencil already reduced
+// with dsygst.
+static EighFactors lapack_dsyevx_subset(ColMatrix &c, Eigen::Index il, Eigen::Index iu, bool eigenvectors) {
+  char jobz = eigenvectors ? 'V' : 'N';
+  char range = 'I';
+  char uplo = 'L';
+  lapack_int n = static_cast<lapack_int>(c.rows());
+  lapack_int lda = static_cast<lapack_int>(c.outerStride());
+  double vl = 0.0;
+  double vu = 0.0;
+  lapack_int il_1 = static_cast<lapack_int>(il + 1);
+  lapack_int iu_1 = static_cast<lapack_int>(iu + 1);
+  double abstol = 0.0;
+  lapack_int m = 0;
+  lapack_int lwork = -1;
+  lapack_int info = 0;
+  double work_query = 0.0;
+
+  EighFactors out;
+  out.w = Eigen::VectorXd::Zero(n);
+  ColMatrix z(n, eigenvectors ? iu - il + 1 : 1);
+  lapack_int ldz = static_cast<lapack_int>(z.outerStride());
+  std::vector<lapack_int> iwork(5 * static_cast<std::size_t>(n));
+  std::vector<lapack_int> ifail(static_cast<std::size_t>(n));
+  BLASFUNC(dsyevx)(&jobz, &range, &uplo, &n, c.data(), &lda, &vl, &vu, &il_1, &iu_1, &abstol, &m, out.w.data(),
+                   z.data(), &ldz, &work_query, &lwork, iwork.data(), ifail.data(), &info);
+  if (info != 0) {
+    throw std::runtime_error("LAPACK dsyevx workspace query failed with info=" + std::to_string(info));
+  }
+  lwork = static_cast<lapack_int>(work_query);
+  std::vector<double> work(static_cast<std::size_t>(lwork));
+  BLASFUNC(dsyevx)(&jobz, &range, &uplo, &n, c.data(), &lda, &vl, &vu, &il_1, &iu_1, &abstol, &m, out.w.data(),
+                   z.data(), &ldz, work.data(), &lwork, iwork.data(), ifail.data(), &info);
+  if (info != 0) {
+    throw std::runtime_error("LAPACK dsyevx failed with info=" + std::to_string(info));
+  }
+  out.w.conservativeResize(m);
+  if (eigenvectors) {
+    out.v = std::move(z);
+  }
+  return out;
+}
+#endif
+
+EighFactors compute_generalized_eigh(const ColMatrix &a, const CholeskyFactor &b, int type, bool lower,
+                                     bool eigenvectors, const std::string &method, Eigen::Index il, Eigen::Index iu) {
+  check_generalized_eigh_args(a, b.size(), type, il, iu);
+  if (a.rows() == 0) {
+    return EighFactors{Eigen::VectorXd(0), eigenvectors ? ColMatrix(0, 0) : ColMatrix()};
+  }
+  const std::string resolved = resolve_eigh_method(method);
+  const ColMatrix &l = b.matrix_l();
+
+  // The reduction works on the lower triangle; the transpose moves an upper one there.
+  ColMatrix c = lower ? a : ColMatrix(a.transpose());
+  bool reduced = false;
+#if defined(PEIGEN_LAPACK_ENABLED)
+  if (resolved == "lapack" && c.rows() > 0) {
+    lapack_int itype = type;
+    char uplo = 'L';
+    lapack_int n = static_cast<lapack_int>(c.rows());
+    lapack_int lda = static_cast<lapack_int>(c.outerStride());
+    lapack_int ldb = static_cast<lapack_int>(l.outerStride());
+    lapack_int info = 0;
+    BLASFUNC(dsygst)(&itype, &uplo, &n, c.data(), &lda, l.data(), &ldb, &info);
+    if (info != 0) {
+      throw std::runtime_error("LAPACK dsygst failed with info=" + std::to_string(info));
+    }
+    reduced = true;
+  }
+#endif
+  if (!reduced) {
+    ColMatrix full = c.selfadjointView<Eigen::Lower>();
+    if (type == 1) {
+      // L^-1 A L^-T, using the symmetry of A for the second solve.
+      l.triangularView<Eigen::Lower>().solveInPlace(full);
+      full.transposeInPlace();
+      l.triangularView<Eigen::Lower>().solveInPlace(full);
+      c = std::move(full);
+    } else {
+      const ColMatrix al = full * l.triangularView<Eigen::Lower>();
+      c.noalias() = l.transpose().triangularView<Eigen::Upper>() * al;
+    }
+  }
+
+  EighFactors out;
+  bool selected = false;
+#if defined(PEIGEN_LAPACK_ENABLED)
+  // A strict subset is computed directly, as dsygvx does, rather than sliced from all n.
+  if (reduced && il >= 0 && iu - il + 1 < c.rows()) {
+    out = lapack_dsyevx_subset(c, il, iu, eigenvectors);
+    selected = true;
+  }
+#endif
+  if (!selected) {
+    out = compute_eigh(c, true, eigenvectors, resolved);
+    select_eigenpairs(out, il, iu, eigenvectors);
+  }
+  if (eigenvectors) {
+    if (type == 3) {
+      ColMatrix v = l.triangularView<Eigen::Lower>() * out.v;
+      out.v = std::move(v);
+    } else {
+      l.transpose().triangularView<Eigen::Upper>().solveInPlace(out.v);
+    }
+  }
+  return out;
+}
+
+EighFactors compute_generalized_eigh(const ColMatrix &a, const ColMatrix &b, int type, bool lower, bool eigenvectors,
+                                     const std::string &method, Eigen::Index il, Eigen::Index iu) {
+  if (b.rows() != b.cols()) {
+    throw std::invalid_argument("b must be square");
+  }
+  check_generalized_eigh_args(a, b.rows(), type, il, iu);
+  if (a.rows() == 0) {
+    return EighFactors{Eigen::VectorXd(0), eigenvectors ? ColMatrix(0, 0) : ColMatrix()};
+  }
+  const std::string resolved = resolve_eigh_method(method);
+  if (factor_cache_enabled()) {
+    const std::size_t n = static_cast<std::size_t>(b.rows());
+    const std::shared_ptr<const CholeskyFactor> factor = cached_factor<CholeskyFactor>(
+        dense_fingerprint(lower ? "dense_llt:lower" : "dense_llt:upper", b),
+        [&]() { return std::make_pair(std::make_shared<const CholeskyFactor>(b, lower), n * n * sizeof(double)); });
+    return compute_generalized_eigh(a, *factor, type, lower, eigenvectors, resolved, il, iu);
+  }
+  if (resolved == "lapack") {
+#if defined(PEIGEN_LAPACK_ENABLED)
+    return compute_generalized_eigh_lapack(a, b, type, lower, eigenvectors, il, iu);
+#else
+    throw std::invalid_argument("LAPACK eigh requested but LAPACK is unavailable in this build");
+#endif
+  }
+  // Same reduction as GeneralizedSelfAdjointEigenSolver, which does not report a B that is
+  // not positive definite; CholeskyFactor does.
+  return compute_generalized_eigh(a, CholeskyFactor(b, lower), type, lower, eigenvectors, resolved, il, iu);
+}
+
+#if defined(PEIGEN_LAPACK_ENABLED)
+static ColMatrix solve_lapack(ColMatrix lhs, ColMatrix rhs) {
+  lapack_int n = static_cast<lapack_int>(lhs.rows());
+  lapack_int nrhs = static_cast<lapack_int>(rhs.cols());
+  lapack_int lda = static_cast<lapack_int>(lhs.outerStride());
+  lapack_int ldb = static_cast<lapack_int>(rhs.outerStride());
+  lapack_int info = 0;
+  std::vector<lapack_int> ipiv(static_cast<std::size_t>(n));
+
+  BLASFUNC(dgesv)(&n, &nrhs, lhs.data(), &lda, ipiv.data(), rhs.data(), &ldb, &info);
+  if (info != 0) {
+    throw std::invalid_argument("matrix is singular or ill-conditioned");
+  }
+  return rhs;
+}
+#endif
+
+namespace {
+
+// LU factors kept by the factorization cache: dgetrf/dgetrs for the LAPACK path,
+// PartialPivLU otherwise. Construction throws for singular input, like the uncached solve.
+class DenseLU {
+ public:
+  DenseLU(ColMatrix lhs, bool use_lapack) : use_lapack_(use_lapack) {
+#if defined(PEIGEN_LAPACK_ENABLED)
+    if (use_lapack_) {
+      factors_ = std::move(lhs);
+      lapack_int n = static_cast<lapack_int>(factors_.rows());
+      lapack_int lda = static_cast<lapack_int>(factors_.outerStride());
+      lapack_int info = 0;
+      ipiv_.resize(static_cast<std::size_t>(n));
+      BLASFUNC(dgetrf)(&n, &n, factors_.data(), &lda, ipiv_.data(), &info);
+      if (info != 0) {
+        throw std::invalid_argument("matrix is singular or ill-conditioned");
+      }
+      return;
+    }
+#endif
+    lu_.compute(lhs);
+    if (lu_.matrixLU().diagonal().cwiseAbs().minCoeff() < 1e-15) {
+      throw std::invalid_argument("matrix is singular or ill-conditioned");
+    }
+  }
+
+  ColMatrix solve(ColMatrix rhs) const {
+#if defined(PEIGEN_LAPACK_ENABLED)
+    if (use_lapack_) {
+      char trans = 'N';
+      lapack_int n = static_cast<lapack_int>(factors_.rows());
+      lapack_int nrhs = static_cast<lapack_int>(rhs.cols());
+      lapack_int lda = static_cast<lapack_int>(factors_.outerStride());
+      lapack_int ldb = static_cast<lapack_int>(rhs.outerStride());
+      lapack_int info = 0;
+      BLASFUNC(dgetrs)(&trans, &n, &nrhs, const_cast<double *>(factors_.data()), &lda,
+                       const_cast<lapack_int *>(ipiv_.data()), rhs.data(), &ldb, &info);
+      if (info != 0) {
+        throw std::runtime_error("LAPACK dgetrs failed with info=" + std::to_string(info));
+      }
+      return rhs;
+    }
+#endif
+    return lu_.solve(rhs);
+  }
+
+ private:
+  bool use_lapack_;
+  Eigen::PartialPivLU<ColMatrix> lu_;
+#if defined(PEIGEN_LAPACK_ENABLED)
+  ColMatrix factors_;
+  std::vector<lapack_int> ipiv_;
+#endif
+};
+
+}  // namespace
+
+ColMatrix solve_dense(ColMatrix lhs, ColMatrix rhs, const std::string &method) {
+  if (lhs.rows() != lhs.cols()) {
+    throw std::invalid_argument("a must be square");
+  }
+  if (lhs.rows() != rhs.rows()) {
+    throw std::invalid_argument("a and b shape mismatch");
+  }
+
+  const std::string resolved = resolve_lapack_eigen_method(method, "solve");
+  if (factor_cache_enabled()) {
+    const Eigen::Index n = lhs.rows();
+    const bool use_lapack = resolved == "lapack";
+    const std::shared_ptr<const DenseLU> lu =
+        cached_factor<DenseLU>(dense_fingerprint("dense_lu:" + resolved, lhs), [&]() {
+          const std::size_t bytes = static_cast<std::size_t>(n) * static_cast<std::size_t>(n) * sizeof(double) +
+                                    static_cast<std::size_t>(n) * sizeof(int);
+          return std::make_pair(std::make_shared<const DenseLU>(std::move(lhs), use_lapack), bytes);
+        });
+    return lu->solve(std::move(rhs));
+  }
+  if (resolved == "lapack") {
+#if defined(PEIGEN_LAPACK_ENABLED)
+    return solve_lapack(std::move(lhs), std::move(rhs));
+#else
+    throw std::invalid_argument("LAPACK solve requested but LAPACK is unavailable in this build");
+#endif
+  }
+
+  Eigen::PartialPivLU<ColMatrix> lu(lhs);
+  if (lu.matrixLU().diagonal().cwiseAbs().minCoeff() < 1e-15) {
+    throw std::invalid_argument("matrix is singular or ill-conditioned");
+  }
+  return lu.solve(rhs);
+}
+
+namespace {
+
+using FloatMatrix = Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor>;
+using FloatVector = Eigen::Matrix<float, Eigen::Dynamic, 1>;
+
+// Single-precision LU with a uniform solve; ok() is false when the factors are singular.
+class SingleLU {
+ public:
+  SingleLU(const ColMatrix &lhs, bool use_lapack) : use_lapack_(use_lapack) {
+#if defined(PEIGEN_LAPACK_ENABLED)
+    if (use_lapack_) {
+      factors_ = lhs.cast<float>();
+      lapack_int n = static_cast<lapack_int>(factors_.rows());
+      lapack_int lda = static_cast<lapack_int>(factors_.outerStride());
+      lapack_int info = 0;
+      ipiv_.resize(static_cast<std::size_t>(n));
+      BLASFUNC(sgetrf)(&n, &n, factors_.data(), &lda, ipiv_.data(), &info);
+      ok_ = info == 0;
+      return;
+    }
+#endif
+    lu_.compute(lhs.cast<float>());
+    const float min_pivot = lhs.rows() > 0 ? lu_.matrixLU().diagonal().cwiseAbs().minCoeff() : 1.0f;
+    ok_ = min_pivot > 0.0f && std::isfinite(min_pivot);
+  }
+
+  bool ok() const { return ok_; }
+
+  void solve(const Eigen::Ref<const Vector> &rhs, Eigen::Ref<Vector> out) const {
+    FloatVector work = rhs.cast<float>();
+#if defined(PEIGEN_LAPACK_ENABLED)
+    if (use_lapack_) {
+      char trans = 'N';
+      lapack_int n = static_cast<lapack_int>(factors_.rows());
+      lapack_int nrhs = 1;
+      lapack_int lda = static_cast<lapack_int>(factors_.outerStride());
+      lapack_int ldb = n;
+      lapack_int info = 0;
+      BLASFUNC(sgetrs)(&trans, &n, &nrhs, const_cast<float *>(factors_.data()), &lda,
+                       const_cast<lapack_int *>(ipiv_.data()), work.data(), &ldb, &info);
+      if (info != 0) {
+        throw std::runtime_error("LAPACK sgetrs failed with info=" + std::to_string(info));
+      }
+      out = work.cast<double>();
+      return;
+    }
+#endif
+    out = lu_.solve(work).cast<double>();
+  }
+
+ private:
+  bool use_lapack_;
+  bool ok_ = false;
+  Eigen::PartialPivLU<FloatMatrix> lu_;
+#if defined(PEIGEN_LAPACK_ENABLED)
+  FloatMatrix factors_;
+  std::vector<lapack_int> ipiv_;
+#endif
+};
+
+}  // namespace
+
+ColMatrix solve_dense_mixed(const ColMatrix &lhs, const ColMatrix &rhs, const std::string &method,
+                            RefinementInfo &info) {
+  if (lhs.rows() != lhs.cols()) {
+    throw std::invalid_argument("a must be square");
+  }
+  if (lhs.rows() != rhs.rows()) {
+    throw std::invalid_argument("a and b shape mismatch");
+  }
+  const std::string resolved = resolve_lapack_eigen_method(method, "solve");
+  info = RefinementInfo{};
+  if (lhs.rows() == 0) {
+    return ColMatrix(0, rhs.cols());
+  }
+
+  const double a_max = lhs.cwiseAbs().maxCoeff();
+  const double b_max = rhs.size() > 0 ? rhs.cwiseAbs().maxCoeff() : 0.0;
+  if (fits_single_precision(a_max) && fits_single_precision(b_max)) {
+    const SingleLU single(lhs, resolved == "lapack");
+    if (single.ok()) {
+      const double a_norm = lhs.cwiseAbs().rowwise().sum().maxCoeff();
+      const auto apply = [&lhs](const Eigen::Ref<const Vector> &x, Eigen::Ref<Vector> y) { y.noalias() = lhs * x; };
+      const auto solve_low = [&single](const Eigen::Ref<const Vector> &r, Eigen::Ref<Vector> d) {
+        single.solve(r, d);
+      };
+      ColMatrix x(lhs.cols(), rhs.cols());
+      bool converged = true;
+      for (Eigen::Index col = 0; col < rhs.cols() && converged; ++col) {
+        converged = refine_column(apply, solve_low, a_norm, rhs.col(col), x.col(col), info);
+      }
+      if (converged) {
+        return x;
+      }
+    }
+  }
+
+  info = RefinementInfo{};
+  info.fallback = true;
+  ColMatrix x = solve_dense(lhs, rhs, method);
+  const double a_norm = lhs.cwiseAbs().rowwise().sum().maxCoeff();
+  for (Eigen::Index col = 0; col < rhs.cols(); ++col) {
+    const double scale = a_norm * x.col(col).lpNorm<Eigen::Infinity>();
+    const double r_norm = (rhs.col(col) - lhs * x.col(col)).lpNorm<Eigen::Infinity>();
+    info.backward_error = std::max(info.backward_error, scale > 0.0 ? r_norm / scale : 0.0);
+  }
+  return x;
+}
+
+}  // namespace peigen
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <string>
+
+#include "core/common.h"
+#include "core/refinement.h"
+
+namespace peigen {
+
+class CholeskyFactor;
+
+struct SvdFactors {
+  ColMatrix u;
+  Eigen::VectorXd s;
+  ColMatrix vt;
+};
+
+struct EighFactors {
+  Eigen::VectorXd w;
+  ColMatrix v;
+};
+
+std::string resolve_svd_method(const std::string &method);
+std::string resolve_eigh_method(const std::string &method);
+std::string resolve_lapack_eigen_method(const std::string &method, const char *routine);
+
+ColMatrix dense_col_from_row_ref(const Eigen::Ref<const RowMatrix> &rhs);
+
+// out (m x n) = lhs (m x k) * rhs (k x n), all row-major and contiguous. Uses BLAS when
+// linked, otherwise the dispatched kernel variant.
+void gemm(const Eigen::Ref<const RowMatrix> &lhs, const Eigen::Ref<const RowMatrix> &rhs, Eigen::Map<RowMatrix> out);
+
+// Gram matrix via a symmetric rank-k update (dsyrk when BLAS is linked): out = a^T a when
+// trans, else a a^T. Only the `lower` (or upper) triangle is computed; mirror copies it to
+// the other triangle, otherwise that triangle is zero. out must be square of matching size.
+void gram(const Eigen::Ref<const RowMatrix> &a, bool trans, bool lower, bool mirror, Eigen::Map<RowMatrix> out);
+
+// out = T(a) * b (left) or b * T(a) (right), where T(a) is the lower/upper triangle of the
+// square matrix a, with an implicit unit diagonal when requested (dtrmm when BLAS is linked).
+void triangular_multiply(const Eigen::Ref<const RowMatrix> &a, const Eigen::Ref<const RowMatrix> &b, bool lower,
+                         bool unit_diagonal, bool left, Eigen::Map<RowMatrix> out);
+
+// out = S(a) * b (left) or b * S(a) (right), where S(a) is the symmetric matrix stored in the
+// lower/upper triangle of a; the other triangle is not read (dsymm when BLAS is linked).
+void symmetric_multiply(const Eigen::Ref<const RowMatrix> &a, const Eigen::Ref<const RowMatrix> &b, bool lower,
+                        bool left, Eigen::Map<RowMatrix> out);
+
+SvdFactors compute_svd(const ColMatrix &matrix, bool full_matrices, const std::string &method);
+EighFactors compute_eigh(const ColMatrix &matrix, bool lower, bool eigenvectors, const std::string &method);
+
+// Generalized symmetric-definite eigenproblem, reading the `lower` (or upper) triangles of A
+// and B: type 1 solves A v = w B v, type 2 A B v = w v and type 3 B A v = w v. Eigenvectors
+// are B-normalized (V^T B V = I for types 1 and 2, V^T B^{-1} V = I for type 3). With il >= 0
+// only eigenvalues il..iu (0-based, inclusive, ascending) and their vectors are returned.
+// The LAPACK path calls dsygvd (dsygvx for subsets); with the factor cache enabled, or for
+// method="eigen", B's Cholesky factor is computed (or found in the cache) and the overload
+// below is used. Throws std::invalid_argument when B is not positive definite.
+EighFactors compute_generalized_eigh(const ColMatrix &a, const ColMatrix &b, int type, bool lower, bool eigenvectors,
+                                     const std::string &method, Eigen::Index il = -1, Eigen::Index iu = -1);
+
+// Same with B given by its Cholesky factor L: reduces to the standard problem C y = w y
+// (C = L^-1 A L^-T or L^T A L; dsygst with LAPACK, triangular solves otherwise), runs
+// compute_eigh on C and back-transforms the requested eigenvectors.
+EighFactors compute_generalized_eigh(const ColMatrix &a, const CholeskyFactor &b, int type, bool lower,
+                                     bool eigenvectors, const std::string &method, Eigen::Index il = -1,
+                                     Eigen::Index iu = -1);
+
+// Solves lhs * x = rhs for square lhs with LU (LAPACK dgesv or Eigen PartialPivLU).
+ColMatrix solve_dense(ColMatrix lhs, ColMatrix rhs, const std::string &method);
+
+// Mixed precision: LU in float (sgetrf or PartialPivLU<float>) plus iterative refinement in
+// double. Falls back to solve_dense when lhs does not fit in float, the float factors are
+// singular, or refinement stalls; `info` records which path produced the result.
+ColMatrix solve_dense_mixed(const ColMatrix &lhs, const ColMatrix &rhs, const std::string &method,
+                            RefinementInfo &info);
+
+}  // namespace peigen
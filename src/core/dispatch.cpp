@@ -0,0 +1,172 @@
+#include "core/dispatch.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <dlfcn.h>
+#endif
+
+#include <Eigen/Core>
+
+#ifndef PEIGEN_BASELINE_ISA
+#define PEIGEN_BASELINE_ISA "baseline"
+#endif
+#ifndef PEIGEN_KERNEL_VARIANTS
+#define PEIGEN_KERNEL_VARIANTS ""
+#endif
+#ifndef PEIGEN_KERNEL_SUFFIX
+#define PEIGEN_KERNEL_SUFFIX ".so"
+#endif
+
+namespace peigen {
+
+const char *baseline_isa() {
+  return PEIGEN_BASELINE_ISA;
+}
+
+KernelDispatch &kernel_dispatch() {
+  static KernelDispatch dispatch;
+  return dispatch;
+}
+
+const peigen_kernel_table &kernels() {
+  // After the first call this is a single acquire load; callers on pool or OpenMP threads
+  // never observe the builtin table being swapped for the selected variant.
+  init_kernel_dispatch();
+  return *kernel_dispatch().table;
+}
+
+static std::vector<std::string> split_list(const std::string &text) {
+  std::vector<std::string> out;
+  std::size_t start = 0;
+  while (start <= text.size()) {
+    const std::size_t end = text.find(',', start);
+    const std::string item = text.substr(start, end == std::string::npos ? std::string::npos : end - start);
+    if (!item.empty()) {
+      out.push_back(item);
+    }
+    if (end == std::string::npos) {
+      break;
+    }
+    start = end + 1;
+  }
+  return out;
+}
+
+static bool cpu_supports_isa(const std::string &isa) {
+  if (isa == PEIGEN_BASELINE_ISA) {
+    return true;
+  }
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+  __builtin_cpu_init();
+  if (isa == "avx2") {
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+  }
+  if (isa == "avx512") {
+    return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") &&
+           __builtin_cpu_supports("avx512vl") && __builtin_cpu_supports("avx512bw") &&
+           __builtin_cpu_supports("fma");
+  }
+#endif
+  return false;
+}
+
+static std::string module_directory() {
+#if !defined(_WIN32)
+  Dl_info info;
+  if (dladdr(reinterpret_cast<void *>(&module_directory), &info) != 0 && info.dli_fname != nullptr) {
+    const std::string path(info.dli_fname);
+    const std::size_t slash = path.find_last_of('/');
+    if (slash != std::string::npos) {
+      return path.substr(0, slash);
+    }
+  }
+#endif
+  return ".";
+}
+
+static const peigen_kernel_table *load_kernel_variant(const std::string &isa, std::string &error) {
+#if !defined(_WIN32)
+  const std::string path = module_directory() + "/_kernels_" + isa + PEIGEN_KERNEL_SUFFIX;
+  void *handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+  if (handle == nullptr) {
+    const char *reason = dlerror();
+    error = "failed to load " + path + (reason != nullptr ? std::string(": ") + reason : std::string());
+    return nullptr;
+  }
+  auto entry = reinterpret_cast<peigen_kernel_table_fn>(dlsym(handle, PEIGEN_KERNEL_TABLE_SYMBOL));
+  const peigen_kernel_table *table = entry != nullptr ? entry() : nullptr;
+  if (table == nullptr || table->abi_version != PEIGEN_KERNEL_ABI_VERSION) {
+    error = path + " does not export a compatible kernel table";
+    dlclose(handle);
+    return nullptr;
+  }
+  // The handle is intentionally kept open for the lifetime of the process.
+  return table;
+#else
+  error = "ISA kernel variants are not supported on this platform";
+  return nullptr;
+#endif
+}
+
+static void select_kernel_variant(KernelDispatch &dispatch) {
+  dispatch.table = peigen_builtin_kernel_table();
+  dispatch.variants = split_list(PEIGEN_KERNEL_VARIANTS);
+  dispatch.cpu_supported = {PEIGEN_BASELINE_ISA};
+  for (const std::string &isa : dispatch.variants) {
+    if (cpu_supports_isa(isa)) {
+      dispatch.cpu_supported.push_back(isa);
+    }
+  }
+
+  const char *env = std::getenv("PEIGEN_ISA");
+  const std::string requested = env != nullptr ? env : "auto";
+  std::vector<std::string> candidates;
+  if (requested == "auto" || requested.empty()) {
+    // Variants are listed best-first.
+    candidates = dispatch.variants;
+  } else {
+    dispatch.forced = true;
+    if (requested == PEIGEN_BASELINE_ISA) {
+      return;
+    }
+    const bool shipped =
+        std::find(dispatch.variants.begin(), dispatch.variants.end(), requested) != dispatch.variants.end();
+    if (!shipped) {
+      dispatch.note = "PEIGEN_ISA=" + requested + " is not built into this extension; using " +
+                      PEIGEN_BASELINE_ISA;
+      return;
+    }
+    candidates = {requested};
+  }
+
+  for (const std::string &isa : candidates) {
+    if (!cpu_supports_isa(isa)) {
+      if (dispatch.forced) {
+        dispatch.note = "PEIGEN_ISA=" + isa + " is not supported by this CPU; using " + PEIGEN_BASELINE_ISA;
+      }
+      continue;
+    }
+    std::string error;
+    if (const peigen_kernel_table *table = load_kernel_variant(isa, error)) {
+      dispatch.table = table;
+      break;
+    }
+    dispatch.note = error;
+  }
+}
+
+void init_kernel_dispatch() {
+  static std::once_flag once;
+  std::call_once(once, [] {
+    KernelDispatch &dispatch = kernel_dispatch();
+    select_kernel_variant(dispatch);
+    dispatch.table->set_num_threads(Eigen::nbThreads());
+  });
+}
+
+}  // namespace peigen
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "kernels/kernels.h"
+
+namespace peigen {
+
+// Runtime ISA dispatch. The Eigen-only hot kernels (GEMM without BLAS, sparse @ dense,
+// norms, CG/BiCGSTAB) are built once per instruction set; the best variant the CPU supports
+// is loaded at startup, falling back to the baseline copy linked into the caller.
+// PEIGEN_ISA=<name> forces a variant (e.g. for benchmarking); PEIGEN_ISA=auto is the default.
+struct KernelDispatch {
+  const peigen_kernel_table *table = nullptr;
+  std::vector<std::string> variants;
+  std::vector<std::string> cpu_supported;
+  bool forced = false;
+  std::string note;
+};
+
+const char *baseline_isa();
+KernelDispatch &kernel_dispatch();
+const peigen_kernel_table &kernels();
+
+// Selects and loads the kernel variant exactly once (std::call_once), so concurrent first
+// calls from several threads are safe; later calls are no-ops. kernels() calls it as well.
+void init_kernel_dispatch();
+
+}  // namespace peigen
@@ -0,0 +1,218 @@
+#include "core/factor_cache.h"
+
+#include <cstring>
+#include <list>
+#include <mutex>
+
+namespace peigen {
+
+namespace {
+
+// 64-bit multiply-xorshift hash over 8-byte words (tail bytes zero-padded), finished with
+// the splitmix64 mixer. Reads memory at close to bandwidth, far below factorization cost.
+std::uint64_t mix(std::uint64_t h) {
+  h ^= h >> 30;
+  h *= 0xbf58476d1ce4e5b9ULL;
+  h ^= h >> 27;
+  h *= 0x94d049bb133111ebULL;
+  h ^= h >> 31;
+  return h;
+}
+
+std::uint64_t hash_bytes(const void *data, std::size_t bytes, std::uint64_t seed) {
+  const auto *p = static_cast<const unsigned char *>(data);
+  std::uint64_t h = mix(seed ^ (bytes * 0x9e3779b97f4a7c15ULL));
+  std::size_t i = 0;
+  for (; i + 8 <= bytes; i += 8) {
+    std::uint64_t word;
+    std::memcpy(&word, p + i, 8);
+    h = (h ^ word) * 0x100000001b3ULL;
+    h ^= h >> 29;
+  }
+  if (i < bytes) {
+    std::uint64_t word = 0;
+    std::memcpy(&word, p + i, bytes - i);
+    h = (h ^ word) * 0x100000001b3ULL;
+  }
+  return mix(h);
+}
+
+std::vector<unsigned char> copy_source(const std::vector<ByteSpan> &source) {
+  std::size_t total = 0;
+  for (const ByteSpan &span : source) {
+    total += span.bytes;
+  }
+  std::vector<unsigned char> out(total);
+  std::size_t offset = 0;
+  for (const ByteSpan &span : source) {
+    if (span.bytes > 0) {
+      std::memcpy(out.data() + offset, span.data, span.bytes);
+    }
+    offset += span.bytes;
+  }
+  return out;
+}
+
+bool same_source(const std::vector<unsigned char> &stored, const std::vector<ByteSpan> &source) {
+  std::size_t offset = 0;
+  for (const ByteSpan &span : source) {
+    if (offset + span.bytes > stored.size() ||
+        (span.bytes > 0 && std::memcmp(stored.data() + offset, span.data, span.bytes) != 0)) {
+      return false;
+    }
+    offset += span.bytes;
+  }
+  return offset == stored.size();
+}
+
+struct Entry {
+  FactorKey key;  // source cleared; the matrix lives in `source`
+  std::vector<unsigned char> source;
+  std::shared_ptr<const void> factor;
+  std::size_t bytes;
+};
+
+class FactorCache {
+ public:
+  std::shared_ptr<const void> lookup(const FactorKey &key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (max_bytes_ == 0) {
+      return nullptr;
+    }
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+      if (it->key == key && same_source(it->source, key.source)) {
+        entries_.splice(entries_.begin(), entries_, it);
+        ++stats_.hits;
+        return it->factor;
+      }
+    }
+    ++stats_.misses;
+    return nullptr;
+  }
+
+  // Returns the factor to use: an entry another thread stored first wins. On a fingerprint
+  // collision with a different matrix the existing entry stays and factor is not stored.
+  std::shared_ptr<const void> insert(FactorKey key, std::vector<unsigned char> source,
+                                     std::shared_ptr<const void> factor, std::size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const Entry &entry : entries_) {
+      if (entry.key == key) {
+        return entry.source == source ? entry.factor : factor;
+      }
+    }
+    bytes += source.size();
+    if (max_bytes_ == 0 || bytes > max_bytes_) {
+      return factor;
+    }
+    key.source.clear();
+    entries_.push_front(Entry{std::move(key), std::move(source), factor, bytes});
+    stats_.bytes += bytes;
+    evict_to(max_bytes_);
+    return factor;
+  }
+
+  void set_limit(std::size_t max_bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    max_bytes_ = max_bytes;
+    evict_to(max_bytes);
+  }
+
+  bool enabled() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return max_bytes_ > 0;
+  }
+
+  FactorCacheStats stats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    FactorCacheStats out = stats_;
+    out.entries = entries_.size();
+    out.max_bytes = max_bytes_;
+    return out;
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    stats_ = FactorCacheStats{};
+  }
+
+ private:
+  void evict_to(std::size_t limit) {
+    while (stats_.bytes > limit && !entries_.empty()) {
+      stats_.bytes -= entries_.back().bytes;
+      entries_.pop_back();
+      ++stats_.evictions;
+    }
+  }
+
+  std::mutex mutex_;
+  // Most recently used first. Caches hold few, large entries, so a linear scan is cheaper
+  // than maintaining a hash index alongside the list.
+  std::list<Entry> entries_;
+  std::size_t max_bytes_ = 0;
+  FactorCacheStats stats_;
+};
+
+FactorCache &cache() {
+  static FactorCache instance;
+  return instance;
+}
+
+}  // namespace
+
+FactorKey sparse_fingerprint(const std::string &kind, const Eigen::Map<const Sparse> &mat) {
+  FactorKey key{kind, mat.rows(), mat.cols(), mat.nonZeros(), 0, {}};
+  const std::size_t outer = static_cast<std::size_t>(mat.outerSize()) + 1;
+  const std::size_t nnz = static_cast<std::size_t>(mat.nonZeros());
+  key.source = {{mat.outerIndexPtr(), outer * sizeof(int)},
+                {mat.innerIndexPtr(), nnz * sizeof(int)},
+                {mat.valuePtr(), nnz * sizeof(double)}};
+  std::uint64_t h = 1;
+  for (const ByteSpan &span : key.source) {
+    h = hash_bytes(span.data, span.bytes, h);
+  }
+  key.hash = h;
+  return key;
+}
+
+FactorKey dense_fingerprint(const std::string &kind, const Eigen::Ref<const ColMatrix> &mat) {
+  FactorKey key{kind, mat.rows(), mat.cols(), mat.size(), 0, {}};
+  const std::size_t column_bytes = static_cast<std::size_t>(mat.rows()) * sizeof(double);
+  if (mat.outerStride() == mat.rows()) {
+    key.source.push_back({mat.data(), column_bytes * static_cast<std::size_t>(mat.cols())});
+  } else {
+    for (Eigen::Index col = 0; col < mat.cols(); ++col) {
+      key.source.push_back({mat.col(col).data(), column_bytes});
+    }
+  }
+  std::uint64_t h = 2;
+  for (const ByteSpan &span : key.source) {
+    h = hash_bytes(span.data, span.bytes, h);
+  }
+  key.hash = h;
+  return key;
+}
+
+void set_factor_cache_limit(std::size_t max_bytes) { cache().set_limit(max_bytes); }
+
+bool factor_cache_enabled() { return cache().enabled(); }
+
+FactorCacheStats factor_cache_stats() { return cache().stats(); }
+
+void clear_factor_cache() { cache().clear(); }
+
+namespace detail {
+
+std::shared_ptr<const void> factor_cache_get_or_build(const FactorKey &key, const FactorBuilder &build) {
+  if (std::shared_ptr<const void> hit = cache().lookup(key)) {
+    return hit;
+  }
+  // Copied before build(), which may consume the matrix (dgetrf factors in place).
+  std::vector<unsigned char> source = copy_source(key.source);
+  std::pair<std::shared_ptr<const void>, std::size_t> built = build();
+  return cache().insert(key, std::move(source), std::move(built.first), built.second);
+}
+
+}  // namespace detail
+
+}  // namespace peigen
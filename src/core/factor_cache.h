@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/common.h"
+
+namespace peigen {
+
+// Process-wide LRU cache of factorizations, keyed by a content fingerprint of the matrix so
+// repeated solves with the same A (from any call site) skip analyze + factorize. Disabled
+// until a byte limit is set; entries are shared, read-only factor objects whose solve() is
+// safe to call concurrently.
+struct FactorCacheStats {
+  std::uint64_t hits = 0;
+  std::uint64_t misses = 0;
+  std::uint64_t evictions = 0;
+  std::size_t entries = 0;
+  std::size_t bytes = 0;
+  std::size_t max_bytes = 0;
+};
+
+// A contiguous byte range of the matrix a key was computed from.
+struct ByteSpan {
+  const void *data = nullptr;
+  std::size_t bytes = 0;
+};
+
+// kind distinguishes factorization types of the same matrix ("sparse_lu", "dense_lu:lapack").
+// hash covers the structure and values and only selects candidate entries: each entry keeps
+// an exact copy of its matrix, and a fingerprint match counts as a hit only when that copy
+// equals `source`. A hash collision therefore costs a miss, never a wrong factor.
+struct FactorKey {
+  std::string kind;
+  std::int64_t rows = 0;
+  std::int64_t cols = 0;
+  std::int64_t nnz = 0;
+  std::uint64_t hash = 0;
+  // Non-owning views of the hashed arrays; valid only for the duration of the lookup.
+  std::vector<ByteSpan> source;
+
+  // Compares the fingerprint only; source contents are checked by the cache.
+  bool operator==(const FactorKey &other) const {
+    return hash == other.hash && rows == other.rows && cols == other.cols && nnz == other.nnz &&
+           kind == other.kind;
+  }
+};
+
+FactorKey sparse_fingerprint(const std::string &kind, const Eigen::Map<const Sparse> &mat);
+FactorKey dense_fingerprint(const std::string &kind, const Eigen::Ref<const ColMatrix> &mat);
+
+// 0 disables the cache and drops every entry; shrinking evicts least-recently-used entries.
+void set_factor_cache_limit(std::size_t max_bytes);
+bool factor_cache_enabled();
+FactorCacheStats factor_cache_stats();
+void clear_factor_cache();
+
+namespace detail {
+using FactorBuilder = std::function<std::pair<std::shared_ptr<const void>, std::size_t>()>;
+std::shared_ptr<const void> factor_cache_get_or_build(const FactorKey &key, const FactorBuilder &build);
+}  // namespace detail
+
+// Returns the cached factor for key, or runs build() (outside the cache lock) and stores its
+// result. build returns the factor and its approximate size in bytes; the stored size also
+// counts the copy of key.source. Entries larger than the limit are returned but not kept.
+// The source is copied before build() runs, so build may consume or overwrite the matrix.
+// Exceptions from build propagate and cache nothing.
+template <typename T, typename Build>
+std::shared_ptr<const T> cached_factor(const FactorKey &key, Build &&build) {
+  return std::static_pointer_cast<const T>(detail::factor_cache_get_or_build(key, [&build]() {
+    std::pair<std::shared_ptr<const T>, std::size_t> built = build();
+    return std::pair<std::shared_ptr<const void>, std::size_t>(std::move(built.first), built.second);
+  }));
+}
+
+}  // namespace peigen
@@ -0,0 +1,26 @@
+#pragma once
+
+#if defined(PEIGEN_LAPACK_ENABLED)
+#include <lapack/lapack.h>
+
+using lapack_int = int;
+
+// Not declared in Eigen's bundled lapack.h (divide-and-conquer / MRRR and generalized
+// symmetric-definite eigen paths).
+extern "C" {
+EIGEN_LAPACK_API void BLASFUNC(dsyevd)(const char *, const char *, int *, double *, int *, double *, double *, int *,
+                                       int *, int *, int *);
+EIGEN_LAPACK_API void BLASFUNC(dsyevr)(const char *, const char *, const char *, int *, double *, int *,
+                                       double *, double *, int *, int *, double *, int *, double *, double *, int *,
+                                       int *, double *, int *, int *, int *, int *);
+EIGEN_LAPACK_API void BLASFUNC(dsyevx)(const char *, const char *, const char *, int *, double *, int *,
+                                       double *, double *, int *, int *, double *, int *, double *, double *, int *,
+                                       double *, int *, int *, int *, int *);
+EIGEN_LAPACK_API void BLASFUNC(dsygst)(int *, const char *, int *, double *, int *, const double *, int *, int *);
+EIGEN_LAPACK_API void BLASFUNC(dsygvd)(int *, const char *, const char *, int *, double *, int *, double *, int *,
+                                       double *, double *, int *, int *, int *, int *);
+EIGEN_LAPACK_API void BLASFUNC(dsygvx)(int *, const char *, const char *, const char *, int *, double *, int *,
+                                       double *, int *, double *, double *, int *, int *, double *, int *, double *,
+                                       double *, int *, double *, int *, int *, int *, int *);
+}
+#endif
@@ -0,0 +1,83 @@
+#include "core/least_squares.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include <Eigen/IterativeLinearSolvers>
+
+namespace peigen {
+
+SparseLeastSquaresQR::SparseLeastSquaresQR(const Sparse &mat, double pivot_threshold)
+    : rows_(mat.rows()),
+      cols_(mat.cols()),
+      transposed_(mat.rows() < mat.cols()),
+      qr_(std::make_unique<Eigen::SparseQR<Sparse, Eigen::COLAMDOrdering<int>>>()) {
+  if (pivot_threshold >= 0.0) {
+    qr_->setPivotThreshold(pivot_threshold);
+  }
+  Sparse compressed = transposed_ ? Sparse(mat.transpose()) : mat;
+  compressed.makeCompressed();
+  qr_->compute(compressed);
+  if (qr_->info() != Eigen::Success) {
+    throw std::runtime_error("SparseQR factorization failed: " + qr_->lastErrorMessage());
+  }
+}
+
+void SparseLeastSquaresQR::solve(const Eigen::Ref<const RowMatrix> &rhs, Eigen::Map<RowMatrix> out) const {
+  if (rhs.rows() != rows_) {
+    throw std::invalid_argument("factorized matrix and rhs shape mismatch");
+  }
+  const Eigen::Index rank = qr_->rank();
+  Vector x(cols_);
+  Vector y(cols_);
+  for (Eigen::Index col = 0; col < rhs.cols(); ++col) {
+    if (!transposed_) {
+      x = qr_->solve(Vector(rhs.col(col)));
+      if (qr_->info() != Eigen::Success) {
+        throw std::runtime_error("SparseQR solve failed");
+      }
+    } else {
+      // A^T P = Q R, so A x = b becomes R^T (Q^T x) = P^T b; the minimum-norm x is Q [z; 0]
+      // with R11^T z = (P^T b)[:rank].
+      const Vector c = qr_->colsPermutation().transpose() * Vector(rhs.col(col));
+      y.setZero();
+      y.head(rank) = qr_->matrixR().topLeftCorner(rank, rank).transpose().triangularView<Eigen::Lower>().solve(
+          c.head(rank));
+      x = qr_->matrixQ() * y;
+    }
+    out.col(col) = x;
+  }
+}
+
+peigen_iterative_result sparse_lscg_solve(const Eigen::Map<const Sparse> &mat,
+                                          const Eigen::Ref<const RowMatrix> &rhs,
+                                          Eigen::Map<RowMatrix> out,
+                                          double tol,
+                                          int maxiter) {
+  if (rhs.rows() != mat.rows()) {
+    throw std::invalid_argument("lstsq shape mismatch");
+  }
+  Eigen::LeastSquaresConjugateGradient<Sparse> solver;
+  solver.setTolerance(tol);
+  solver.setMaxIterations(maxiter);
+  solver.compute(mat);
+  if (solver.info() != Eigen::Success) {
+    throw std::runtime_error("LeastSquaresConjugateGradient setup failed");
+  }
+
+  peigen_iterative_result result{};
+  for (Eigen::Index col = 0; col < rhs.cols(); ++col) {
+    out.col(col) = solver.solve(Vector(rhs.col(col)));
+    result.iterations = std::max<int>(result.iterations, static_cast<int>(solver.iterations()));
+    result.error = std::max(result.error, solver.error());
+    if (solver.info() != Eigen::Success) {
+      throw std::runtime_error("LeastSquaresConjugateGradient did not converge (iters=" +
+                               std::to_string(solver.iterations()) + ", error=" + std::to_string(solver.error()) +
+                               ")");
+    }
+  }
+  return result;
+}
+
+}  // namespace peigen
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <memory>
+
+#include <Eigen/SparseQR>
+
+#include "core/common.h"
+#include "kernels/kernels.h"
+
+namespace peigen {
+
+// Sparse least squares min ||A x - b||_2 for rectangular A (rows x cols).
+//
+// SparseLeastSquaresQR factors A P = Q R once with Eigen's SparseQR under a COLAMD column
+// ordering; Q stays in Householder form and A^T A is never assembled. For rows >= cols the
+// result is the least-squares solution (a basic solution, with the columns beyond the
+// numerical rank set to zero, when A is rank deficient). For rows < cols A^T is factored
+// instead and the minimum-norm solution of A x = b is returned.
+class SparseLeastSquaresQR {
+ public:
+  // pivot_threshold < 0 keeps SparseQR's default (20 (m + n) max_j ||A_j|| eps).
+  explicit SparseLeastSquaresQR(const Sparse &mat, double pivot_threshold = -1.0);
+
+  Eigen::Index rows() const { return rows_; }
+  Eigen::Index cols() const { return cols_; }
+  Eigen::Index rank() const { return qr_->rank(); }
+
+  // rhs is rows x k and out is cols x k, both row-major.
+  void solve(const Eigen::Ref<const RowMatrix> &rhs, Eigen::Map<RowMatrix> out) const;
+
+ private:
+  Eigen::Index rows_;
+  Eigen::Index cols_;
+  bool transposed_;
+  std::unique_ptr<Eigen::SparseQR<Sparse, Eigen::COLAMDOrdering<int>>> qr_;
+};
+
+// Least-squares conjugate gradient (CGLS on A^T A with a column-norm diagonal preconditioner),
+// matrix-free apart from A itself. Because of the column scaling it does not return the
+// minimum-norm solution of underdetermined systems. rhs is rows x k and out cols x k
+// (row-major); iterations/error report the worst column. Throws std::runtime_error when a
+// column does not reach tol within maxiter.
+peigen_iterative_result sparse_lscg_solve(const Eigen::Map<const Sparse> &mat,
+                                          const Eigen::Ref<const RowMatrix> &rhs,
+                                          Eigen::Map<RowMatrix> out,
+                                          double tol,
+                                          int maxiter);
+
+}  // namespace peigen
@@ -0,0 +1,544 @@
+#include "core/linear_operator.h"
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <Eigen/IterativeLinearSolvers>
+
+namespace peigen {
+namespace detail {
+
+// Adapter exposing a LinearOperator to Eigen's iterative solvers (matrix-free interface:
+// the solvers only need rows(), cols() and operator* with a dense vector).
+class OperatorRef;
+
+}  // namespace detail
+}  // namespace peigen
+
+namespace Eigen {
+namespace internal {
+
+template <>
+struct traits<peigen::detail::OperatorRef> : public traits<peigen::Sparse> {};
+
+}  // namespace internal
+}  // namespace Eigen
+
+namespace peigen {
+namespace detail {
+
+class OperatorRef : public Eigen::EigenBase<OperatorRef> {
+ public:
+  using Scalar = double;
+  using RealScalar = double;
+  using StorageIndex = int;
+  enum {
+    ColsAtCompileTime = Eigen::Dynamic,
+    MaxColsAtCompileTime = Eigen::Dynamic,
+    IsRowMajor = false
+  };
+
+  explicit OperatorRef(const LinearOperator &op) : op_(&op) {}
+
+  Eigen::Index rows() const { return op_->rows(); }
+  Eigen::Index cols() const { return op_->cols(); }
+  const LinearOperator &op() const { return *op_; }
+
+  template <typename Rhs>
+  Eigen::Product<OperatorRef, Rhs, Eigen::AliasFreeProduct> operator*(const Eigen::MatrixBase<Rhs> &x) const {
+    return Eigen::Product<OperatorRef, Rhs, Eigen::AliasFreeProduct>(*this, x.derived());
+  }
+
+ private:
+  const LinearOperator *op_;
+};
+
+// Jacobi preconditioner built from LinearOperator::diagonal(); Eigen's
+// DiagonalPreconditioner needs coefficient access to an assembled matrix.
+class OperatorJacobi {
+ public:
+  OperatorJacobi() = default;
+
+  template <typename MatType>
+  explicit OperatorJacobi(const MatType &mat) {
+    compute(mat);
+  }
+
+  template <typename MatType>
+  OperatorJacobi &analyzePattern(const MatType &) {
+    return *this;
+  }
+
+  template <typename MatType>
+  OperatorJacobi &factorize(const MatType &mat) {
+    return compute(mat);
+  }
+
+  template <typename MatType>
+  OperatorJacobi &compute(const MatType &mat) {
+    const Vector diag = mat.op().diagonal();
+    inv_diag_ = diag.unaryExpr([](double d) { return d == 0.0 ? 1.0 : 1.0 / d; });
+    return *this;
+  }
+
+  template <typename Rhs>
+  Vector solve(const Eigen::MatrixBase<Rhs> &b) const {
+    return inv_diag_.cwiseProduct(b.derived());
+  }
+
+  Eigen::ComputationInfo info() const { return Eigen::Success; }
+
+ private:
+  Vector inv_diag_;
+};
+
+}  // namespace detail
+}  // namespace peigen
+
+namespace Eigen {
+namespace internal {
+
+template <typename Rhs>
+struct generic_product_impl<peigen::detail::OperatorRef, Rhs, SparseShape, DenseShape, GemvProduct>
+    : generic_product_impl_base<peigen::detail::OperatorRef, Rhs,
+                                generic_product_impl<peigen::detail::OperatorRef, Rhs>> {
+  using Scalar = typename Product<peigen::detail::OperatorRef, Rhs>::Scalar;
+
+  template <typename Dest>
+  static void scaleAndAddTo(Dest &dst, const peigen::detail::OperatorRef &lhs, const Rhs &rhs,
+                            const Scalar &alpha) {
+    const Ref<const peigen::ColMatrix> x(rhs);
+    peigen::ColMatrix y(lhs.rows(), x.cols());
+    lhs.op().apply(x, y);
+    dst += alpha * y;
+  }
+};
+
+}  // namespace internal
+}  // namespace Eigen
+
+namespace peigen {
+
+namespace {
+
+void check_same_shape(const std::vector<LinearOperatorPtr> &ops, const char *what) {
+  if (ops.empty()) {
+    throw std::invalid_argument(std::string(what) + " requires at least one operator");
+  }
+  for (const LinearOperatorPtr &op : ops) {
+    if (!op) {
+      throw std::invalid_argument(std::string(what) + " operand is null");
+    }
+    if (op->rows() != ops.front()->rows() || op->cols() != ops.front()->cols()) {
+      throw std::invalid_argument(std::string(what) + " operands must have the same shape");
+    }
+  }
+}
+
+class SparseOperator final : public LinearOperator {
+ public:
+  explicit SparseOperator(std::shared_ptr<const SparseHandle> mat)
+      : LinearOperator(mat->csc().rows(), mat->csc().cols()), mat_(std::move(mat)) {}
+
+  void apply(const Eigen::Ref<const ColMatrix> &x, Eigen::Ref<ColMatrix> y) const override {
+    y.noalias() = mat_->csc() * x;
+  }
+
+  void apply_transpose(const Eigen::Ref<const ColMatrix> &x, Eigen::Ref<ColMatrix> y) const override {
+    y.noalias() = mat_->csc().transpose() * x;
+  }
+
+  Vector diagonal() const override { return mat_->diagonal(); }
+
+ private:
+  std::shared_ptr<const SparseHandle> mat_;
+};
+
+class DenseOperator final : public LinearOperator {
+ public:
+  explicit DenseOperator(ColMatrix mat) : LinearOperator(mat.rows(), mat.cols()), mat_(std::move(mat)) {}
+
+  void apply(const Eigen::Ref<const ColMatrix> &x, Eigen::Ref<ColMatrix> y) const override {
+    y.noalias() = mat_ * x;
+  }
+
+  void apply_transpose(const Eigen::Ref<const ColMatrix> &x, Eigen::Ref<ColMatrix> y) const override {
+    y.noalias() = mat_.transpose() * x;
+  }
+
+  Vector diagonal() const override { return mat_.diagonal(); }
+
+ private:
+  ColMatrix mat_;
+};
+
+class IdentityOperator final : public LinearOperator {
+ public:
+  explicit IdentityOperator(Eigen::Index n) : LinearOperator(n, n) {}
+
+  void apply(const Eigen::Ref<const ColMatrix> &x, Eigen::Ref<ColMatrix> y) const override { y = x; }
+
+  void apply_transpose(const Eigen::Ref<const ColMatrix> &x, Eigen::Ref<ColMatrix> y) const override { y = x; }
+
+  Vector diagonal() const override { return Vector::Ones(rows()); }
+};
+
+class SumOperator final : public LinearOperator {
+ public:
+  explicit SumOperator(std::vector<LinearOperatorPtr> terms)
+      : LinearOperator(terms.front()->rows(), terms.front()->cols()), terms_(std::move(terms)) {}
+
+  void apply(const Eigen::Ref<const ColMatrix> &x, Eigen::Ref<ColMatrix> y) const override {
+    accumulate(x, y, false);
+  }
+
+  void apply_transpose(const Eigen::Ref<const ColMatrix> &x, Eigen::Ref<ColMatrix> y) const override {
+    accumulate(x, y, true);
+  }
+
+  Vector diagonal() const override {
+    Vector diag = terms_.front()->diagonal();
+    for (std::size_t i = 1; i < terms_.size(); ++i) {
+      diag += terms_[i]->diagonal();
+    }
+    return diag;
+  }
+
+ private:
+  void accumulate(const Eigen::Ref<const ColMatrix> &x, Eigen::Ref<ColMatrix> y, bool transpose) const {
+    const LinearOperator &first = *terms_.front();
+    transpose ? first.apply_transpose(x, y) : first.apply(x, y);
+    if (terms_.size() == 1) {
+      return;
+    }
+    ColMatrix tmp(y.rows(), y.cols());
+    for (std::size_t i = 1; i < terms_.size(); ++i) {
+      transpose ? terms_[i]->apply_transpose(x, tmp) : terms_[i]->apply(x, tmp);
+      y += tmp;
+    }
+  }
+
+  std::vector<LinearOperatorPtr> terms_;
+};
+
+class ScaledOperator final : public LinearOperator {
+ public:
+  ScaledOperator(double alpha, LinearOperatorPtr op)
+      : LinearOperator(op->rows(), op->cols()), alpha_(alpha), op_(std::move(op)) {}
+
+  void apply(const Eigen::Ref<const ColMatrix> &x, Eigen::Ref<ColMatrix> y) const override {
+    op_->apply(x, y);
+    y *= alpha_;
+  }
+
+  void apply_transpose(const Eigen::Ref<const ColMatrix> &x, Eigen::Ref<ColMatrix> y) const override {
+    op_->apply_transpose(x, y);
+    y *= alpha_;
+  }
+
+  Vector diagonal() const override { return alpha_ * op_->diagonal(); }
+
+ private:
+  double alpha_;
+  LinearOperatorPtr op_;
+};
+
+class ProductOperator final : public LinearOperator {
+ public:
+  explicit ProductOperator(std::vector<LinearOperatorPtr> factors)
+      : LinearOperator(factors.front()->rows(), factors.back()->cols()), factors_(std::move(factors)) {}
+
+  void apply(const Eigen::Ref<const ColMatrix> &x, Eigen::Ref<ColMatrix> y) const override {
+    if (factors_.size() == 1) {
+      factors_.front()->apply(x, y);
+      return;
+    }
+    ColMatrix current(factors_.back()->rows(), x.cols());
+    factors_.back()->apply(x, current);
+    for (std::size_t i = factors_.size() - 1; i-- > 1;) {
+      ColMatrix next(factors_[i]->rows(), x.cols());
+      factors_[i]->apply(current, next);
+      current.swap(next);
+    }
+    factors_.front()->apply(current, y);
+  }
+
+  void apply_transpose(const Eigen::Ref<const ColMatrix> &x, Eigen::Ref<ColMatrix> y) const override {
+    if (factors_.size() == 1) {
+      factors_.front()->apply_transpose(x, y);
+      return;
+    }
+    ColMatrix current(factors_.front()->cols(), x.cols());
+    factors_.front()->apply_transpose(x, current);
+    for (std::size_t i = 1; i + 1 < factors_.size(); ++i) {
+      ColMatrix next(factors_[i]->cols(), x.cols());
+      factors_[i]->apply_transpose(current, next);
+      current.swap(next);
+    }
+    factors_.back()->apply_transpose(current, y);
+  }
+
+  Vector diagonal() const override {
+    if (factors_.size() == 1) {
+      return factors_.front()->diagonal();
+    }
+    throw std::invalid_argument("preconditioner='jacobi' is not supported for operator products");
+  }
+
+ private:
+  std::vector<LinearOperatorPtr> factors_;
+};
+
+class TransposeOperator final : public LinearOperator {
+ public:
+  explicit TransposeOperator(LinearOperatorPtr op) : LinearOperator(op->cols(), op->rows()), op_(std::move(op)) {}
+
+  void apply(const Eigen::Ref<const ColMatrix> &x, Eigen::Ref<ColMatrix> y) const override {
+    op_->apply_transpose(x, y);
+  }
+
+  void apply_transpose(const Eigen::Ref<const ColMatrix> &x, Eigen::Ref<ColMatrix> y) const override {
+    op_->apply(x, y);
+  }
+
+  Vector diagonal() const override { return op_->diagonal(); }
+
+ private:
+  LinearOperatorPtr op_;
+};
+
+// (A kron B) vec(X) = vec(B X A^T) with X of shape (B.cols x A.cols), column-major, so each
+// product costs one block apply of B and one of A instead of touching the Kronecker matrix.
+class KronOperator final : public LinearOperator {
+ public:
+  KronOperator(LinearOperatorPtr a, LinearOperatorPtr b)
+      : LinearOperator(a->rows() * b->rows(), a->cols() * b->cols()), a_(std::move(a)), b_(std::move(b)) {}
+
+  void apply(const Eigen::Ref<const ColMatrix> &x, Eigen::Ref<ColMatrix> y) const override {
+    apply_impl(x, y, false);
+  }
+
+  void apply_transpose(const Eigen::Ref<const ColMatrix> &x, Eigen::Ref<ColMatrix> y) const override {
+    apply_impl(x, y, true);
+  }
+
+  Vector diagonal() const override {
+    if (a_->rows() != a_->cols() || b_->rows() != b_->cols()) {
+      throw std::invalid_argument("preconditioner='jacobi' requires square Kronecker factors");
+    }
+    const Vector da = a_->diagonal();
+    const Vector db = b_->diagonal();
+    Vector diag(rows());
+    for (Eigen::Index i = 0; i < da.size(); ++i) {
+      diag.segment(i * db.size(), db.size()) = da[i] * db;
+    }
+    return diag;
+  }
+
+ private:
+  void apply_impl(const Eigen::Ref<const ColMatrix> &x, Eigen::Ref<ColMatrix> y, bool transpose) const {
+    const Eigen::Index a_in = transpose ? a_->rows() : a_->cols();
+    const Eigen::Index a_out = transpose ? a_->cols() : a_->rows();
+    const Eigen::Index b_in = transpose ? b_->rows() : b_->cols();
+    const Eigen::Index b_out = transpose ? b_->cols() : b_->rows();
+
+    ColMatrix bx(b_out, a_in);
+    ColMatrix bx_t(a_in, b_out);
+    ColMatrix abx_t(a_out, b_out);
+    for (Eigen::Index col = 0; col < x.cols(); ++col) {
+      const Eigen::Map<const ColMatrix> xm(x.col(col).data(), b_in, a_in);
+      transpose ? b_->apply_transpose(xm, bx) : b_->apply(xm, bx);
+      bx_t = bx.transpose();
+      transpose ? a_->apply_transpose(bx_t, abx_t) : a_->apply(bx_t, abx_t);
+      Eigen::Map<ColMatrix>(y.col(col).data(), b_out, a_out) = abx_t.transpose();
+    }
+  }
+
+  LinearOperatorPtr a_;
+  LinearOperatorPtr b_;
+};
+
+class BlockDiagOperator final : public LinearOperator {
+ public:
+  BlockDiagOperator(std::vector<LinearOperatorPtr> blocks, Eigen::Index rows, Eigen::Index cols)
+      : LinearOperator(rows, cols), blocks_(std::move(blocks)) {}
+
+  void apply(const Eigen::Ref<const ColMatrix> &x, Eigen::Ref<ColMatrix> y) const override {
+    Eigen::Index row = 0;
+    Eigen::Index col = 0;
+    for (const LinearOperatorPtr &block : blocks_) {
+      block->apply(x.middleRows(col, block->cols()), y.middleRows(row, block->rows()));
+      row += block->rows();
+      col += block->cols();
+    }
+  }
+
+  void apply_transpose(const Eigen::Ref<const ColMatrix> &x, Eigen::Ref<ColMatrix> y) const override {
+    Eigen::Index row = 0;
+    Eigen::Index col = 0;
+    for (const LinearOperatorPtr &block : blocks_) {
+      block->apply_transpose(x.middleRows(row, block->rows()), y.middleRows(col, block->cols()));
+      row += block->rows();
+      col += block->cols();
+    }
+  }
+
+  Vector diagonal() const override {
+    Vector diag(rows());
+    Eigen::Index offset = 0;
+    for (const LinearOperatorPtr &block : blocks_) {
+      if (block->rows() != block->cols()) {
+        throw std::invalid_argument("preconditioner='jacobi' requires square diagonal blocks");
+      }
+      diag.segment(offset, block->rows()) = block->diagonal();
+      offset += block->rows();
+    }
+    return diag;
+  }
+
+ private:
+  std::vector<LinearOperatorPtr> blocks_;
+};
+
+void check_operand(const LinearOperatorPtr &op) {
+  if (!op) {
+    throw std::invalid_argument("linear operator operand is null");
+  }
+}
+
+template <typename Solver>
+peigen_iterative_result solve_operator_columns(Solver &solver,
+                                               const detail::OperatorRef &mat,
+                                               const Eigen::Ref<const RowMatrix> &rhs,
+                                               Eigen::Map<RowMatrix> out,
+                                               const peigen_iterative_params &params,
+                                               const std::string &name) {
+  solver.setTolerance(params.tol);
+  solver.setMaxIterations(params.maxiter);
+  solver.compute(mat);
+  if (solver.info() != Eigen::Success) {
+    throw std::runtime_error(name + " setup failed");
+  }
+
+  peigen_iterative_result result{};
+  Vector b(rhs.rows());
+  for (Eigen::Index col = 0; col < rhs.cols(); ++col) {
+    b = rhs.col(col);
+    out.col(col) = solver.solve(b);
+    result.iterations = static_cast<int>(solver.iterations());
+    result.error = solver.error();
+    result.column = col;
+    if (solver.info() != Eigen::Success) {
+      throw std::runtime_error(name + " did not converge (iters=" + std::to_string(result.iterations) +
+                               ", error=" + std::to_string(result.error) + ")");
+    }
+  }
+  return result;
+}
+
+}  // namespace
+
+LinearOperatorPtr make_sparse_operator(Sparse mat) {
+  return std::make_shared<SparseOperator>(std::make_shared<const SparseHandle>(std::move(mat)));
+}
+
+LinearOperatorPtr make_sparse_operator(std::shared_ptr<const SparseHandle> mat) {
+  if (!mat) {
+    throw std::invalid_argument("linear operator operand is null");
+  }
+  return std::make_shared<SparseOperator>(std::move(mat));
+}
+
+LinearOperatorPtr make_dense_operator(ColMatrix mat) {
+  return std::make_shared<DenseOperator>(std::move(mat));
+}
+
+LinearOperatorPtr make_identity_operator(Eigen::Index n) {
+  if (n < 0) {
+    throw std::invalid_argument("identity operator size must be non-negative");
+  }
+  return std::make_shared<IdentityOperator>(n);
+}
+
+LinearOperatorPtr make_sum_operator(std::vector<LinearOperatorPtr> terms) {
+  check_same_shape(terms, "operator sum");
+  return std::make_shared<SumOperator>(std::move(terms));
+}
+
+LinearOperatorPtr make_scaled_operator(double alpha, LinearOperatorPtr op) {
+  check_operand(op);
+  return std::make_shared<ScaledOperator>(alpha, std::move(op));
+}
+
+LinearOperatorPtr make_product_operator(std::vector<LinearOperatorPtr> factors) {
+  if (factors.empty()) {
+    throw std::invalid_argument("operator product requires at least one operator");
+  }
+  for (std::size_t i = 0; i < factors.size(); ++i) {
+    check_operand(factors[i]);
+    if (i > 0 && factors[i - 1]->cols() != factors[i]->rows()) {
+      throw std::invalid_argument("operator product dimension mismatch");
+    }
+  }
+  return std::make_shared<ProductOperator>(std::move(factors));
+}
+
+LinearOperatorPtr make_transpose_operator(LinearOperatorPtr op) {
+  check_operand(op);
+  return std::make_shared<TransposeOperator>(std::move(op));
+}
+
+LinearOperatorPtr make_kron_operator(LinearOperatorPtr a, LinearOperatorPtr b) {
+  check_operand(a);
+  check_operand(b);
+  return std::make_shared<KronOperator>(std::move(a), std::move(b));
+}
+
+LinearOperatorPtr make_block_diag_operator(std::vector<LinearOperatorPtr> blocks) {
+  if (blocks.empty()) {
+    throw std::invalid_argument("block-diagonal operator requires at least one block");
+  }
+  Eigen::Index rows = 0;
+  Eigen::Index cols = 0;
+  for (const LinearOperatorPtr &block : blocks) {
+    check_operand(block);
+    rows += block->rows();
+    cols += block->cols();
+  }
+  return std::make_shared<BlockDiagOperator>(std::move(blocks), rows, cols);
+}
+
+peigen_iterative_result operator_iterative_solve(const LinearOperator &op,
+                                                 const Eigen::Ref<const RowMatrix> &rhs,
+                                                 Eigen::Map<RowMatrix> out,
+                                                 const peigen_iterative_params &params) {
+  if (op.rows() != op.cols()) {
+    throw std::invalid_argument("sparse solve requires square matrix");
+  }
+  if (op.rows() != rhs.rows()) {
+    throw std::invalid_argument("sparse solve shape mismatch");
+  }
+
+  const detail::OperatorRef mat(op);
+  switch (params.method) {
+    case PEIGEN_CG_IDENTITY: {
+      Eigen::ConjugateGradient<detail::OperatorRef, Eigen::Lower | Eigen::Upper, Eigen::IdentityPreconditioner> cg;
+      return solve_operator_columns(cg, mat, rhs, out, params, "ConjugateGradient");
+    }
+    case PEIGEN_CG_JACOBI: {
+      Eigen::ConjugateGradient<detail::OperatorRef, Eigen::Lower | Eigen::Upper, detail::OperatorJacobi> cg;
+      return solve_operator_columns(cg, mat, rhs, out, params, "ConjugateGradient");
+    }
+    case PEIGEN_BICGSTAB: {
+      Eigen::BiCGSTAB<detail::OperatorRef, Eigen::IdentityPreconditioner> solver;
+      return solve_operator_columns(solver, mat, rhs, out, params, "BiCGSTAB");
+    }
+    case PEIGEN_CG_ILU:
+      throw std::invalid_argument("preconditioner='ilu' requires an assembled sparse matrix");
+    default:
+      throw std::invalid_argument("unsupported iterative method for a linear operator");
+  }
+}
+
+}  // namespace peigen
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "core/common.h"
+#include "core/sparse.h"
+#include "kernels/kernels.h"
+
+namespace peigen {
+
+// Matrix-free linear operator. Leaves own an assembled sparse or dense matrix; composites
+// (sum, scaled, product, transpose, Kronecker, block-diagonal) only hold their operands, so
+// e.g. K + sigma * M or kron(I, L) never materialize the combined matrix.
+class LinearOperator {
+ public:
+  LinearOperator(Eigen::Index rows, Eigen::Index cols) : rows_(rows), cols_(cols) {}
+  virtual ~LinearOperator() = default;
+
+  Eigen::Index rows() const { return rows_; }
+  Eigen::Index cols() const { return cols_; }
+
+  // y = op * x (resp. op^T * x) for a block of column vectors. y is overwritten and must
+  // not alias x.
+  virtual void apply(const Eigen::Ref<const ColMatrix> &x, Eigen::Ref<ColMatrix> y) const = 0;
+  virtual void apply_transpose(const Eigen::Ref<const ColMatrix> &x, Eigen::Ref<ColMatrix> y) const = 0;
+
+  // Main diagonal, used by the Jacobi preconditioner. Throws std::invalid_argument when it
+  // cannot be formed without assembling the operator (e.g. products).
+  virtual Vector diagonal() const = 0;
+
+ private:
+  Eigen::Index rows_;
+  Eigen::Index cols_;
+};
+
+using LinearOperatorPtr = std::shared_ptr<LinearOperator>;
+
+LinearOperatorPtr make_sparse_operator(Sparse mat);
+// Shares the handle's storage (and its cached diagonal) instead of copying.
+LinearOperatorPtr make_sparse_operator(std::shared_ptr<const SparseHandle> mat);
+LinearOperatorPtr make_dense_operator(ColMatrix mat);
+LinearOperatorPtr make_identity_operator(Eigen::Index n);
+LinearOperatorPtr make_sum_operator(std::vector<LinearOperatorPtr> terms);
+LinearOperatorPtr make_scaled_operator(double alpha, LinearOperatorPtr op);
+// factors[0] * factors[1] * ... (applied right to left).
+LinearOperatorPtr make_product_operator(std::vector<LinearOperatorPtr> factors);
+LinearOperatorPtr make_transpose_operator(LinearOperatorPtr op);
+LinearOperatorPtr make_kron_operator(LinearOperatorPtr a, LinearOperatorPtr b);
+LinearOperatorPtr make_block_diag_operator(std::vector<LinearOperatorPtr> blocks);
+
+// Runs CG/BiCGSTAB through Eigen's matrix-free solver interface; rhs and out are row-major
+// (n x k). Supports the identity and Jacobi preconditioners (ILU needs an assembled matrix).
+peigen_iterative_result operator_iterative_solve(const LinearOperator &op,
+                                                 const Eigen::Ref<const RowMatrix> &rhs,
+                                                 Eigen::Map<RowMatrix> out,
+                                                 const peigen_iterative_params &params);
+
+}  // namespace peigen
@@ -0,0 +1,377 @@
+#include "core/ordering.h"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+#include <Eigen/OrderingMethods>
+
+namespace peigen {
+
+namespace {
+
+using Permutation = Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic, int>;
+
+// Adjacency of A + A^T without self loops, in compressed form.
+struct Graph {
+  std::vector<int> xadj;
+  std::vector<int> adj;
+
+  int size() const { return static_cast<int>(xadj.size()) - 1; }
+  int degree(int v) const { return xadj[v + 1] - xadj[v]; }
+};
+
+Graph symmetric_graph(const Eigen::Map<const Sparse> &mat) {
+  const int n = static_cast<int>(mat.rows());
+  const int *outer = mat.outerIndexPtr();
+  const int *inner = mat.innerIndexPtr();
+
+  std::vector<int> count(static_cast<std::size_t>(n) + 1, 0);
+  for (int j = 0; j < n; ++j) {
+    for (int p = outer[j]; p < outer[j + 1]; ++p) {
+      if (inner[p] != j) {
+        ++count[inner[p] + 1];
+        ++count[j + 1];
+      }
+    }
+  }
+  std::partial_sum(count.begin(), count.end(), count.begin());
+
+  std::vector<int> adj(static_cast<std::size_t>(count[n]));
+  std::vector<int> cursor(count.begin(), count.end() - 1);
+  for (int j = 0; j < n; ++j) {
+    for (int p = outer[j]; p < outer[j + 1]; ++p) {
+      const int i = inner[p];
+      if (i != j) {
+        adj[cursor[i]++] = j;
+        adj[cursor[j]++] = i;
+      }
+    }
+  }
+
+  // Drop the duplicates that symmetric input produces.
+  Graph g;
+  g.xadj.assign(static_cast<std::size_t>(n) + 1, 0);
+  g.adj.reserve(adj.size());
+  for (int v = 0; v < n; ++v) {
+    auto first = adj.begin() + count[v];
+    auto last = adj.begin() + count[v + 1];
+    std::sort(first, last);
+    last = std::unique(first, last);
+    g.adj.insert(g.adj.end(), first, last);
+    g.xadj[v + 1] = static_cast<int>(g.adj.size());
+  }
+  return g;
+}
+
+// Breadth-first level structure over the nodes with part[v] == tag. `order` receives the
+// visited nodes level by level and `level_ptr` the level offsets into it. `level` is
+// scratch (all -1 on entry) and is restored before returning.
+void level_structure(const Graph &g,
+                     int root,
+                     const std::vector<int> &part,
+                     int tag,
+                     std::vector<int> &level,
+                     std::vector<int> &order,
+                     std::vector<int> &level_ptr) {
+  order.clear();
+  level_ptr.assign(1, 0);
+  order.push_back(root);
+  level[root] = 0;
+  std::size_t head = 0;
+  while (head < order.size()) {
+    const std::size_t end = order.size();
+    for (; head < end; ++head) {
+      const int u = order[head];
+      for (int p = g.xadj[u]; p < g.xadj[u + 1]; ++p) {
+        const int w = g.adj[p];
+        if (part[w] == tag && level[w] < 0) {
+          level[w] = static_cast<int>(level_ptr.size());
+          order.push_back(w);
+        }
+      }
+    }
+    level_ptr.push_back(static_cast<int>(end));
+  }
+  for (const int v : order) {
+    level[v] = -1;
+  }
+}
+
+// George-Liu pseudo-peripheral node search, restricted to part == tag. On return `order`
+// and `level_ptr` hold the level structure rooted at the returned node.
+int pseudo_peripheral_node(const Graph &g,
+                           int start,
+                           const std::vector<int> &part,
+                           int tag,
+                           std::vector<int> &level,
+                           std::vector<int> &order,
+                           std::vector<int> &level_ptr) {
+  int root = start;
+  level_structure(g, root, part, tag, level, order, level_ptr);
+  for (;;) {
+    const std::size_t depth = level_ptr.size();
+    int candidate = order[level_ptr[depth - 2]];
+    for (int k = level_ptr[depth - 2]; k < level_ptr[depth - 1]; ++k) {
+      if (g.degree(order[k]) < g.degree(candidate)) {
+        candidate = order[k];
+      }
+    }
+    std::vector<int> cand_order;
+    std::vector<int> cand_ptr;
+    level_structure(g, candidate, part, tag, level, cand_order, cand_ptr);
+    if (cand_ptr.size() <= depth) {
+      return root;
+    }
+    root = candidate;
+    order.swap(cand_order);
+    level_ptr.swap(cand_ptr);
+  }
+}
+
+std::vector<int> reverse_cuthill_mckee(const Graph &g) {
+  const int n = g.size();
+  std::vector<int> part(static_cast<std::size_t>(n), 0);  // 1 once placed
+  std::vector<int> level(static_cast<std::size_t>(n), -1);
+  std::vector<int> order;
+  std::vector<int> level_ptr;
+  std::vector<int> perm;
+  perm.reserve(static_cast<std::size_t>(n));
+
+  for (int v = 0; v < n; ++v) {
+    if (part[v] != 0) {
+      continue;
+    }
+    const int root = pseudo_peripheral_node(g, v, part, 0, level, order, level_ptr);
+    std::size_t head = perm.size();
+    perm.push_back(root);
+    part[root] = 1;
+    while (head < perm.size()) {
+      const int u = perm[head++];
+      const std::size_t first = perm.size();
+      for (int p = g.xadj[u]; p < g.xadj[u + 1]; ++p) {
+        const int w = g.adj[p];
+        if (part[w] == 0) {
+          part[w] = 1;
+          perm.push_back(w);
+        }
+      }
+      std::stable_sort(perm.begin() + static_cast<std::ptrdiff_t>(first), perm.end(),
+                       [&g](int a, int b) { return g.degree(a) < g.degree(b); });
+    }
+  }
+  std::reverse(perm.begin(), perm.end());
+  return perm;
+}
+
+// Nested dissection: bisect each connected piece at the middle level of a
+// pseudo-peripheral level structure, order both halves recursively and the separator last.
+class NestedDissection {
+ public:
+  explicit NestedDissection(const Graph &g)
+      : g_(g),
+        part_(static_cast<std::size_t>(g.size()), 0),
+        level_(static_cast<std::size_t>(g.size()), -1) {}
+
+  std::vector<int> run() {
+    std::vector<int> nodes(static_cast<std::size_t>(g_.size()));
+    std::iota(nodes.begin(), nodes.end(), 0);
+    perm_.reserve(nodes.size());
+    order(nodes, 0);
+    return std::move(perm_);
+  }
+
+ private:
+  static constexpr std::size_t kLeafSize = 64;
+  static constexpr int kPlaced = -1;
+
+  // All `nodes` carry part_ == tag.
+  void order(const std::vector<int> &nodes, int tag) {
+    if (nodes.size() <= kLeafSize) {
+      emit(nodes);
+      return;
+    }
+    std::vector<int> level_order;
+    std::vector<int> level_ptr;
+    for (const int v : nodes) {
+      if (part_[v] != tag) {
+        continue;
+      }
+      pseudo_peripheral_node(g_, v, part_, tag, level_, level_order, level_ptr);
+      const int depth = static_cast<int>(level_ptr.size()) - 1;
+      if (level_order.size() <= kLeafSize || depth < 3) {
+        emit(level_order);
+        continue;
+      }
+      bisect(level_order, level_ptr);
+    }
+  }
+
+  void bisect(const std::vector<int> &level_order, const std::vector<int> &level_ptr) {
+    const int depth = static_cast<int>(level_ptr.size()) - 1;
+    const int half = static_cast<int>(level_order.size()) / 2;
+    int mid = 1;
+    while (mid < depth - 2 && level_ptr[mid + 1] <= half) {
+      ++mid;
+    }
+
+    const int tag_a = next_tag_++;
+    const int tag_b = next_tag_++;
+    std::vector<int> part_a(level_order.begin(), level_order.begin() + level_ptr[mid]);
+    std::vector<int> part_b(level_order.begin() + level_ptr[mid + 1], level_order.end());
+    for (const int v : part_a) {
+      part_[v] = tag_a;
+    }
+    for (const int v : part_b) {
+      part_[v] = tag_b;
+    }
+
+    // Separator nodes with no neighbour beyond the separator can join the first half.
+    std::vector<int> separator;
+    for (int k = level_ptr[mid]; k < level_ptr[mid + 1]; ++k) {
+      const int v = level_order[k];
+      bool touches_b = false;
+      for (int p = g_.xadj[v]; p < g_.xadj[v + 1] && !touches_b; ++p) {
+        touches_b = part_[g_.adj[p]] == tag_b;
+      }
+      if (touches_b) {
+        separator.push_back(v);
+        part_[v] = kPlaced;
+      } else {
+        part_a.push_back(v);
+        part_[v] = tag_a;
+      }
+    }
+
+    order(part_a, tag_a);
+    order(part_b, tag_b);
+    emit(separator);
+  }
+
+  void emit(const std::vector<int> &nodes) {
+    for (const int v : nodes) {
+      part_[v] = kPlaced;
+      perm_.push_back(v);
+    }
+  }
+
+  const Graph &g_;
+  std::vector<int> part_;
+  std::vector<int> level_;
+  std::vector<int> perm_;
+  int next_tag_ = 1;
+};
+
+void require_square(const Eigen::Map<const Sparse> &mat, const std::string &method) {
+  if (mat.rows() != mat.cols()) {
+    throw std::invalid_argument("ordering '" + method + "' requires a square matrix");
+  }
+}
+
+}  // namespace
+
+bool ordering_is_symmetric(const std::string &method) {
+  return method != "colamd";
+}
+
+std::vector<int> sparse_ordering(const Eigen::Map<const Sparse> &mat, const std::string &method) {
+  if (method == "rcm") {
+    require_square(mat, method);
+    return reverse_cuthill_mckee(symmetric_graph(mat));
+  }
+  if (method == "nd") {
+    require_square(mat, method);
+    return NestedDissection(symmetric_graph(mat)).run();
+  }
+  if (method == "amd") {
+    require_square(mat, method);
+    if (mat.rows() == 0) {
+      return {};
+    }
+    // Eigen's AMD returns the new -> old map directly.
+    Permutation perm;
+    Eigen::AMDOrdering<int>()(Sparse(mat), perm);
+    return std::vector<int>(perm.indices().data(), perm.indices().data() + perm.size());
+  }
+  if (method == "colamd") {
+    if (mat.cols() == 0) {
+      return {};
+    }
+    // COLAMDOrdering returns old -> new; invert it.
+    Permutation perm;
+    Eigen::COLAMDOrdering<int>()(Sparse(mat), perm);
+    std::vector<int> out(static_cast<std::size_t>(perm.size()));
+    for (int k = 0; k < perm.size(); ++k) {
+      out[perm.indices()[k]] = k;
+    }
+    return out;
+  }
+  throw std::invalid_argument("ordering method must be one of: rcm, amd, colamd, nd");
+}
+
+void validate_permutation(const std::vector<int> &perm, Eigen::Index n) {
+  if (static_cast<Eigen::Index>(perm.size()) != n) {
+    throw std::invalid_argument("permutation length does not match the matrix");
+  }
+  std::vector<char> seen(perm.size(), 0);
+  for (const int v : perm) {
+    if (v < 0 || v >= n || seen[v]) {
+      throw std::invalid_argument("permutation must contain each index 0..n-1 exactly once");
+    }
+    seen[v] = 1;
+  }
+}
+
+Sparse permute_sparse(const Eigen::Map<const Sparse> &mat,
+                      const std::vector<int> &row_perm,
+                      const std::vector<int> &col_perm) {
+  if (!row_perm.empty()) {
+    validate_permutation(row_perm, mat.rows());
+  }
+  if (!col_perm.empty()) {
+    validate_permutation(col_perm, mat.cols());
+  }
+  const int *outer = mat.outerIndexPtr();
+  const int *inner = mat.innerIndexPtr();
+  const double *values = mat.valuePtr();
+  const Eigen::Index cols = mat.cols();
+
+  std::vector<int> row_new;
+  if (!row_perm.empty()) {
+    row_new.resize(row_perm.size());
+    for (std::size_t k = 0; k < row_perm.size(); ++k) {
+      row_new[row_perm[k]] = static_cast<int>(k);
+    }
+  }
+
+  std::vector<int> out_outer(static_cast<std::size_t>(cols) + 1, 0);
+  std::vector<int> out_inner(static_cast<std::size_t>(mat.nonZeros()));
+  std::vector<double> out_values(static_cast<std::size_t>(mat.nonZeros()));
+  std::vector<std::pair<int, double>> column;
+  for (Eigen::Index l = 0; l < cols; ++l) {
+    const int j = col_perm.empty() ? static_cast<int>(l) : col_perm[l];
+    const int start = out_outer[l];
+    out_outer[l + 1] = start + (outer[j + 1] - outer[j]);
+    if (row_new.empty()) {
+      std::copy(inner + outer[j], inner + outer[j + 1], out_inner.begin() + start);
+      std::copy(values + outer[j], values + outer[j + 1], out_values.begin() + start);
+      continue;
+    }
+    column.clear();
+    for (int p = outer[j]; p < outer[j + 1]; ++p) {
+      column.emplace_back(row_new[inner[p]], values[p]);
+    }
+    std::sort(column.begin(), column.end(),
+              [](const std::pair<int, double> &a, const std::pair<int, double> &b) { return a.first < b.first; });
+    for (std::size_t k = 0; k < column.size(); ++k) {
+      out_inner[start + k] = column[k].first;
+      out_values[start + k] = column[k].second;
+    }
+  }
+
+  return Sparse(Eigen::Map<const Sparse>(mat.rows(), cols, mat.nonZeros(), out_outer.data(), out_inner.data(),
+                                         out_values.data()));
+}
+
+}  // namespace peigen
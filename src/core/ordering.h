@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "core/common.h"
+
+namespace peigen {
+
+// Fill- and bandwidth-reducing orderings. All permutations use the "new -> old" convention
+// (perm[k] is the original index placed at position k), so the reordered matrix is
+// A[perm][:, perm] for symmetric orderings and A[:, perm] for column orderings.
+//
+//   rcm     reverse Cuthill-McKee on the pattern of A + A^T (bandwidth / locality)
+//   amd     approximate minimum degree on A + A^T (Cholesky / LU fill)
+//   colamd  column approximate minimum degree on A (LU/QR fill; columns only)
+//   nd      nested dissection by recursive level-structure bisection on A + A^T
+//
+// Throws std::invalid_argument for unknown methods and for non-square input to the
+// symmetric orderings.
+std::vector<int> sparse_ordering(const Eigen::Map<const Sparse> &mat, const std::string &method);
+
+// True when `method` permutes rows and columns together (everything but colamd).
+bool ordering_is_symmetric(const std::string &method);
+
+// B(k, l) = A(row_perm[k], col_perm[l]); an empty permutation leaves that side unchanged.
+Sparse permute_sparse(const Eigen::Map<const Sparse> &mat,
+                      const std::vector<int> &row_perm,
+                      const std::vector<int> &col_perm);
+
+// Throws std::invalid_argument unless perm is a permutation of 0..n-1.
+void validate_permutation(const std::vector<int> &perm, Eigen::Index n);
+
+}  // namespace peigen
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "core/common.h"
+
+namespace peigen {
+
+// Outcome of mixed-precision iterative refinement, aggregated over right-hand sides.
+struct RefinementInfo {
+  int iterations = 0;           // most correction steps taken by any column
+  double backward_error = 0.0;  // max_j ||r_j||_inf / (||A||_inf ||x_j||_inf)
+  bool fallback = false;        // true when the double-precision solver produced x
+};
+
+// Same cap as LAPACK's dsgesv (ITERMAX).
+constexpr int kMaxRefinementIterations = 30;
+
+// Largest float magnitude the low-precision factorization can represent.
+inline bool fits_single_precision(double max_abs) {
+  return std::isfinite(max_abs) && max_abs <= static_cast<double>(std::numeric_limits<float>::max());
+}
+
+// Refines one column following dsgesv: x = S(b), then r = b - A x and x += S(r) until
+// ||r||_inf <= ||x||_inf * ||A||_inf * eps * sqrt(n). `apply(x, y)` computes y = A x in double
+// precision and `solve_low(r, d)` solves A d = r with the single-precision factors. Returns
+// false when the tolerance is not met within max_iterations (the caller then falls back).
+template <typename Apply, typename SolveLow>
+bool refine_column(const Apply &apply,
+                   const SolveLow &solve_low,
+                   double a_norm,
+                   const Eigen::Ref<const Vector> &b,
+                   Eigen::Ref<Vector> x,
+                   RefinementInfo &info,
+                   int max_iterations = kMaxRefinementIterations) {
+  const Eigen::Index n = b.size();
+  const double cte = a_norm * std::numeric_limits<double>::epsilon() * std::sqrt(static_cast<double>(n));
+  Vector r(n);
+  Vector d(n);
+
+  solve_low(b, x);
+  for (int iteration = 0;; ++iteration) {
+    apply(x, r);
+    r = b - r;
+    const double r_norm = r.lpNorm<Eigen::Infinity>();
+    const double x_norm = x.lpNorm<Eigen::Infinity>();
+    if (!std::isfinite(r_norm) || !std::isfinite(x_norm)) {
+      return false;
+    }
+    if (r_norm <= x_norm * cte) {
+      info.iterations = std::max(info.iterations, iteration);
+      const double scale = a_norm * x_norm;
+      info.backward_error = std::max(info.backward_error, scale > 0.0 ? r_norm / scale : 0.0);
+      return true;
+    }
+    if (iteration == max_iterations) {
+      return false;
+    }
+    solve_low(r, d);
+    x += d;
+  }
+}
+
+}  // namespace peigen
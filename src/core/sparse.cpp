@@ -0,0 +1,215 @@
+#include "core/sparse.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "core/dispatch.h"
+#include "core/factor_cache.h"
+
+namespace peigen {
+
+SparseHandle::SparseHandle(Sparse mat) : mat_(std::move(mat)) {
+  mat_.makeCompressed();
+}
+
+Eigen::Map<const Sparse> SparseHandle::map() const {
+  return Eigen::Map<const Sparse>(mat_.rows(), mat_.cols(), mat_.nonZeros(), mat_.outerIndexPtr(),
+                                  mat_.innerIndexPtr(), mat_.valuePtr());
+}
+
+const Vector &SparseHandle::diagonal() const {
+  std::call_once(diagonal_once_, [this] { diagonal_ = mat_.diagonal(); });
+  return diagonal_;
+}
+
+const std::shared_ptr<SparseHandle> &SparseHandle::transpose() const {
+  std::call_once(transpose_once_, [this] { transpose_ = std::make_shared<SparseHandle>(Sparse(mat_.transpose())); });
+  return transpose_;
+}
+
+Eigen::Map<const RowSparse> SparseHandle::csr() const {
+  const Sparse &t = transpose()->csc();
+  return Eigen::Map<const RowSparse>(mat_.rows(), mat_.cols(), t.nonZeros(), t.outerIndexPtr(), t.innerIndexPtr(),
+                                     t.valuePtr());
+}
+
+MixedSparseLU::MixedSparseLU(Sparse mat) : mat_(std::move(mat)) {
+  mat_.makeCompressed();
+  Vector row_sums = Vector::Zero(mat_.rows());
+  double max_abs = 0.0;
+  for (Eigen::Index j = 0; j < mat_.outerSize(); ++j) {
+    for (Sparse::InnerIterator it(mat_, j); it; ++it) {
+      row_sums[it.row()] += std::abs(it.value());
+      max_abs = std::max(max_abs, std::abs(it.value()));
+    }
+  }
+  norm_inf_ = mat_.rows() > 0 ? row_sums.maxCoeff() : 0.0;
+  if (!fits_single_precision(max_abs)) {
+    return;
+  }
+
+  const SparseF single = mat_.cast<float>();
+  auto lu = std::make_unique<Eigen::SparseLU<SparseF>>();
+  lu->analyzePattern(single);
+  lu->factorize(single);
+  if (lu->info() == Eigen::Success) {
+    single_ = std::move(lu);
+  }
+}
+
+const Eigen::SparseLU<Sparse> &MixedSparseLU::double_lu() const {
+  std::call_once(double_once_, [this] {
+    auto lu = std::make_unique<Eigen::SparseLU<Sparse>>();
+    lu->analyzePattern(mat_);
+    lu->factorize(mat_);
+    if (lu->info() != Eigen::Success) {
+      throw std::runtime_error("sparse factorization failed");
+    }
+    double_ = std::move(lu);
+  });
+  return *double_;
+}
+
+RefinementInfo MixedSparseLU::solve(const Eigen::Ref<const Vector> &b, Eigen::Ref<Vector> x) const {
+  RefinementInfo info;
+  if (single_ && fits_single_precision(b.size() > 0 ? b.cwiseAbs().maxCoeff() : 0.0)) {
+    const auto apply = [this](const Eigen::Ref<const Vector> &v, Eigen::Ref<Vector> y) { y.noalias() = mat_ * v; };
+    const auto solve_low = [this](const Eigen::Ref<const Vector> &r, Eigen::Ref<Vector> d) {
+      const Eigen::VectorXf rf = r.cast<float>();
+      d = single_->solve(rf).cast<double>();
+    };
+    if (refine_column(apply, solve_low, norm_inf_, b, x, info)) {
+      return info;
+    }
+  }
+
+  info = RefinementInfo{};
+  info.fallback = true;
+  x = double_lu().solve(b);
+  const double scale = norm_inf_ * x.lpNorm<Eigen::Infinity>();
+  info.backward_error = scale > 0.0 ? (b - mat_ * x).lpNorm<Eigen::Infinity>() / scale : 0.0;
+  return info;
+}
+
+peigen_csc csc_view(const Eigen::Map<const Sparse> &mat) {
+  return peigen_csc{mat.rows(), mat.cols(), mat.nonZeros(), mat.outerIndexPtr(), mat.innerIndexPtr(),
+                    mat.valuePtr()};
+}
+
+void spmm(const Eigen::Map<const Sparse> &mat, const double *rhs, Eigen::Index rhs_cols, double *out) {
+  const peigen_csc csc = csc_view(mat);
+  kernels().spmm(&csc, rhs, rhs_cols, out);
+}
+
+void spmm_axpby(const Eigen::Map<const Sparse> &mat, bool transpose, double alpha, const double *rhs,
+                Eigen::Index rhs_cols, double beta, double *out) {
+  const peigen_csc csc = csc_view(mat);
+  kernels().spmm_axpby(&csc, transpose ? 1 : 0, alpha, rhs, rhs_cols, beta, out);
+}
+
+void normal_spmm(const Eigen::Map<const Sparse> &mat, const double *rhs, Eigen::Index rhs_cols, double *out) {
+  const peigen_csc csc = csc_view(mat);
+  kernels().normal_spmm(&csc, rhs, rhs_cols, out);
+}
+
+void sddmm(const Eigen::Map<const Sparse> &mat, const double *x, const double *y, Eigen::Index k, double *values) {
+  const peigen_csc csc = csc_view(mat);
+  kernels().sddmm(&csc, x, y, k, values);
+}
+
+static std::shared_ptr<const Eigen::SparseLU<Sparse>> factor_sparse_lu(const Eigen::Map<const Sparse> &mat) {
+  auto lu = std::make_shared<Eigen::SparseLU<Sparse>>();
+  lu->analyzePattern(mat);
+  lu->factorize(mat);
+  if (lu->info() != Eigen::Success) {
+    throw std::runtime_error("SparseLU factorization failed");
+  }
+  return lu;
+}
+
+void sparse_lu_solve(const Eigen::Map<const Sparse> &mat, const Eigen::Ref<const RowMatrix> &rhs,
+                     Eigen::Map<RowMatrix> out) {
+  std::shared_ptr<const Eigen::SparseLU<Sparse>> lu;
+  if (factor_cache_enabled()) {
+    lu = cached_factor<Eigen::SparseLU<Sparse>>(sparse_fingerprint("sparse_lu", mat), [&mat]() {
+      std::shared_ptr<const Eigen::SparseLU<Sparse>> built = factor_sparse_lu(mat);
+      // Values plus row indices of L and U, and the two permutations.
+      const std::size_t entries = static_cast<std::size_t>(built->nnzL() + built->nnzU());
+      const std::size_t bytes = entries * (sizeof(double) + sizeof(int)) +
+                                static_cast<std::size_t>(mat.rows() + mat.cols()) * sizeof(int);
+      return std::make_pair(std::move(built), bytes);
+    });
+  } else {
+    lu = factor_sparse_lu(mat);
+  }
+  for (Eigen::Index col = 0; col < rhs.cols(); ++col) {
+    out.col(col) = lu->solve(rhs.col(col));
+    if (lu->info() != Eigen::Success) {
+      throw std::runtime_error("SparseLU solve failed");
+    }
+  }
+}
+
+peigen_iterative_params resolve_iterative_params(const std::string &method,
+                                                 const std::string &preconditioner,
+                                                 double effective_tol,
+                                                 int effective_maxiter,
+                                                 int ilu_fill_factor,
+                                                 double ilu_drop_tol) {
+  peigen_iterative_params params{};
+  params.tol = effective_tol;
+  params.maxiter = effective_maxiter;
+  params.ilu_fill_factor = ilu_fill_factor;
+  params.ilu_drop_tol = ilu_drop_tol;
+
+  if (method == "bicgstab") {
+    params.method = PEIGEN_BICGSTAB;
+    return params;
+  }
+  if (preconditioner == "none") {
+    params.method = PEIGEN_CG_IDENTITY;
+  } else if (preconditioner == "jacobi") {
+    params.method = PEIGEN_CG_JACOBI;
+  } else if (preconditioner == "ilu") {
+    if (ilu_fill_factor <= 0) {
+      throw std::invalid_argument("ilu_fill_factor must be positive when preconditioner='ilu'");
+    }
+    if (ilu_drop_tol < 0.0) {
+      throw std::invalid_argument("ilu_drop_tol must be non-negative when preconditioner='ilu'");
+    }
+    params.method = PEIGEN_CG_ILU;
+  } else {
+    throw std::invalid_argument("preconditioner must be one of: none, jacobi, ilu");
+  }
+  return params;
+}
+
+// Runs CG/BiCGSTAB through the dispatched kernel variant; rhs and out are row-major (n x k).
+peigen_iterative_result run_iterative_kernel(const Eigen::Map<const Sparse> &mat,
+                                             const double *rhs,
+                                             Eigen::Index rhs_cols,
+                                             double *out,
+                                             const peigen_iterative_params &params) {
+  const peigen_csc csc = csc_view(mat);
+  peigen_iterative_result result{};
+  const int status = kernels().iterative_solve(&csc, rhs, rhs_cols, out, &params, &result);
+
+  const std::string name = params.method == PEIGEN_BICGSTAB ? "BiCGSTAB" : "ConjugateGradient";
+  if (status == PEIGEN_KERNEL_SETUP_FAILED) {
+    throw std::runtime_error(name + " setup failed");
+  }
+  if (status == PEIGEN_KERNEL_NOT_CONVERGED) {
+    throw std::runtime_error(name + " did not converge (iters=" + std::to_string(result.iterations) +
+                             ", error=" + std::to_string(result.error) + ")");
+  }
+  if (status != PEIGEN_KERNEL_OK) {
+    throw std::runtime_error(name + " kernel rejected its arguments");
+  }
+  return result;
+}
+
+}  // namespace peigen
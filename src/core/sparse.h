@@ -0,0 +1,99 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <Eigen/SparseLU>
+
+#include "core/common.h"
+#include "core/refinement.h"
+#include "kernels/kernels.h"
+
+namespace peigen {
+
+// Owned CSC matrix with lazily computed derived forms (diagonal, transpose, CSR). Backs the
+// persistent peigen.sparse.Matrix handle and sparse LinearOperator leaves; derived forms are
+// built at most once and are safe to request from several threads.
+class SparseHandle {
+ public:
+  explicit SparseHandle(Sparse mat);
+  SparseHandle(const SparseHandle &) = delete;
+  SparseHandle &operator=(const SparseHandle &) = delete;
+
+  const Sparse &csc() const { return mat_; }
+  Eigen::Map<const Sparse> map() const;
+  const Vector &diagonal() const;
+  // The transpose is itself a handle; its CSC arrays are the CSR arrays of this matrix.
+  const std::shared_ptr<SparseHandle> &transpose() const;
+  Eigen::Map<const RowSparse> csr() const;
+
+ private:
+  Sparse mat_;
+  mutable std::once_flag diagonal_once_;
+  mutable std::once_flag transpose_once_;
+  mutable Vector diagonal_;
+  mutable std::shared_ptr<SparseHandle> transpose_;
+};
+
+// SparseLU in float plus iterative refinement against the double-precision matrix. When the
+// matrix does not fit in float, the float factorization fails, or a column stalls, solves
+// use a double-precision SparseLU built on first need. solve() may run concurrently.
+class MixedSparseLU {
+ public:
+  explicit MixedSparseLU(Sparse mat);
+
+  Eigen::Index rows() const { return mat_.rows(); }
+  // True when solves start from the float factors (false after a factorization fallback).
+  bool single_precision() const { return single_ != nullptr; }
+
+  RefinementInfo solve(const Eigen::Ref<const Vector> &b, Eigen::Ref<Vector> x) const;
+
+ private:
+  using SparseF = Eigen::SparseMatrix<float, Eigen::ColMajor, int>;
+
+  const Eigen::SparseLU<Sparse> &double_lu() const;
+
+  Sparse mat_;
+  double norm_inf_ = 0.0;
+  std::unique_ptr<Eigen::SparseLU<SparseF>> single_;
+  mutable std::once_flag double_once_;
+  mutable std::unique_ptr<Eigen::SparseLU<Sparse>> double_;
+};
+
+peigen_csc csc_view(const Eigen::Map<const Sparse> &mat);
+
+// out (rows x k) = mat * rhs (cols x k); rhs and out are row-major and contiguous.
+void spmm(const Eigen::Map<const Sparse> &mat, const double *rhs, Eigen::Index rhs_cols, double *out);
+
+// out = alpha * op(mat) * rhs + beta * out, op(mat) = mat^T when `transpose`; rhs and out are
+// row-major. With beta == 0 the previous contents of out are ignored.
+void spmm_axpby(const Eigen::Map<const Sparse> &mat, bool transpose, double alpha, const double *rhs,
+                Eigen::Index rhs_cols, double beta, double *out);
+
+// out (cols x k) = mat^T * (mat * rhs) without forming mat^T or mat^T mat.
+void normal_spmm(const Eigen::Map<const Sparse> &mat, const double *rhs, Eigen::Index rhs_cols, double *out);
+
+// Sampled dense-dense product: values[p] = mat.values[p] * (x * y^T)(i, j) for every stored
+// entry (i, j); x is rows x k, y is cols x k (row-major), values follows mat's storage order.
+void sddmm(const Eigen::Map<const Sparse> &mat, const double *x, const double *y, Eigen::Index k, double *values);
+
+// Direct solve with Eigen SparseLU, column by column.
+void sparse_lu_solve(const Eigen::Map<const Sparse> &mat, const Eigen::Ref<const RowMatrix> &rhs,
+                     Eigen::Map<RowMatrix> out);
+
+peigen_iterative_params resolve_iterative_params(const std::string &method,
+                                                 const std::string &preconditioner,
+                                                 double effective_tol,
+                                                 int effective_maxiter,
+                                                 int ilu_fill_factor,
+                                                 double ilu_drop_tol);
+
+// Runs CG/BiCGSTAB through the dispatched kernel variant; rhs and out are row-major (n x k).
+peigen_iterative_result run_iterative_kernel(const Eigen::Map<const Sparse> &mat,
+                                             const double *rhs,
+                                             Eigen::Index rhs_cols,
+                                             double *out,
+                                             const peigen_iterative_params &params);
+
+}  // namespace peigen
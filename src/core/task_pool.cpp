@@ -0,0 +1,177 @@
+#include "core/task_pool.h"
+
+#include <stdexcept>
+#include <utility>
+
+namespace peigen {
+
+namespace {
+
+thread_local const TaskPool *tls_pool = nullptr;
+thread_local std::size_t tls_index = 0;
+
+int hardware_threads() {
+  const unsigned hw = std::thread::hardware_concurrency();
+  return hw > 0 ? static_cast<int>(hw) : 1;
+}
+
+}  // namespace
+
+TaskPool &TaskPool::instance() {
+  static TaskPool pool;
+  return pool;
+}
+
+TaskPool::~TaskPool() {
+  std::lock_guard<std::mutex> lock(lifecycle_mutex_);
+  {
+    std::unique_lock<std::mutex> sleep(sleep_mutex_);
+    idle_.wait(sleep, [this] { return in_flight_.load() == 0; });
+  }
+  stop_locked();
+}
+
+void TaskPool::submit(Task task) {
+  std::size_t index = 0;
+  if (tls_pool == this) {
+    // Continuations from a running task: the pool cannot be resized or stopped while that
+    // task is in flight, so the worker's own queue is safe to use without the lifecycle lock.
+    in_flight_.fetch_add(1);
+    index = tls_index;
+  } else {
+    std::lock_guard<std::mutex> lock(lifecycle_mutex_);
+    if (workers_.empty()) {
+      start_locked();
+    }
+    in_flight_.fetch_add(1);
+    index = next_queue_.fetch_add(1) % queues_.size();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+    queues_[index]->tasks.push_back(std::move(task));
+  }
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    ++pending_;
+  }
+  wake_.notify_one();
+}
+
+void TaskPool::resize(int n) {
+  if (n < 0) {
+    throw std::invalid_argument("number of async workers must be non-negative (0 selects the default)");
+  }
+  std::lock_guard<std::mutex> lock(lifecycle_mutex_);
+  if (in_flight_.load() != 0) {
+    throw std::runtime_error("cannot resize the async pool while tasks are running");
+  }
+  requested_size_ = n;
+  stop_locked();
+}
+
+int TaskPool::size() const {
+  std::lock_guard<std::mutex> lock(lifecycle_mutex_);
+  return requested_size_ > 0 ? requested_size_ : hardware_threads();
+}
+
+std::size_t TaskPool::in_flight() const {
+  return in_flight_.load();
+}
+
+void TaskPool::shutdown() {
+  if (tls_pool == this) {
+    throw std::runtime_error("cannot shut down the async pool from one of its tasks");
+  }
+  std::lock_guard<std::mutex> lock(lifecycle_mutex_);
+  {
+    std::unique_lock<std::mutex> sleep(sleep_mutex_);
+    idle_.wait(sleep, [this] { return in_flight_.load() == 0; });
+  }
+  stop_locked();
+}
+
+void TaskPool::start_locked() {
+  const std::size_t n = static_cast<std::size_t>(requested_size_ > 0 ? requested_size_ : hardware_threads());
+  queues_.clear();
+  for (std::size_t i = 0; i < n; ++i) {
+    queues_.push_back(std::make_unique<Queue>());
+  }
+  workers_.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    workers_.emplace_back([this, i] { worker_loop(i); });
+  }
+}
+
+void TaskPool::stop_locked() {
+  if (workers_.empty()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> sleep(sleep_mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  for (std::thread &worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+  queues_.clear();
+  std::lock_guard<std::mutex> sleep(sleep_mutex_);
+  stopping_ = false;
+  pending_ = 0;
+}
+
+bool TaskPool::pop_local(std::size_t index, Task &task) {
+  Queue &queue = *queues_[index];
+  std::lock_guard<std::mutex> lock(queue.mutex);
+  if (queue.tasks.empty()) {
+    return false;
+  }
+  task = std::move(queue.tasks.back());
+  queue.tasks.pop_back();
+  return true;
+}
+
+bool TaskPool::steal(std::size_t thief, Task &task) {
+  const std::size_t n = queues_.size();
+  for (std::size_t offset = 1; offset < n; ++offset) {
+    Queue &victim = *queues_[(thief + offset) % n];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+void TaskPool::worker_loop(std::size_t index) {
+  tls_pool = this;
+  tls_index = index;
+  for (;;) {
+    Task task;
+    if (pop_local(index, task) || steal(index, task)) {
+      {
+        std::lock_guard<std::mutex> sleep(sleep_mutex_);
+        --pending_;
+      }
+      task();
+      task = nullptr;
+      if (in_flight_.fetch_sub(1) == 1) {
+        std::lock_guard<std::mutex> sleep(sleep_mutex_);
+        idle_.notify_all();
+      }
+      continue;
+    }
+
+    std::unique_lock<std::mutex> sleep(sleep_mutex_);
+    wake_.wait(sleep, [this] { return stopping_ || pending_ > 0; });
+    if (stopping_ && pending_ <= 0) {
+      return;
+    }
+  }
+}
+
+}  // namespace peigen
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace peigen {
+
+// Work-stealing pool for coarse asynchronous operations (factorizations, solves, products).
+// Each worker owns a deque: it pops its own newest task first and steals the oldest task
+// from a sibling when idle. Tasks submitted from a worker (e.g. continuations of a finished
+// factorization) go to that worker's deque, so dependent work stays cache-local. Workers
+// are started lazily on the first submission.
+class TaskPool {
+ public:
+  using Task = std::function<void()>;
+
+  static TaskPool &instance();
+
+  TaskPool() = default;
+  ~TaskPool();
+  TaskPool(const TaskPool &) = delete;
+  TaskPool &operator=(const TaskPool &) = delete;
+
+  // Tasks must not throw; callers capture errors into their own result state.
+  void submit(Task task);
+
+  // n == 0 selects the hardware concurrency. Throws std::runtime_error while tasks are in
+  // flight and std::invalid_argument for negative n.
+  void resize(int n);
+  int size() const;
+  std::size_t in_flight() const;
+
+  // Blocks until every submitted task has finished, then stops the workers. The pool
+  // restarts on the next submission.
+  void shutdown();
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  void start_locked();
+  void stop_locked();
+  void worker_loop(std::size_t index);
+  bool pop_local(std::size_t index, Task &task);
+  bool steal(std::size_t thief, Task &task);
+
+  mutable std::mutex lifecycle_mutex_;
+  int requested_size_ = 0;
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::vector<std::thread> workers_;
+
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  std::condition_variable idle_;
+  long pending_ = 0;  // queued, not yet picked up; guarded by sleep_mutex_
+  bool stopping_ = false;
+
+  std::atomic<std::size_t> in_flight_{0};
+  std::atomic<std::size_t> next_queue_{0};
+};
+
+}  // namespace peigen
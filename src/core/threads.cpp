@@ -0,0 +1,134 @@
+#include "core/threads.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#if !defined(_WIN32)
+#include <dlfcn.h>
+#endif
+
+#include <Eigen/Core>
+
+#if defined(PEIGEN_USE_OPENMP)
+#include <omp.h>
+#endif
+
+#include "core/dispatch.h"
+
+namespace peigen {
+
+struct BlasThreadHooks {
+  std::string api = "none";
+  std::function<void(int)> set;
+  std::function<int()> get;
+};
+
+#if !defined(_WIN32)
+template <typename Fn>
+static Fn lookup_symbol(const char *name) {
+  return reinterpret_cast<Fn>(dlsym(RTLD_DEFAULT, name));
+}
+#endif
+
+static const BlasThreadHooks &blas_thread_hooks() {
+  static const BlasThreadHooks hooks = [] {
+    BlasThreadHooks out;
+#if !defined(_WIN32)
+    if (auto openblas_set = lookup_symbol<void (*)(int)>("openblas_set_num_threads")) {
+      auto get = lookup_symbol<int (*)()>("openblas_get_num_threads");
+      out.api = "openblas";
+      out.set = openblas_set;
+      out.get = [get] { return get != nullptr ? get() : -1; };
+    } else if (auto mkl_set = lookup_symbol<void (*)(int)>("MKL_Set_Num_Threads")) {
+      auto get = lookup_symbol<int (*)()>("MKL_Get_Max_Threads");
+      out.api = "mkl";
+      out.set = mkl_set;
+      out.get = [get] { return get != nullptr ? get() : -1; };
+    } else if (auto blis_set = lookup_symbol<void (*)(std::int64_t)>("bli_thread_set_num_threads")) {
+      auto get = lookup_symbol<std::int64_t (*)()>("bli_thread_get_num_threads");
+      out.api = "blis";
+      out.set = [blis_set](int n) { blis_set(static_cast<std::int64_t>(n)); };
+      out.get = [get] { return get != nullptr ? static_cast<int>(get()) : -1; };
+    } else if (auto flexiblas_set = lookup_symbol<void (*)(int)>("flexiblas_set_num_threads")) {
+      auto get = lookup_symbol<int (*)()>("flexiblas_get_num_threads");
+      out.api = "flexiblas";
+      out.set = flexiblas_set;
+      out.get = [get] { return get != nullptr ? get() : -1; };
+    }
+#endif
+    return out;
+  }();
+  return hooks;
+}
+
+static int default_num_threads() {
+#if defined(PEIGEN_USE_OPENMP)
+  return omp_get_num_procs();
+#else
+  const unsigned hw = std::thread::hardware_concurrency();
+  return hw > 0 ? static_cast<int>(hw) : 1;
+#endif
+}
+
+// 0 until set_num_threads touches the openmp layer: regions then use the ICV default.
+static std::atomic<int> openmp_limit{0};
+
+static int openmp_max_threads() {
+#if defined(PEIGEN_USE_OPENMP)
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
+void set_num_threads(int n, const std::string &layer) {
+  if (n < 0) {
+    throw std::invalid_argument("number of threads must be non-negative (0 restores the default)");
+  }
+  const bool all = layer == "all";
+  if (!all && layer != "eigen" && layer != "openmp" && layer != "blas") {
+    throw std::invalid_argument("layer must be one of: all, eigen, openmp, blas");
+  }
+
+  const int effective = n > 0 ? n : default_num_threads();
+  if (all || layer == "eigen") {
+    Eigen::setNbThreads(effective);
+    kernels().set_num_threads(effective);
+  }
+#if defined(PEIGEN_USE_OPENMP)
+  if (all || layer == "openmp") {
+    openmp_limit.store(n > 0 ? n : 0);
+    omp_set_num_threads(effective);
+  }
+#endif
+  const BlasThreadHooks &blas = blas_thread_hooks();
+  if ((all || layer == "blas") && blas.set) {
+    blas.set(effective);
+  }
+}
+
+int get_num_threads() {
+  return Eigen::nbThreads();
+}
+
+int openmp_num_threads() {
+  const int limit = openmp_limit.load();
+  return limit > 0 ? limit : openmp_max_threads();
+}
+
+ThreadInfo thread_info() {
+  const BlasThreadHooks &blas = blas_thread_hooks();
+  ThreadInfo info;
+  info.eigen = Eigen::nbThreads();
+  info.openmp = openmp_num_threads();
+  info.blas = blas.get ? blas.get() : -1;
+  info.blas_threading_api = blas.api;
+  info.default_threads = default_num_threads();
+  return info;
+}
+
+}  // namespace peigen
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+
+namespace peigen {
+
+struct ThreadInfo {
+  int eigen;
+  int openmp;
+  int blas;
+  std::string blas_threading_api;
+  int default_threads;
+};
+
+// layer is one of: all, eigen, openmp, blas. n == 0 restores the default thread count.
+void set_num_threads(int n, const std::string &layer);
+int get_num_threads();
+// Team size for peigen's own OpenMP regions. omp_set_num_threads only changes the calling
+// thread's ICV, so regions that may run on async pool workers or other Python threads pass
+// this through num_threads(...) instead of relying on the ICV.
+int openmp_num_threads();
+ThreadInfo thread_info();
+
+}  // namespace peigen
@@ -0,0 +1,184 @@
+#include "kernels.h"
+
+#include <Eigen/Core>
+#include <Eigen/IterativeLinearSolvers>
+#include <Eigen/Sparse>
+
+#ifndef PEIGEN_KERNEL_ISA
+#define PEIGEN_KERNEL_ISA "baseline"
+#endif
+
+namespace {
+
+using RowMatrix = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+using Vector = Eigen::Matrix<double, Eigen::Dynamic, 1>;
+using Sparse = Eigen::SparseMatrix<double, Eigen::ColMajor, int>;
+
+Eigen::Map<const Sparse> map_csc(const peigen_csc &a) {
+  return Eigen::Map<const Sparse>(static_cast<Eigen::Index>(a.rows), static_cast<Eigen::Index>(a.cols),
+                                  static_cast<Eigen::Index>(a.nnz), a.outer, a.inner, a.values);
+}
+
+void kernel_set_num_threads(int n) {
+  Eigen::setNbThreads(n);
+}
+
+void kernel_gemm(const double *a, const double *b, double *out, int64_t m, int64_t k, int64_t n) {
+  const Eigen::Map<const RowMatrix> lhs(a, m, k);
+  const Eigen::Map<const RowMatrix> rhs(b, k, n);
+  Eigen::Map<RowMatrix> dst(out, m, n);
+  dst.noalias() = lhs * rhs;
+}
+
+void kernel_spmm(const peigen_csc *a, const double *b, int64_t b_cols, double *out) {
+  const Eigen::Map<const Sparse> mat = map_csc(*a);
+  const Eigen::Map<const RowMatrix> rhs(b, mat.cols(), b_cols);
+  Eigen::Map<RowMatrix> dst(out, mat.rows(), b_cols);
+  dst.noalias() = mat * rhs;
+}
+
+void kernel_spmm_axpby(const peigen_csc *a, int transpose, double alpha, const double *b, int64_t b_cols,
+                       double beta, double *out) {
+  const Eigen::Map<const Sparse> mat = map_csc(*a);
+  const Eigen::Index in_rows = transpose ? mat.rows() : mat.cols();
+  const Eigen::Index out_rows = transpose ? mat.cols() : mat.rows();
+  const Eigen::Map<const RowMatrix> rhs(b, in_rows, b_cols);
+  Eigen::Map<RowMatrix> dst(out, out_rows, b_cols);
+
+  if (beta == 0.0) {
+    dst.setZero();
+  } else if (beta != 1.0) {
+    dst *= beta;
+  }
+  if (alpha == 0.0) {
+    return;
+  }
+  if (transpose) {
+    // CSC read as CSR of a^T: each output row gathers one column of a, so threads never
+    // write to the same row.
+    dst.noalias() += alpha * (mat.transpose() * rhs);
+  } else {
+    dst.noalias() += alpha * (mat * rhs);
+  }
+}
+
+void kernel_normal_spmm(const peigen_csc *a, const double *b, int64_t b_cols, double *out) {
+  const Eigen::Map<const Sparse> mat = map_csc(*a);
+  const Eigen::Map<const RowMatrix> rhs(b, mat.cols(), b_cols);
+  Eigen::Map<RowMatrix> dst(out, mat.cols(), b_cols);
+  // The intermediate a * b stays inside the kernel; the gather pass reads the same CSC
+  // arrays as a^T, so neither a^T nor a^T a is ever formed.
+  RowMatrix work(mat.rows(), b_cols);
+  work.noalias() = mat * rhs;
+  dst.noalias() = mat.transpose() * work;
+}
+
+void kernel_sddmm(const peigen_csc *a, const double *x, const double *y, int64_t k, double *out_values) {
+  const Eigen::Map<const Sparse> mat = map_csc(*a);
+  const int *outer = mat.outerIndexPtr();
+  const int *inner = mat.innerIndexPtr();
+  const double *values = mat.valuePtr();
+  const Eigen::Index cols = mat.cols();
+  const Eigen::Index dim = static_cast<Eigen::Index>(k);
+
+#if defined(PEIGEN_USE_OPENMP)
+// Eigen::nbThreads() is the process-wide count from set_num_threads, unlike the ICV read by
+// a bare parallel region on an async pool worker.
+#pragma omp parallel for schedule(dynamic, 64) if (mat.nonZeros() * dim >= (1 << 16)) \
+    num_threads(Eigen::nbThreads())
+#endif
+  for (Eigen::Index j = 0; j < cols; ++j) {
+    const Eigen::Map<const Vector> yj(y + j * dim, dim);
+    for (int p = outer[j]; p < outer[j + 1]; ++p) {
+      const Eigen::Map<const Vector> xi(x + static_cast<Eigen::Index>(inner[p]) * dim, dim);
+      out_values[p] = values[p] * xi.dot(yj);
+    }
+  }
+}
+
+double kernel_norm(const double *data, int64_t size) {
+  return Eigen::Map<const Vector>(data, size).norm();
+}
+
+template <typename Solver>
+int solve_columns(Solver &solver, const Eigen::Map<const Sparse> &mat, const double *rhs, int64_t rhs_cols,
+                  double *out, const peigen_iterative_params &params, peigen_iterative_result *result) {
+  solver.setTolerance(params.tol);
+  solver.setMaxIterations(params.maxiter);
+  solver.compute(mat);
+  if (solver.info() != Eigen::Success) {
+    return PEIGEN_KERNEL_SETUP_FAILED;
+  }
+
+  const Eigen::Map<const RowMatrix> b(rhs, mat.rows(), rhs_cols);
+  Eigen::Map<RowMatrix> x(out, mat.rows(), rhs_cols);
+  for (int64_t col = 0; col < rhs_cols; ++col) {
+    x.col(col) = solver.solve(b.col(col));
+    result->iterations = static_cast<int>(solver.iterations());
+    result->error = solver.error();
+    result->column = col;
+    if (solver.info() != Eigen::Success) {
+      return PEIGEN_KERNEL_NOT_CONVERGED;
+    }
+  }
+  return PEIGEN_KERNEL_OK;
+}
+
+template <typename Preconditioner>
+int conjugate_gradient(const Eigen::Map<const Sparse> &mat, const double *rhs, int64_t rhs_cols, double *out,
+                       const peigen_iterative_params &params, peigen_iterative_result *result) {
+  Eigen::ConjugateGradient<Sparse, Eigen::Lower | Eigen::Upper, Preconditioner> cg;
+  return solve_columns(cg, mat, rhs, rhs_cols, out, params, result);
+}
+
+int kernel_iterative_solve(const peigen_csc *a, const double *rhs, int64_t rhs_cols, double *out,
+                           const peigen_iterative_params *params, peigen_iterative_result *result) {
+  const Eigen::Map<const Sparse> mat = map_csc(*a);
+  result->iterations = 0;
+  result->error = 0.0;
+  result->column = 0;
+
+  switch (params->method) {
+    case PEIGEN_CG_IDENTITY:
+      return conjugate_gradient<Eigen::IdentityPreconditioner>(mat, rhs, rhs_cols, out, *params, result);
+    case PEIGEN_CG_JACOBI:
+      return conjugate_gradient<Eigen::DiagonalPreconditioner<double> >(mat, rhs, rhs_cols, out, *params, result);
+    case PEIGEN_CG_ILU: {
+      Eigen::ConjugateGradient<Sparse, Eigen::Lower | Eigen::Upper, Eigen::IncompleteLUT<double> > cg;
+      cg.preconditioner().setFillfactor(params->ilu_fill_factor);
+      cg.preconditioner().setDroptol(params->ilu_drop_tol);
+      return solve_columns(cg, mat, rhs, rhs_cols, out, *params, result);
+    }
+    case PEIGEN_BICGSTAB: {
+      Eigen::BiCGSTAB<Sparse> solver;
+      return solve_columns(solver, mat, rhs, rhs_cols, out, *params, result);
+    }
+    default:
+      return PEIGEN_KERNEL_INVALID_ARGUMENT;
+  }
+}
+
+const peigen_kernel_table kKernelTable = {
+    PEIGEN_KERNEL_ABI_VERSION,
+    PEIGEN_KERNEL_ISA,
+    &kernel_set_num_threads,
+    &kernel_gemm,
+    &kernel_spmm,
+    &kernel_spmm_axpby,
+    &kernel_normal_spmm,
+    &kernel_sddmm,
+    &kernel_norm,
+    &kernel_iterative_solve,
+};
+
+}  // namespace
+
+#if defined(PEIGEN_KERNELS_BUILTIN)
+extern "C" const peigen_kernel_table *peigen_builtin_kernel_table(void) {
+  return &kKernelTable;
+}
+#else
+extern "C" PEIGEN_KERNEL_EXPORT const peigen_kernel_table *peigen_get_kernel_table(void) {
+  return &kKernelTable;
+}
+#endif
@@ -0,0 +1,105 @@
+#pragma once
+
+// C ABI for the ISA-specific kernel variants.
+//
+// src/kernels/kernels.cpp is compiled once into _core with baseline flags and once per
+// extra instruction set (AVX2+FMA, AVX-512) into standalone shared objects. Each variant
+// keeps its own Eigen instantiations behind hidden visibility; only the table below
+// crosses the boundary, so it must stay plain C (no exceptions, no STL types).
+
+#include <stdint.h>
+
+#define PEIGEN_KERNEL_ABI_VERSION 2
+
+#if defined(_WIN32)
+#define PEIGEN_KERNEL_EXPORT __declspec(dllexport)
+#else
+#define PEIGEN_KERNEL_EXPORT __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum peigen_kernel_status {
+  PEIGEN_KERNEL_OK = 0,
+  PEIGEN_KERNEL_SETUP_FAILED = 1,
+  PEIGEN_KERNEL_NOT_CONVERGED = 2,
+  PEIGEN_KERNEL_INVALID_ARGUMENT = 3,
+};
+
+enum peigen_iterative_method {
+  PEIGEN_CG_IDENTITY = 0,
+  PEIGEN_CG_JACOBI = 1,
+  PEIGEN_CG_ILU = 2,
+  PEIGEN_BICGSTAB = 3,
+};
+
+// Compressed sparse column view; arrays are borrowed for the duration of the call.
+struct peigen_csc {
+  int64_t rows;
+  int64_t cols;
+  int64_t nnz;
+  const int *outer;
+  const int *inner;
+  const double *values;
+};
+
+struct peigen_iterative_params {
+  int method;
+  double tol;
+  int maxiter;
+  int ilu_fill_factor;
+  double ilu_drop_tol;
+};
+
+struct peigen_iterative_result {
+  int iterations;
+  double error;
+  int64_t column;
+};
+
+struct peigen_kernel_table {
+  int abi_version;
+  const char *isa;
+
+  void (*set_num_threads)(int n);
+
+  // out (m x n) = a (m x k) * b (k x n); all row-major.
+  void (*gemm)(const double *a, const double *b, double *out, int64_t m, int64_t k, int64_t n);
+
+  // out (rows x b_cols) = a * b; b and out row-major.
+  void (*spmm)(const struct peigen_csc *a, const double *b, int64_t b_cols, double *out);
+
+  // out = alpha * op(a) * b + beta * out, with op(a) = a^T when transpose != 0 (the
+  // transpose is never formed). b and out row-major; beta == 0 ignores the contents of out.
+  void (*spmm_axpby)(const struct peigen_csc *a, int transpose, double alpha, const double *b, int64_t b_cols,
+                     double beta, double *out);
+
+  // out (cols x b_cols) = a^T * (a * b); b and out row-major.
+  void (*normal_spmm)(const struct peigen_csc *a, const double *b, int64_t b_cols, double *out);
+
+  // SDDMM: out_values[p] = a.values[p] * dot(x[i, :], y[j, :]) for each stored entry p = (i, j).
+  // x is rows x k and y is cols x k, both row-major; out_values follows a's storage order.
+  void (*sddmm)(const struct peigen_csc *a, const double *x, const double *y, int64_t k, double *out_values);
+
+  // Euclidean norm of a contiguous buffer.
+  double (*norm)(const double *data, int64_t size);
+
+  // Solves a * out = rhs column by column (rhs/out row-major, a square). On failure the
+  // result records the failing column and the solver's iteration count and error.
+  int (*iterative_solve)(const struct peigen_csc *a, const double *rhs, int64_t rhs_cols, double *out,
+                         const struct peigen_iterative_params *params, struct peigen_iterative_result *result);
+};
+
+typedef const struct peigen_kernel_table *(*peigen_kernel_table_fn)(void);
+
+// Entry point exported by each ISA shared object.
+#define PEIGEN_KERNEL_TABLE_SYMBOL "peigen_get_kernel_table"
+
+// Variant compiled into _core itself with baseline flags.
+const struct peigen_kernel_table *peigen_builtin_kernel_table(void);
+
+#ifdef __cplusplus
+}
+#endif
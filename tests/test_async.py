@@ -0,0 +1,221 @@
+import asyncio
+import concurrent.futures
+
+import numpy as np
+import numpy.testing as npt
+import pytest
+
+import peigen
+from peigen import linalg, sparse
+
+
+
+def _spd(n, seed):
+    rng = np.random.default_rng(seed)
+    m = rng.standard_normal((n, n))
+    return m @ m.T + n * np.eye(n)
+
+
+def _laplacian(n):
+    sp = pytest.importorskip("scipy.sparse")
+    return sp.diags([-1.0, 2.0, -1.0], [-1, 0, 1], shape=(n, n), format="csc")
+
+
+def test_submit_matches_sync_results():
+    rng = np.random.default_rng(300)
+    a = rng.standard_normal((40, 30))
+    b = rng.standard_normal((30, 20))
+    h = _spd(32, 301)
+    rhs = rng.standard_normal(32)
+
+    matmul = peigen.submit(linalg.matmul, a, b)
+    solve = peigen.submit("linalg.solve", h, rhs)
+    eigh = peigen.submit(linalg.eigh, h)
+    svd = peigen.submit(linalg.svd, a)
+
+    npt.assert_allclose(matmul.result(), a @ b, rtol=1e-12, atol=1e-12)
+    x = solve.result()
+    assert x.shape == (32,)
+    npt.assert_allclose(x, np.linalg.solve(h, rhs), rtol=1e-10, atol=1e-10)
+    w, v = eigh.result()
+    npt.assert_allclose(w, np.linalg.eigvalsh(h), rtol=1e-10, atol=1e-10)
+    npt.assert_allclose(h @ v, v * w, rtol=1e-8, atol=1e-8)
+    _, s, _ = svd.result()
+    npt.assert_allclose(s, np.linalg.svd(a, compute_uv=False), rtol=1e-10, atol=1e-10)
+
+
+@pytest.mark.sparse
+def test_sparse_ops_and_factorization_chain():
+    a = _laplacian(200)
+    rng = np.random.default_rng(302)
+    dense_rhs = rng.standard_normal((200, 4))
+
+    fac = peigen.submit(sparse.factorize, a)
+    solves = [peigen.submit("sparse.factorized_solve", fac, dense_rhs[:, k]) for k in range(4)]
+    y = peigen.submit(sparse.spmm, a, dense_rhs)
+    x_lu = peigen.submit(sparse.solve, a, dense_rhs)
+
+    for k, fut in enumerate(solves):
+        npt.assert_allclose(a @ fut.result(), dense_rhs[:, k], rtol=1e-9, atol=1e-9)
+    npt.assert_allclose(y.result(), a @ dense_rhs, rtol=1e-12, atol=1e-12)
+    npt.assert_allclose(a @ x_lu.result(), dense_rhs, rtol=1e-9, atol=1e-9)
+    x_sync = fac.result().solve(dense_rhs)
+    npt.assert_allclose(x_sync, x_lu.result(), rtol=1e-10, atol=1e-10)
+
+
+@pytest.mark.sparse
+def test_async_spmm_keywords():
+    sp = pytest.importorskip("scipy.sparse")
+    a = sp.random(30, 20, density=0.2, format="csc", random_state=306)
+    rng = np.random.default_rng(306)
+    x = rng.standard_normal(30)
+    b = rng.standard_normal((20, 3))
+
+    y = peigen.submit(sparse.spmm, a, x, transpose=True, alpha=2.0)
+    npt.assert_allclose(y.result(), 2.0 * (a.T @ x), rtol=1e-12, atol=1e-12)
+    npt.assert_allclose(peigen.submit(sparse.spmm, a, b, alpha=-1.0).result(), -(a @ b), rtol=1e-12, atol=1e-12)
+    with pytest.raises(ValueError, match="out and beta"):
+        peigen.submit(sparse.spmm, a, b, beta=1.0, out=np.zeros((30, 3)))
+
+
+
+@pytest.mark.sparse
+def test_async_permuted_matches_sync():
+    sp = pytest.importorskip("scipy.sparse")
+    a = sp.random(40, 40, density=0.1, format="csc", random_state=307) + 4.0 * sp.eye(40, format="csc")
+    a = (a + a.T).tocsc()
+    b = np.random.default_rng(307).standard_normal(40)
+    r = sparse.reorder(a, method="rcm")
+
+    x = peigen.submit(sparse.solve, a, b, permuted=r).result()
+    npt.assert_allclose(x, sparse.solve(a, b), rtol=1e-10, atol=1e-10)
+    fac = peigen.submit(sparse.factorize, a, permuted="amd")
+    npt.assert_allclose(peigen.submit("sparse.factorized_solve", fac, b).result(), x, rtol=1e-10, atol=1e-10)
+    y = peigen.submit(sparse.solve, a, b, method="cg", tol=1e-12, permuted=r).result()
+    npt.assert_allclose(y, x, rtol=1e-8, atol=1e-8)
+    npt.assert_allclose(peigen.submit(sparse.spmm, a, b, permuted=r).result(), a @ b, rtol=1e-12, atol=1e-12)
+    with pytest.raises(ValueError, match="pending future"):
+        peigen.submit(sparse.spmm, a, peigen.submit(sparse.spmm, a, b), permuted=r)
+
+
+@pytest.mark.sparse
+def test_async_mixed_precision():
+    rng = np.random.default_rng(308)
+    a = rng.standard_normal((30, 30)) + 30.0 * np.eye(30)
+    b = rng.standard_normal(30)
+    x = peigen.submit(linalg.solve, a, b, precision="mixed").result()
+    npt.assert_allclose(a @ x, b, rtol=1e-12, atol=1e-12)
+
+    s = _laplacian(100)
+    rhs = rng.standard_normal(100)
+    y = peigen.submit(sparse.solve, s, rhs, precision="mixed").result()
+    npt.assert_allclose(s @ y, rhs, rtol=1e-10, atol=1e-10)
+    fac = peigen.submit(sparse.factorize, s, precision="mixed")
+    npt.assert_allclose(peigen.submit("sparse.factorized_solve", fac, rhs).result(), y, rtol=1e-10, atol=1e-10)
+    assert fac.result().stats["solves"] == 1
+    with pytest.raises(ValueError, match="direct method"):
+        peigen.submit(sparse.solve, s, rhs, method="cg", precision="mixed")
+    with pytest.raises(ValueError, match="precision must be"):
+        peigen.submit(linalg.solve, a, b, precision="half")
+
+
+@pytest.mark.sparse
+def test_async_least_squares():
+    sp = pytest.importorskip("scipy.sparse")
+    a = sp.random(60, 20, density=0.2, format="csc", random_state=309) + sp.eye(60, 20, format="csc")
+    b = np.random.default_rng(309).standard_normal((60, 2))
+    expected = np.linalg.lstsq(a.toarray(), b, rcond=None)[0]
+
+    npt.assert_allclose(peigen.submit(sparse.lstsq, a, b).result(), expected, rtol=1e-9, atol=1e-9)
+    x = peigen.submit(sparse.lstsq, a, b[:, 0], method="lscg", tol=1e-12).result()
+    npt.assert_allclose(x, expected[:, 0], rtol=1e-6, atol=1e-6)
+    fac = peigen.submit(sparse.factorize, a, method="qr")
+    npt.assert_allclose(peigen.submit("sparse.factorized_solve", fac, b).result(), expected, rtol=1e-9, atol=1e-9)
+    assert fac.result().rank == 20
+    with pytest.raises(ValueError, match="method must be one of"):
+        peigen.submit(sparse.lstsq, a, b, method="svd")
+
+
+def test_async_generalized_eigh():
+    a = _spd(20, 310)
+    b = _spd(20, 311)
+    w, v = linalg.eigh(a, b)
+
+    wf, vf = peigen.submit(linalg.eigh, a, b).result()
+    npt.assert_allclose(wf, w, rtol=1e-10, atol=1e-10)
+    npt.assert_allclose(np.abs(vf), np.abs(v), rtol=1e-8, atol=1e-8)
+    factor = linalg.cholesky_factor(b)
+    fut = peigen.submit(linalg.eighvals, a, factor, type=2)
+    npt.assert_allclose(fut.result(), linalg.eighvals(a, b, type=2), rtol=1e-10, atol=1e-10)
+    bb = peigen.submit(linalg.matmul, b, np.eye(20))
+    sub = peigen.submit(linalg.eigh, a, bb, eigenvectors=False, subset_by_index=(2, 5)).result()
+    npt.assert_allclose(sub, w[2:6], rtol=1e-10, atol=1e-10)
+    with pytest.raises(ValueError, match="type must be"):
+        peigen.submit(linalg.eigh, a, b, type=4)
+    with pytest.raises(ValueError, match="requires b"):
+        peigen.submit(linalg.eigh, a, subset_by_index=(0, 1))
+
+def test_dense_futures_chain_natively():
+    rng = np.random.default_rng(303)
+    a = rng.standard_normal((24, 24))
+    b = rng.standard_normal((24, 24))
+    ab = peigen.submit(linalg.matmul, a, b)
+    abb = peigen.submit(linalg.matmul, ab, b)
+    npt.assert_allclose(abb.result(), a @ b @ b, rtol=1e-10, atol=1e-10)
+
+
+def test_futures_are_awaitable():
+    h = _spd(16, 304)
+
+    async def main():
+        return await asyncio.gather(peigen.submit(linalg.eighvals, h), peigen.submit(linalg.matmul, h, h))
+
+    w, hh = asyncio.run(main())
+    npt.assert_allclose(w, np.linalg.eigvalsh(h), rtol=1e-10, atol=1e-10)
+    npt.assert_allclose(hh, h @ h, rtol=1e-12, atol=1e-12)
+
+
+def test_futures_work_with_concurrent_wait():
+    h = _spd(20, 305)
+    futs = [peigen.submit(linalg.eigh, h, eigenvectors=False) for _ in range(8)]
+    done, not_done = concurrent.futures.wait(futs, timeout=60)
+    assert not not_done
+    for fut in done:
+        assert isinstance(fut, concurrent.futures.Future)
+        npt.assert_allclose(fut.result(), np.linalg.eigvalsh(h), rtol=1e-10, atol=1e-10)
+
+
+def test_submit_validates_eagerly():
+    with pytest.raises(ValueError):
+        peigen.submit(linalg.matmul, np.ones((2, 3)), np.ones((2, 3)))
+    with pytest.raises(ValueError):
+        peigen.submit(linalg.eigh, np.ones((2, 2)), method="nope")
+    with pytest.raises(ValueError):
+        peigen.submit(linalg.qr, np.ones((2, 2)))
+
+
+def test_errors_propagate_through_dependencies():
+    ab = peigen.submit(linalg.matmul, np.ones((3, 4)), np.ones((4, 5)))
+    bad = peigen.submit(linalg.matmul, ab, np.ones((3, 3)))
+    with pytest.raises(ValueError):
+        bad.result()
+    singular = peigen.submit(linalg.solve, np.zeros((3, 3)), np.ones(3), method="eigen")
+    downstream = peigen.submit(linalg.matmul, singular, np.ones((1, 1)))
+    assert isinstance(downstream.exception(timeout=60), ValueError)
+
+
+def test_async_worker_controls():
+    original = peigen.get_async_workers()
+    try:
+        peigen.futures.shutdown()
+        peigen.set_async_workers(2)
+        assert peigen.get_async_workers() == 2
+        assert peigen.build_config()["async_workers"] == 2
+        fut = peigen.submit(linalg.matmul, np.eye(3), np.eye(3))
+        npt.assert_allclose(fut.result(), np.eye(3))
+        with pytest.raises(ValueError):
+            peigen.set_async_workers(-1)
+    finally:
+        peigen.futures.shutdown()
+        peigen.set_async_workers(0)
+    assert peigen.get_async_workers() == original
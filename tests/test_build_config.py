@@ -1,3 +1,7 @@
+import os
+import subprocess
+import sys
+
 import peigen
 
 
@@ -13,11 +17,20 @@ def test_build_config_has_expected_keys():
         "openmp_enabled",
         "vectorization_enabled",
         "eigen_mpl2_only",
+        "num_threads",
+        "openmp_max_threads",
+        "blas_num_threads",
+        "blas_threading_api",
+        "kernel_isa",
+        "kernel_isa_variants",
+        "cpu_isa_supported",
+        "kernel_isa_forced",
     }
     assert expected.issubset(cfg.keys())
     assert isinstance(cfg["version"], str)
     assert isinstance(cfg["blas_enabled"], bool)
     assert cfg["eigen_mpl2_only"] is True
+    assert cfg["num_threads"] >= 1
 
 
 def test_show_build_config_prints(capsys):
@@ -25,3 +38,49 @@ def test_show_build_config_prints(capsys):
     captured = capsys.readouterr().out
     assert "pEigen build configuration" in captured
     assert "lapack_backend:" in captured
+
+
+def test_kernel_isa_is_shipped_and_supported():
+    cfg = peigen.build_config()
+    assert cfg["kernel_isa"] in cfg["kernel_isa_variants"]
+    assert cfg["kernel_isa"] in cfg["cpu_isa_supported"]
+    assert set(cfg["cpu_isa_supported"]).issubset(cfg["kernel_isa_variants"])
+
+
+def _run_with_isa(isa: str, code: str) -> str:
+    env = dict(os.environ, PEIGEN_ISA=isa)
+    proc = subprocess.run(
+        [sys.executable, "-c", code], env=env, capture_output=True, text=True, check=True
+    )
+    return proc.stdout.strip()
+
+
+def test_forced_isa_variants_agree():
+    code = (
+        "import numpy as np, peigen\n"
+        "from peigen import linalg\n"
+        "rng = np.random.default_rng(0)\n"
+        "a = rng.standard_normal((40, 40))\n"
+        "print(peigen.build_config()['kernel_isa'], repr(float(linalg.norm(a))))\n"
+    )
+    results = {}
+    for isa in peigen.build_config()["cpu_isa_supported"]:
+        selected, value = _run_with_isa(isa, code).split()
+        assert selected == isa
+        results[isa] = float(value)
+    reference = next(iter(results.values()))
+    for value in results.values():
+        assert abs(value - reference) <= 1e-12 * abs(reference)
+
+
+def test_forcing_unknown_isa_falls_back_with_note():
+    baseline = peigen.build_config()["kernel_isa_variants"][0]
+    out = _run_with_isa(
+        "not-an-isa",
+        "import warnings\n"
+        "warnings.simplefilter('ignore')\n"
+        "import peigen\n"
+        "cfg = peigen.build_config()\n"
+        "print(cfg['kernel_isa'], cfg['kernel_isa_forced'], bool(cfg['kernel_isa_note']))\n",
+    )
+    assert out.split() == [baseline, "True", "True"]
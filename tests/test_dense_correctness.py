@@ -1,5 +1,6 @@
 import numpy as np
 import numpy.testing as npt
+import pytest
 
 from peigen import linalg
 
@@ -153,3 +154,79 @@ def test_norm_matches_numpy_non_contiguous():
     a = base[::2, ::2]
     assert not a.flags.c_contiguous
     assert np.isclose(linalg.norm(a), np.linalg.norm(a), rtol=1e-12, atol=1e-12)
+
+
+def test_gram_matches_numpy():
+    rng = np.random.default_rng(21)
+    a = rng.standard_normal((40, 12))
+    npt.assert_allclose(linalg.gram(a), a.T @ a, rtol=1e-11, atol=1e-12)
+    npt.assert_allclose(linalg.gram(a, trans=False), a @ a.T, rtol=1e-11, atol=1e-12)
+    npt.assert_allclose(linalg.gram(a, mirror=False), np.tril(a.T @ a), rtol=1e-11, atol=1e-12)
+    npt.assert_allclose(linalg.gram(a, lower=False, mirror=False), np.triu(a.T @ a), rtol=1e-11, atol=1e-12)
+
+
+def test_trmm_and_symm_use_one_triangle():
+    rng = np.random.default_rng(22)
+    a = rng.standard_normal((9, 9))
+    b = rng.standard_normal((9, 4))
+    c = rng.standard_normal((4, 9))
+    unit_lower = np.tril(a, -1) + np.eye(9)
+    sym_upper = np.triu(a) + np.triu(a, 1).T
+
+    npt.assert_allclose(linalg.trmm(a, b), np.tril(a) @ b, rtol=1e-11, atol=1e-12)
+    npt.assert_allclose(linalg.trmm(a, b, unit_diagonal=True), unit_lower @ b, rtol=1e-11, atol=1e-12)
+    npt.assert_allclose(linalg.trmm(a, c, lower=False, side="right"), c @ np.triu(a), rtol=1e-11, atol=1e-12)
+    npt.assert_allclose(linalg.symm(a, b, lower=False), sym_upper @ b, rtol=1e-11, atol=1e-12)
+    npt.assert_allclose(linalg.symm(a, c, side="right"), c @ (np.tril(a) + np.tril(a, -1).T), rtol=1e-11, atol=1e-12)
+
+
+def test_structured_products_reject_bad_shapes():
+    with pytest.raises(ValueError):
+        linalg.trmm(np.ones((3, 4)), np.ones((3, 2)))
+    with pytest.raises(ValueError):
+        linalg.symm(np.eye(3), np.ones((4, 2)))
+    with pytest.raises(ValueError):
+        linalg.trmm(np.eye(3), np.ones((3, 2)), side="middle")
+
+
+@pytest.mark.parametrize("n", [2, 3, 4, 6, 9])
+@pytest.mark.parametrize("method", ["auto", "iterative"])
+def test_eigh_batched_matches_numpy(n, method):
+    rng = np.random.default_rng(30 + n)
+    m = rng.standard_normal((50, n, n))
+    sym = (m + m.transpose(0, 2, 1)) / 2.0
+    # Garbage above the diagonal must be ignored with lower=True.
+    a = np.tril(sym) + np.triu(rng.standard_normal((50, n, n)), 1)
+
+    w, v = linalg.eigh_batched(a, method=method)
+    npt.assert_allclose(w, np.linalg.eigvalsh(sym), rtol=1e-10, atol=1e-10)
+    npt.assert_allclose(sym @ v, v * w[:, None, :], rtol=1e-9, atol=1e-9)
+    npt.assert_allclose(linalg.eigh_batched(a.transpose(0, 2, 1), lower=False, eigenvectors=False), w,
+                        rtol=1e-10, atol=1e-10)
+
+
+@pytest.mark.parametrize("n", [2, 3, 5, 8])
+def test_solve_batched_matches_numpy(n):
+    rng = np.random.default_rng(40 + n)
+    m = rng.standard_normal((64, n, n))
+    spd = m @ m.transpose(0, 2, 1) + n * np.eye(n)
+    b = rng.standard_normal((64, n))
+    bk = rng.standard_normal((64, n, 3))
+
+    npt.assert_allclose(linalg.solve_batched(m + n * np.eye(n), b),
+                        np.linalg.solve(m + n * np.eye(n), b[..., None])[..., 0], rtol=1e-9, atol=1e-10)
+    npt.assert_allclose(linalg.solve_batched(spd, bk, assume_a="pos"), np.linalg.solve(spd, bk),
+                        rtol=1e-9, atol=1e-10)
+
+
+def test_batched_routines_reject_bad_input():
+    a = np.tile(np.eye(3), (4, 1, 1))
+    a[2] = 0.0
+    with pytest.raises(ValueError, match="matrix 2"):
+        linalg.solve_batched(a, np.ones((4, 3)))
+    with pytest.raises(ValueError):
+        linalg.solve_batched(a, np.ones((4, 2)))
+    with pytest.raises(ValueError):
+        linalg.eigh_batched(np.ones((4, 3, 2)))
+    with pytest.raises(ValueError):
+        linalg.eigh_batched(np.ones((2, 4, 4)), method="direct")
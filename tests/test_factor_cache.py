@@ -0,0 +1,102 @@
+import numpy as np
+import numpy.testing as npt
+import pytest
+
+import peigen
+from peigen import linalg
+
+
+@pytest.fixture
+def cache():
+    peigen.clear_factor_cache()
+    with peigen.factor_cache(32 * 2**20):
+        yield
+    peigen.clear_factor_cache()
+
+
+def test_factor_cache_is_disabled_by_default():
+    peigen.clear_factor_cache()
+    a = np.eye(4) * 2.0
+    linalg.solve(a, np.ones(4))
+    info = peigen.factor_cache_info()
+    assert not info["enabled"]
+    assert info["hits"] == info["misses"] == info["entries"] == 0
+
+
+def test_dense_solve_reuses_cached_factors(cache):
+    rng = np.random.default_rng(0)
+    a = rng.standard_normal((40, 40)) + 40 * np.eye(40)
+    for _ in range(3):
+        b = rng.standard_normal(40)
+        npt.assert_allclose(linalg.solve(a, b), np.linalg.solve(a, b), rtol=1e-10, atol=1e-11)
+
+    info = peigen.factor_cache_info()
+    assert info["misses"] == 1
+    assert info["hits"] == 2
+    assert info["entries"] == 1
+    assert 0 < info["bytes"] <= info["max_bytes"]
+
+    # Any value change produces a new fingerprint.
+    a[3, 5] += 1.0
+    b = rng.standard_normal(40)
+    npt.assert_allclose(linalg.solve(a, b), np.linalg.solve(a, b), rtol=1e-10, atol=1e-11)
+    assert peigen.factor_cache_info()["misses"] == 2
+
+
+def test_factor_cache_evicts_least_recently_used(cache):
+    rng = np.random.default_rng(1)
+    mats = [rng.standard_normal((64, 64)) + 64 * np.eye(64) for _ in range(3)]
+    # Room for two entries, each an LU factor plus the stored copy of its matrix.
+    peigen.set_factor_cache(2 * 2 * 64 * 64 * 8 + 2048)
+    for a in mats:
+        linalg.solve(a, np.ones(64))
+
+    info = peigen.factor_cache_info()
+    assert info["entries"] == 2
+    assert info["evictions"] == 1
+
+    linalg.solve(mats[0], np.ones(64))
+    assert peigen.factor_cache_info()["hits"] == 0
+
+
+def test_factor_cache_entries_keep_a_copy_of_the_matrix(cache):
+    rng = np.random.default_rng(3)
+    a = rng.standard_normal((32, 32)) + 32 * np.eye(32)
+    b = rng.standard_normal(32)
+    linalg.solve(a, b)
+    # The copy of A is accounted next to its LU factor.
+    assert peigen.factor_cache_info()["bytes"] >= 2 * a.nbytes
+
+    # A hit compares the stored copy, so an equal matrix in fresh memory still hits.
+    npt.assert_allclose(linalg.solve(a.copy(order="F"), b), np.linalg.solve(a, b), rtol=1e-10, atol=1e-11)
+    assert peigen.factor_cache_info()["hits"] == 1
+
+
+def test_singular_matrices_are_not_cached(cache):
+    with pytest.raises(ValueError):
+        linalg.solve(np.zeros((3, 3)), np.ones(3), method="eigen")
+    assert peigen.factor_cache_info()["entries"] == 0
+
+
+def test_set_factor_cache_rejects_negative():
+    with pytest.raises(ValueError):
+        peigen.set_factor_cache(-1)
+
+
+@pytest.mark.sparse
+def test_sparse_lu_solve_reuses_cached_factors(cache):
+    sp = pytest.importorskip("scipy.sparse")
+    from peigen import sparse
+
+    lap = sp.diags([-1.0, 4.0, -1.0], [-1, 0, 1], shape=(30, 30))
+    a = (sp.kron(sp.identity(30), lap) + sp.kron(lap, sp.identity(30))).tocsc()
+    b = np.random.default_rng(2).standard_normal(a.shape[0])
+    expected = np.linalg.solve(a.toarray(), b)
+
+    npt.assert_allclose(sparse.solve(a, b, method="lu"), expected, rtol=1e-10, atol=1e-11)
+    npt.assert_allclose(sparse.solve(a.copy(), b, method="lu"), expected, rtol=1e-10, atol=1e-11)
+    npt.assert_allclose(sparse.solve(sparse.Matrix(a), b), expected, rtol=1e-10, atol=1e-11)
+
+    info = peigen.factor_cache_info()
+    assert info["misses"] == 1
+    assert info["hits"] == 2
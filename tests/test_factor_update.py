@@ -0,0 +1,92 @@
+import numpy as np
+import numpy.testing as npt
+import pytest
+
+from peigen import linalg
+
+
+def _spd(n, seed):
+    rng = np.random.default_rng(seed)
+    m = rng.standard_normal((n, n))
+    return m @ m.T + n * np.eye(n), rng
+
+
+@pytest.mark.parametrize("make", [linalg.cholesky_factor, linalg.ldlt_factor])
+@pytest.mark.parametrize("k", [1, 4])
+def test_update_then_downdate_matches_refactorization(make, k):
+    a, rng = _spd(40, k)
+    u = rng.standard_normal((40, k)) if k > 1 else rng.standard_normal(40)
+    uu = np.outer(u, u) if k == 1 else u @ u.T
+    b = rng.standard_normal((40, 3))
+    factor = make(a)
+
+    factor.update(u)
+    npt.assert_allclose(factor.solve(b), np.linalg.solve(a + uu, b), rtol=1e-10, atol=1e-12)
+    factor.update(u, sign=-1)
+    npt.assert_allclose(factor.solve(b), np.linalg.solve(a, b), rtol=1e-10, atol=1e-12)
+    npt.assert_allclose(factor.solve(b[:, 0]), np.linalg.solve(a, b[:, 0]), rtol=1e-10, atol=1e-12)
+
+
+def test_cholesky_update_keeps_factor_triangular():
+    a, rng = _spd(24, 3)
+    u = rng.standard_normal((24, 5))
+    factor = linalg.cholesky_factor(a)
+    factor.update(u)
+    npt.assert_allclose(factor.L @ factor.L.T, a + u @ u.T, rtol=1e-11, atol=1e-11)
+    assert np.allclose(factor.L, np.tril(factor.L))
+    assert np.all(np.diag(factor.L) > 0)
+
+
+@pytest.mark.parametrize("make", [linalg.cholesky_factor, linalg.ldlt_factor])
+def test_downdate_losing_definiteness_raises_and_keeps_factor(make):
+    a, rng = _spd(20, 7)
+    b = rng.standard_normal(20)
+    factor = make(a)
+    # Removing 2 * v v^T for an eigenvector v of a makes that eigenvalue negative.
+    w, v = np.linalg.eigh(a)
+    with pytest.raises(ValueError, match="not positive definite"):
+        factor.update(np.sqrt(2.0 * w[0]) * v[:, 0], sign=-1)
+    npt.assert_allclose(factor.solve(b), np.linalg.solve(a, b), rtol=1e-10, atol=1e-12)
+
+
+def test_ldlt_factor_handles_indefinite_matrices():
+    rng = np.random.default_rng(11)
+    m = rng.standard_normal((30, 30))
+    a = m + m.T
+    u = rng.standard_normal((30, 3))
+    b = rng.standard_normal((30, 2))
+    factor = linalg.ldlt_factor(a)
+    assert not factor.positive_definite
+    npt.assert_allclose(a @ factor.solve(b), b, atol=1e-9)
+
+    factor.update(u)
+    npt.assert_allclose((a + u @ u.T) @ factor.solve(b), b, atol=1e-9)
+    factor.update(u, sign=-1)
+    npt.assert_allclose(a @ factor.solve(b), b, atol=1e-9)
+
+    assert linalg.ldlt_factor(_spd(8, 0)[0]).positive_definite
+
+
+def test_updated_factor_feeds_generalized_eigh():
+    a, rng = _spd(16, 2)
+    k = rng.standard_normal((16, 16))
+    k = (k + k.T) / 2.0
+    u = rng.standard_normal((16, 2))
+    factor = linalg.cholesky_factor(a)
+    factor.update(u)
+    w, _ = linalg.eigh(k, factor)
+    w_ref, _ = linalg.eigh(k, a + u @ u.T)
+    npt.assert_allclose(w, w_ref, rtol=1e-10, atol=1e-10)
+
+
+def test_factor_update_errors():
+    a, _ = _spd(6, 0)
+    factor = linalg.cholesky_factor(a)
+    with pytest.raises(ValueError, match="sign"):
+        factor.update(np.ones(6), sign=2)
+    with pytest.raises(ValueError, match="shape mismatch"):
+        factor.update(np.ones(5))
+    with pytest.raises(ValueError, match="finite"):
+        factor.update(np.full(6, np.nan))
+    with pytest.raises(ValueError, match="2x2 pivot"):
+        linalg.ldlt_factor(np.array([[0.0, 1.0], [1.0, 0.0]]))
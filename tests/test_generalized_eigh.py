@@ -0,0 +1,137 @@
+import numpy as np
+import numpy.testing as npt
+import pytest
+
+import peigen
+from peigen import build_config, linalg
+
+
+def _methods():
+    return ("eigen", "lapack") if build_config().get("lapack_enabled") else ("eigen",)
+
+
+def _pencil(n, seed):
+    rng = np.random.default_rng(seed)
+    a = rng.standard_normal((n, n))
+    a = (a + a.T) / 2.0
+    m = rng.standard_normal((n, n))
+    b = m @ m.T + n * np.eye(n)
+    return a, b
+
+
+def _residual(a, b, w, v, type):
+    if type == 1:
+        return a @ v - b @ v * w
+    if type == 2:
+        return a @ b @ v - v * w
+    return b @ a @ v - v * w
+
+
+@pytest.mark.parametrize("type", [1, 2, 3])
+def test_generalized_eigh_residual_and_normalization(type):
+    a, b = _pencil(24, type)
+    for method in _methods():
+        w, v = linalg.eigh(a, b, type=type, method=method)
+        assert np.all(np.diff(w) >= 0)
+        scale = np.abs(w).max()
+        npt.assert_allclose(_residual(a, b, w, v, type), 0.0, atol=1e-10 * scale)
+        gram = v.T @ np.linalg.solve(b, v) if type == 3 else v.T @ b @ v
+        npt.assert_allclose(gram, np.eye(24), atol=1e-10)
+        npt.assert_allclose(linalg.eighvals(a, b, type=type, method=method), w, rtol=1e-10, atol=1e-10 * scale)
+
+
+def test_generalized_eigh_matches_scipy():
+    sla = pytest.importorskip("scipy.linalg")
+    a, b = _pencil(30, 7)
+    for type in (1, 2, 3):
+        w_ref = sla.eigh(a, b, type=type, eigvals_only=True)
+        for method in _methods():
+            w, _ = linalg.eigh(a, b, type=type, method=method)
+            npt.assert_allclose(w, w_ref, rtol=1e-10, atol=1e-10 * np.abs(w_ref).max())
+
+
+def test_generalized_eigh_reads_one_triangle():
+    a, b = _pencil(12, 3)
+    w_ref, _ = linalg.eigh(a, b)
+    noisy_a = np.triu(a) + np.tril(np.full_like(a, 9.0), -1)
+    noisy_b = np.triu(b) + np.tril(np.full_like(b, -5.0), -1)
+    w, _ = linalg.eigh(noisy_a, noisy_b, lower=False)
+    npt.assert_allclose(w, w_ref, rtol=1e-10, atol=1e-10)
+
+
+def test_generalized_eigh_subset_by_index():
+    a, b = _pencil(20, 11)
+    w_all, v_all = linalg.eigh(a, b)
+    for method in _methods():
+        w, v = linalg.eigh(a, b, subset_by_index=(4, 9), method=method)
+        assert w.shape == (6,) and v.shape == (20, 6)
+        npt.assert_allclose(w, w_all[4:10], rtol=1e-10, atol=1e-10)
+        npt.assert_allclose(_residual(a, b, w, v, 1), 0.0, atol=1e-10)
+        npt.assert_allclose(np.abs(v.T @ b @ v_all[:, 4:10]), np.eye(6), atol=1e-8)
+
+
+def test_cholesky_factor_reused_for_eigh_and_solve():
+    a, b = _pencil(16, 5)
+    factor = linalg.cholesky_factor(b)
+    assert factor.shape == (16, 16)
+    npt.assert_allclose(factor.L @ factor.L.T, b, rtol=1e-12, atol=1e-12)
+    assert np.allclose(factor.L, np.tril(factor.L))
+
+    rng = np.random.default_rng(0)
+    rhs = rng.standard_normal((16, 3))
+    npt.assert_allclose(factor.solve(rhs), np.linalg.solve(b, rhs), rtol=1e-10, atol=1e-12)
+    npt.assert_allclose(factor.solve(rhs[:, 0]), np.linalg.solve(b, rhs[:, 0]), rtol=1e-10, atol=1e-12)
+
+    for type in (1, 2, 3):
+        w_ref, v_ref = linalg.eigh(a, b, type=type)
+        for method in _methods():
+            w, v = linalg.eigh(a, factor, type=type, method=method)
+            npt.assert_allclose(w, w_ref, rtol=1e-10, atol=1e-10 * np.abs(w_ref).max())
+            npt.assert_allclose(_residual(a, b, w, v, type), 0.0, atol=1e-9 * np.abs(w).max())
+
+
+def test_factor_subset_matches_uncached_subset():
+    if not build_config().get("lapack_enabled"):
+        pytest.skip("requires LAPACK")
+    a, b = _pencil(30, 13)
+    factor = linalg.cholesky_factor(b)
+    for type in (1, 2, 3):
+        w_ref, v_ref = linalg.eigh(a, b, type=type, subset_by_index=(3, 8), method="lapack")
+        w, v = linalg.eigh(a, factor, type=type, subset_by_index=(3, 8), method="lapack")
+        npt.assert_allclose(w, w_ref, rtol=1e-10, atol=1e-10 * np.abs(w_ref).max())
+        npt.assert_allclose(np.abs(v), np.abs(v_ref), rtol=1e-8, atol=1e-10)
+
+        peigen.clear_factor_cache()
+        with peigen.factor_cache(8 * 2**20):
+            w_cached, _ = linalg.eigh(a, b, type=type, subset_by_index=(3, 8), method="lapack")
+        peigen.clear_factor_cache()
+        npt.assert_allclose(w_cached, w_ref, rtol=1e-10, atol=1e-10 * np.abs(w_ref).max())
+
+
+def test_generalized_eigh_uses_factor_cache():
+    a, b = _pencil(16, 9)
+    peigen.clear_factor_cache()
+    with peigen.factor_cache(8 * 2**20):
+        w0, _ = linalg.eigh(a, b)
+        w1, _ = linalg.eigh(2.0 * a, b)
+        info = peigen.factor_cache_info()
+    peigen.clear_factor_cache()
+    assert info["misses"] == 1 and info["hits"] == 1
+    npt.assert_allclose(w1, 2.0 * w0, rtol=1e-10, atol=1e-10)
+
+
+def test_generalized_eigh_errors():
+    a, b = _pencil(6, 1)
+    for method in _methods():
+        with pytest.raises(ValueError, match="positive definite"):
+            linalg.eigh(a, -b, method=method)
+    with pytest.raises(ValueError, match="positive definite"):
+        linalg.cholesky_factor(-b)
+    with pytest.raises(ValueError, match="type"):
+        linalg.eigh(a, b, type=4)
+    with pytest.raises(ValueError, match="shape mismatch"):
+        linalg.eigh(a, np.eye(5))
+    with pytest.raises(ValueError, match="subset_by_index"):
+        linalg.eigh(a, b, subset_by_index=(3, 6))
+    with pytest.raises(ValueError, match="requires b"):
+        linalg.eigh(a, subset_by_index=(0, 1))
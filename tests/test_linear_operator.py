@@ -0,0 +1,92 @@
+import numpy as np
+import numpy.testing as npt
+import pytest
+
+sp = pytest.importorskip("scipy.sparse")
+
+from peigen import sparse
+from peigen.sparse import LinearOperator, aslinearoperator
+
+
+def _laplacian_1d(n):
+    return sp.diags([-1.0, 2.0, -1.0], [-1, 0, 1], shape=(n, n), format="csc")
+
+
+@pytest.mark.sparse
+def test_composites_match_assembled_products():
+    rng = np.random.default_rng(400)
+    k = _laplacian_1d(12)
+    m = sp.diags(rng.uniform(1.0, 2.0, 12), format="csc")
+    d = rng.standard_normal((12, 12))
+    x = rng.standard_normal((12, 3))
+
+    op = aslinearoperator(k) + 0.5 * aslinearoperator(m) - aslinearoperator(d)
+    npt.assert_allclose(op @ x, (k + 0.5 * m) @ x - d @ x, rtol=1e-12, atol=1e-12)
+
+    normal = aslinearoperator(d).T @ d
+    npt.assert_allclose(normal.matvec(x[:, 0]), d.T @ d @ x[:, 0], rtol=1e-12, atol=1e-12)
+    npt.assert_allclose(normal.rmatvec(x), (d.T @ d).T @ x, rtol=1e-12, atol=1e-12)
+
+
+@pytest.mark.sparse
+def test_kron_and_block_diag_match_scipy():
+    rng = np.random.default_rng(401)
+    a = sp.random(4, 3, density=0.5, format="csc", random_state=401)
+    b = rng.standard_normal((5, 2))
+    op = LinearOperator.kron(a, b)
+    full = sp.kron(a, b).toarray()
+    x = rng.standard_normal(6)
+    assert op.shape == (20, 6)
+    npt.assert_allclose(op @ x, full @ x, rtol=1e-12, atol=1e-12)
+    z = rng.standard_normal(20)
+    npt.assert_allclose(op.T @ z, full.T @ z, rtol=1e-12, atol=1e-12)
+    npt.assert_allclose(op.rmatvec(z), full.T @ z, rtol=1e-12, atol=1e-12)
+
+    blocks = [_laplacian_1d(3), b, LinearOperator.identity(2)]
+    bd = LinearOperator.block_diag(blocks)
+    dense = sp.block_diag([blocks[0], b, np.eye(2)]).toarray()
+    y = rng.standard_normal((bd.shape[1], 2))
+    npt.assert_allclose(bd @ y, dense @ y, rtol=1e-12, atol=1e-12)
+
+    square = LinearOperator.block_diag([_laplacian_1d(3), 2.0 * LinearOperator.identity(2)])
+    npt.assert_allclose(square.diagonal(), [2.0, 2.0, 2.0, 2.0, 2.0])
+
+
+@pytest.mark.sparse
+@pytest.mark.parametrize("method,preconditioner", [("cg", "none"), ("cg", "jacobi"), ("bicgstab", "none")])
+def test_matrix_free_solve_matches_assembled(method, preconditioner):
+    n = 16
+    lap = _laplacian_1d(n)
+    eye = sp.identity(n, format="csc")
+    op = LinearOperator.kron(LinearOperator.identity(n), lap) + LinearOperator.kron(lap, eye)
+    assembled = (sp.kron(eye, lap) + sp.kron(lap, eye)).tocsc()
+    b = np.random.default_rng(402).standard_normal(n * n)
+
+    x = sparse.solve(op, b, method=method, tol=1e-10, preconditioner=preconditioner)
+    x_ref = sparse.solve(assembled, b, method="lu")
+    npt.assert_allclose(x, x_ref, rtol=1e-7, atol=1e-8)
+
+    if method == "cg":
+        stats = sparse.solve_stats(op, b, tol=1e-10, preconditioner=preconditioner)
+        assert stats["iterations"] > 0
+        assert stats["error"] <= 1e-10
+
+
+@pytest.mark.sparse
+def test_linear_operator_errors():
+    op = aslinearoperator(np.ones((3, 2)))
+    with pytest.raises(ValueError):
+        op + aslinearoperator(np.ones((2, 2)))
+    with pytest.raises(ValueError):
+        op @ aslinearoperator(np.ones((3, 3)))
+    with pytest.raises(ValueError):
+        op.matvec(np.ones(3))
+    with pytest.raises(ValueError):
+        sparse.solve(op, np.ones(3), method="cg")
+    square = aslinearoperator(_laplacian_1d(4))
+    with pytest.raises(ValueError):
+        sparse.solve(square, np.ones(4), method="lu")
+    with pytest.raises(ValueError):
+        sparse.solve(square, np.ones(4), method="cg", preconditioner="ilu")
+    with pytest.raises(ValueError):
+        sparse.solve(square @ square, np.ones(4), method="cg", preconditioner="jacobi")
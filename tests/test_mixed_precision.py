@@ -0,0 +1,121 @@
+import numpy as np
+import numpy.testing as npt
+import pytest
+
+from peigen import linalg
+
+
+def _well_conditioned(n: int, seed: int) -> np.ndarray:
+    rng = np.random.default_rng(seed)
+    return rng.standard_normal((n, n)) + n * np.eye(n)
+
+
+@pytest.mark.parametrize("method", ["auto", "eigen"])
+def test_dense_mixed_solve_reaches_double_accuracy(method):
+    a = _well_conditioned(64, seed=0)
+    b = np.random.default_rng(1).standard_normal((64, 3))
+    x = linalg.solve(a, b, method=method, precision="mixed")
+    npt.assert_allclose(x, np.linalg.solve(a, b), rtol=1e-12, atol=1e-13)
+
+
+def test_dense_mixed_solve_stats_reports_refinement():
+    a = _well_conditioned(48, seed=2)
+    b = np.random.default_rng(3).standard_normal(48)
+    x, stats = linalg.solve_stats(a, b)
+
+    assert x.shape == (48,)
+    assert stats["precision"] == "mixed"
+    assert not stats["fallback"]
+    assert 0 <= stats["iterations"] <= 30
+    assert stats["error"] < 1e-14
+
+
+def test_dense_mixed_solve_falls_back_for_ill_conditioned_input():
+    n = 12
+    hilbert = 1.0 / (np.arange(n)[:, None] + np.arange(n)[None, :] + 1.0)
+    b = hilbert @ np.ones(n)
+    x, stats = linalg.solve_stats(hilbert, b)
+
+    assert stats["fallback"]
+    # The forward error is O(1) at cond ~ 1e16, so only the backward error is meaningful.
+    scale = np.linalg.norm(hilbert, np.inf) * np.linalg.norm(x, np.inf)
+    assert np.linalg.norm(hilbert @ x - b, np.inf) <= 1e-12 * scale
+    assert stats["error"] <= 1e-12
+
+
+def test_dense_mixed_solve_empty_system():
+    x, stats = linalg.solve_stats(np.zeros((0, 0)), np.zeros(0))
+    assert x.shape == (0,)
+    assert not stats["fallback"]
+    assert stats["iterations"] == 0
+
+
+def test_dense_mixed_solve_falls_back_outside_float_range():
+    a = _well_conditioned(8, seed=4) * 1e40
+    b = np.ones(8)
+    x, stats = linalg.solve_stats(a, b)
+
+    assert stats["fallback"]
+    npt.assert_allclose(a @ x, b, rtol=1e-10, atol=1e-10)
+
+
+def test_dense_solve_rejects_unknown_precision():
+    with pytest.raises(ValueError):
+        linalg.solve(np.eye(2), np.ones(2), precision="half")
+
+
+@pytest.mark.sparse
+def test_sparse_mixed_solve_and_factor_stats():
+    sp = pytest.importorskip("scipy.sparse")
+    from peigen import sparse
+
+    n = 20
+    lap = sp.diags([-1.0, 4.5, -1.2], [-1, 0, 1], shape=(n, n))
+    eye = sp.identity(n)
+    a = (sp.kron(eye, lap) + sp.kron(lap, eye)).tocsc()
+    b = np.random.default_rng(5).standard_normal((a.shape[0], 2))
+    expected = np.linalg.solve(a.toarray(), b)
+
+    npt.assert_allclose(sparse.solve(a, b, precision="mixed"), expected, rtol=1e-11, atol=1e-12)
+
+    fac = sparse.factorize(sparse.Matrix(a), precision="mixed")
+    npt.assert_allclose(fac.solve(b), expected, rtol=1e-11, atol=1e-12)
+    stats = fac.stats
+    assert stats["precision"] == "mixed"
+    assert stats["single_precision"]
+    assert stats["solves"] == 2
+    assert stats["fallbacks"] == 0
+
+    one = sparse.solve_stats(a, b[:, 0], method="lu", precision="mixed")
+    assert not one["fallback"]
+    assert one["error"] < 1e-14
+
+    assert sparse.factorize(a).stats["precision"] == "double"
+
+
+@pytest.mark.sparse
+def test_sparse_mixed_solve_stats_defaults_to_lu():
+    sp = pytest.importorskip("scipy.sparse")
+    from peigen import sparse
+
+    a = (sp.diags([-1.0, 4.0, -1.0], [-1, 0, 1], shape=(30, 30))).tocsc()
+    b = np.random.default_rng(6).standard_normal(30)
+    stats = sparse.solve_stats(a, b, precision="mixed")
+    assert stats["precision"] == "mixed"
+    assert not stats["fallback"]
+    assert stats["error"] < 1e-14
+    assert "iterations" in sparse.solve_stats(a, b)
+
+
+@pytest.mark.sparse
+def test_sparse_mixed_precision_rejects_iterative_and_permuted():
+    sp = pytest.importorskip("scipy.sparse")
+    from peigen import sparse
+
+    a = sp.identity(4, format="csc")
+    with pytest.raises(ValueError):
+        sparse.solve(a, np.ones(4), method="cg", precision="mixed")
+    with pytest.raises(ValueError):
+        sparse.solve(a, np.ones(4), precision="mixed", permuted="rcm")
+    with pytest.raises(ValueError):
+        sparse.factorize(a, precision="single")
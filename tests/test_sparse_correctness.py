@@ -96,3 +96,151 @@ def test_sparse_factorized_solve():
     x = fac.solve(b)
     resid = np.linalg.norm(a @ x - b) / np.linalg.norm(b)
     assert resid < 1e-9
+
+
+@pytest.mark.sparse
+def test_from_coo_sums_duplicates_like_scipy():
+    rng = np.random.default_rng(17)
+    row = rng.integers(0, 30, size=400)
+    col = rng.integers(0, 20, size=400)
+    data = rng.standard_normal(400)
+
+    out = sparse.from_coo(data, row, col, (30, 20))
+    ref = sp.coo_matrix((data, (row, col)), shape=(30, 20)).tocsc()
+    assert out.shape == (30, 20)
+    assert out.nnz == ref.nnz
+    npt.assert_allclose(out.toarray(), ref.toarray(), rtol=1e-12, atol=1e-12)
+
+    with pytest.raises(ValueError):
+        sparse.from_coo([1.0], [30], [0], (30, 20))
+
+
+@pytest.mark.sparse
+def test_coo_pattern_reassembles_in_place():
+    rng = np.random.default_rng(18)
+    row = rng.integers(0, 25, size=300)
+    col = rng.integers(0, 25, size=300)
+    pattern = sparse.CooPattern(row, col, (25, 25))
+    assert pattern.n_triplets == 300
+
+    first = rng.standard_normal(300)
+    mat = pattern.assemble(first)
+    assert mat.nnz == pattern.nnz
+    npt.assert_allclose(mat.toarray(), sp.coo_matrix((first, (row, col)), shape=(25, 25)).toarray(), atol=1e-12)
+
+    second = rng.standard_normal(300)
+    buffer = mat.data
+    same = pattern.assemble(second, out=mat)
+    assert same is mat and mat.data is buffer
+    npt.assert_allclose(mat.toarray(), sp.coo_matrix((second, (row, col)), shape=(25, 25)).toarray(), atol=1e-12)
+
+    with pytest.raises(ValueError):
+        pattern.assemble(second[:-1])
+    with pytest.raises(ValueError):
+        pattern.assemble(second, out=sp.identity(25, format="csc"))
+
+
+@pytest.mark.sparse
+def test_matrix_handle_caches_views():
+    a = sp.random(40, 25, density=0.1, format="csc", random_state=22) + sp.eye(40, 25, format="csc")
+    m = sparse.Matrix(a)
+
+    assert m.shape == (40, 25)
+    assert m.nnz == a.nnz
+    npt.assert_allclose(m.diagonal(), a.diagonal())
+    assert m.T is m.T
+    assert m.T.shape == (25, 40)
+    npt.assert_allclose(m.T.toarray(), a.T.toarray())
+
+    csr = m.to_scipy(format="csr")
+    assert csr.format == "csr"
+    npt.assert_allclose(csr.toarray(), a.toarray())
+    npt.assert_allclose(m.to_scipy().toarray(), a.toarray())
+    with pytest.raises(ValueError):
+        m.to_scipy(format="coo")
+
+
+@pytest.mark.sparse
+def test_matrix_handle_accepted_by_sparse_routines():
+    rng = np.random.default_rng(23)
+    a = sp.random(30, 30, density=0.1, format="csc", random_state=23)
+    a = (a + a.T + 30.0 * sp.eye(30)).tocsc()
+    m = sparse.Matrix(a)
+    b = rng.standard_normal((30, 2))
+
+    npt.assert_allclose(sparse.spmm(m, b), a @ b, rtol=1e-12, atol=1e-12)
+    npt.assert_allclose(m @ b[:, 0], a @ b[:, 0], rtol=1e-12, atol=1e-12)
+    npt.assert_allclose(sparse.spspmm(m, m).toarray(), (a @ a).toarray(), rtol=1e-10, atol=1e-10)
+
+    expected = np.linalg.solve(a.toarray(), b)
+    npt.assert_allclose(sparse.solve(m, b, method="lu"), expected, rtol=1e-9, atol=1e-9)
+    npt.assert_allclose(sparse.solve(m, b, method="cg", tol=1e-12), expected, rtol=1e-7, atol=1e-7)
+    npt.assert_allclose(sparse.factorize(m).solve(b), expected, rtol=1e-9, atol=1e-9)
+    npt.assert_allclose(sparse.aslinearoperator(m).matvec(b), a @ b, rtol=1e-12, atol=1e-12)
+
+
+@pytest.mark.sparse
+def test_matrix_from_coo_matches_scipy():
+    row = np.array([0, 2, 1, 2, 0], dtype=np.int64)
+    col = np.array([1, 0, 1, 0, 1], dtype=np.int64)
+    data = np.array([1.0, 2.0, 3.0, 4.0, 5.0])
+    m = sparse.Matrix.from_coo(data, row, col, (3, 2))
+    npt.assert_allclose(m.toarray(), sp.coo_matrix((data, (row, col)), shape=(3, 2)).toarray())
+
+    with pytest.raises(ValueError):
+        sparse.Matrix.from_coo(data, row, col + 5, (3, 2))
+    with pytest.raises(ValueError):
+        sparse.Matrix.from_coo(data, row.astype(np.float64), col, (3, 2))
+
+
+@pytest.mark.sparse
+@pytest.mark.parametrize("transpose", [False, True])
+def test_spmm_fused_axpby(transpose):
+    rng = np.random.default_rng(30)
+    a = sp.random(45, 30, density=0.1, format="csc", random_state=30)
+    op = a.T if transpose else a
+    b = rng.standard_normal((op.shape[1], 4))
+    y = rng.standard_normal((op.shape[0], 4))
+    expected = 2.5 * (op @ b) - 0.5 * y
+
+    out = sparse.spmm(a, b, transpose=transpose, alpha=2.5, beta=-0.5, out=y)
+    assert out is y
+    npt.assert_allclose(y, expected, rtol=1e-12, atol=1e-12)
+
+    x = b[:, 0].copy()
+    npt.assert_allclose(sparse.spmm(a, x, transpose=transpose), op @ x, rtol=1e-12, atol=1e-12)
+
+
+@pytest.mark.sparse
+def test_spmm_fused_rejects_bad_out():
+    a = sp.random(10, 8, density=0.3, format="csc", random_state=31)
+    b = np.ones((8, 2))
+    with pytest.raises(ValueError):
+        sparse.spmm(a, b, beta=1.0)
+    with pytest.raises(ValueError):
+        sparse.spmm(a, b, beta=1.0, out=np.zeros((10, 2), dtype=np.float32))
+    with pytest.raises(ValueError):
+        sparse.spmm(a, b, beta=1.0, out=np.zeros((10, 3)))
+    with pytest.raises(ValueError):
+        sparse.spmm(a, b, beta=1.0, out=np.zeros((2, 10)).T)
+    square = sp.random(8, 8, density=0.3, format="csc", random_state=32)
+    with pytest.raises(ValueError):
+        sparse.spmm(square, b, beta=1.0, out=b)
+
+
+@pytest.mark.sparse
+def test_normal_matmul_and_sddmm_match_scipy():
+    rng = np.random.default_rng(33)
+    a = sp.random(50, 20, density=0.15, format="csr", random_state=33)
+    x = rng.standard_normal(20)
+    npt.assert_allclose(sparse.normal_matmul(a, x), a.T @ (a @ x), rtol=1e-12, atol=1e-12)
+    xb = rng.standard_normal((20, 3))
+    npt.assert_allclose(sparse.normal_matmul(sparse.Matrix(a), xb), a.T @ (a @ xb), rtol=1e-12, atol=1e-12)
+
+    u = rng.standard_normal((50, 6))
+    v = rng.standard_normal((20, 6))
+    out = sparse.sddmm(a, u, v)
+    assert out.nnz == a.nnz
+    npt.assert_allclose(out.toarray(), a.multiply(u @ v.T).toarray(), rtol=1e-12, atol=1e-12)
+    with pytest.raises(ValueError):
+        sparse.sddmm(a, u, v[:, :4])
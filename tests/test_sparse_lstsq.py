@@ -0,0 +1,61 @@
+import numpy as np
+import numpy.testing as npt
+import pytest
+
+sp = pytest.importorskip("scipy.sparse")
+
+from peigen import sparse
+
+
+def _rectangular(m: int, n: int, seed: int):
+    rng = np.random.default_rng(seed)
+    a = sp.random(m, n, density=0.05, random_state=rng, format="lil")
+    k = min(m, n)
+    a[np.arange(k), np.arange(k)] = 2.0
+    return a.tocsc()
+
+
+@pytest.mark.sparse
+def test_lstsq_qr_matches_dense_overdetermined():
+    a = _rectangular(120, 40, seed=0)
+    b = np.random.default_rng(1).standard_normal((120, 2))
+    expected = np.linalg.lstsq(a.toarray(), b, rcond=None)[0]
+
+    npt.assert_allclose(sparse.lstsq(a, b), expected, rtol=1e-10, atol=1e-10)
+    npt.assert_allclose(sparse.lstsq(a, b[:, 0]), expected[:, 0], rtol=1e-10, atol=1e-10)
+    npt.assert_allclose(sparse.lstsq(a, b, method="lscg", tol=1e-12), expected, rtol=1e-7, atol=1e-7)
+
+
+@pytest.mark.sparse
+def test_lstsq_qr_returns_minimum_norm_for_underdetermined():
+    a = _rectangular(30, 90, seed=2)
+    b = np.random.default_rng(3).standard_normal(30)
+    expected = np.linalg.lstsq(a.toarray(), b, rcond=None)[0]
+
+    npt.assert_allclose(sparse.lstsq(a, b), expected, rtol=1e-9, atol=1e-10)
+
+
+@pytest.mark.sparse
+def test_qr_factorization_reuses_factors():
+    a = _rectangular(80, 25, seed=4)
+    fac = sparse.factorize(sparse.Matrix(a), method="qr")
+    assert fac.shape == (80, 25)
+    assert fac.rank == 25
+
+    rng = np.random.default_rng(5)
+    for _ in range(3):
+        b = rng.standard_normal(80)
+        npt.assert_allclose(fac.solve(b), np.linalg.lstsq(a.toarray(), b, rcond=None)[0], rtol=1e-10, atol=1e-10)
+
+
+@pytest.mark.sparse
+def test_lstsq_rejects_bad_input():
+    a = _rectangular(10, 4, seed=6)
+    with pytest.raises(ValueError):
+        sparse.lstsq(a, np.ones(9))
+    with pytest.raises(ValueError):
+        sparse.lstsq(a, np.ones(10), method="lsqr")
+    with pytest.raises(ValueError):
+        sparse.factorize(a, method="qr").solve(np.ones(4))
+    with pytest.raises(ValueError):
+        sparse.factorize(a, method="qr", precision="mixed")
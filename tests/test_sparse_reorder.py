@@ -0,0 +1,84 @@
+import numpy as np
+import numpy.testing as npt
+import pytest
+
+sp = pytest.importorskip("scipy.sparse")
+
+from peigen import sparse
+
+
+def _shuffled_laplacian(n: int, seed: int):
+    lap = sp.diags([-1.0, 2.0, -1.0], [-1, 0, 1], shape=(n, n))
+    eye = sp.identity(n)
+    a = (sp.kron(eye, lap) + sp.kron(lap, eye)).tocsc()
+    shuffle = np.random.default_rng(seed).permutation(a.shape[0])
+    return a[shuffle][:, shuffle].tocsc()
+
+
+def _bandwidth(a) -> int:
+    coo = a.tocoo()
+    return int(np.max(np.abs(coo.row - coo.col)))
+
+
+@pytest.mark.sparse
+@pytest.mark.parametrize("method", ["rcm", "amd", "colamd", "nd"])
+def test_reorder_returns_permutation_and_permuted_matrix(method):
+    a = _shuffled_laplacian(12, seed=1)
+    perm, b = sparse.reorder(a, method=method)
+
+    assert sorted(perm.tolist()) == list(range(a.shape[0]))
+    expected = a[:, perm] if method == "colamd" else a[perm][:, perm]
+    npt.assert_allclose(b.toarray(), expected.toarray())
+
+
+@pytest.mark.sparse
+def test_rcm_reduces_bandwidth():
+    a = _shuffled_laplacian(20, seed=2)
+    _, b = sparse.reorder(a, method="rcm")
+    assert _bandwidth(b) <= 2 * 20
+    assert _bandwidth(b) < _bandwidth(a) // 4
+
+
+@pytest.mark.sparse
+@pytest.mark.parametrize("method", ["rcm", "amd", "nd"])
+def test_permuted_operations_map_vectors(method):
+    rng = np.random.default_rng(3)
+    a = _shuffled_laplacian(10, seed=3)
+    r = sparse.reorder(sparse.Matrix(a), method=method)
+    assert isinstance(r.matrix, sparse.Matrix)
+    b = rng.standard_normal((a.shape[0], 2))
+    x = np.linalg.solve(a.toarray(), b)
+
+    npt.assert_allclose(sparse.spmm(a, b, permuted=r), a @ b, rtol=1e-12, atol=1e-12)
+    npt.assert_allclose(sparse.spmm(a, b[:, 0], transpose=True, permuted=r), a.T @ b[:, 0], rtol=1e-12, atol=1e-12)
+    npt.assert_allclose(sparse.solve(a, b, permuted=r), x, rtol=1e-9, atol=1e-9)
+    npt.assert_allclose(
+        sparse.solve(a, b[:, 0], method="cg", tol=1e-12, permuted=r), x[:, 0], rtol=1e-7, atol=1e-7
+    )
+    npt.assert_allclose(sparse.factorize(a, permuted=r).solve(b), x, rtol=1e-9, atol=1e-9)
+
+
+@pytest.mark.sparse
+def test_colamd_permutes_columns_only():
+    rng = np.random.default_rng(4)
+    a = sp.random(40, 40, density=0.1, format="csc", random_state=4) + 5.0 * sp.eye(40, format="csc")
+    r = sparse.reorder(a, method="colamd")
+    b = rng.standard_normal(40)
+
+    npt.assert_allclose(sparse.spmm(a, b, permuted=r), a @ b, rtol=1e-12, atol=1e-12)
+    npt.assert_allclose(sparse.spmm(a, b, transpose=True, permuted="colamd"), a.T @ b, rtol=1e-12, atol=1e-12)
+    npt.assert_allclose(sparse.solve(a, b, permuted=r), np.linalg.solve(a.toarray(), b), rtol=1e-9, atol=1e-9)
+    with pytest.raises(ValueError):
+        sparse.solve(a, b, method="cg", permuted=r)
+
+
+@pytest.mark.sparse
+def test_reorder_rejects_bad_input():
+    a = sp.random(5, 4, density=0.5, format="csc", random_state=5)
+    with pytest.raises(ValueError):
+        sparse.reorder(a, method="metis")
+    with pytest.raises(ValueError):
+        sparse.reorder(a, method="rcm")
+    r = sparse.reorder(_shuffled_laplacian(3, seed=6))
+    with pytest.raises(ValueError):
+        sparse.spmm(_shuffled_laplacian(4, seed=6), np.ones(16), permuted=r)
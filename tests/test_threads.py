@@ -0,0 +1,63 @@
+import numpy as np
+import numpy.testing as npt
+import pytest
+
+import peigen
+from peigen import linalg
+
+
+def test_set_and_get_num_threads_roundtrip():
+    original = peigen.get_num_threads()
+    try:
+        peigen.set_num_threads(1)
+        assert peigen.get_num_threads() == 1
+    finally:
+        peigen.set_num_threads(original)
+
+
+def test_set_num_threads_rejects_negative():
+    with pytest.raises(ValueError):
+        peigen.set_num_threads(-1)
+
+
+def test_thread_info_keys():
+    info = peigen.thread_info()
+    assert {"eigen", "openmp", "blas", "blas_threading_api", "default"}.issubset(info.keys())
+    assert info["eigen"] >= 1
+    assert info["default"] >= 1
+
+
+def test_threadpool_limits_restores_previous_settings():
+    before = peigen.thread_info()
+    with peigen.threadpool_limits(1):
+        assert peigen.get_num_threads() == 1
+        if before["blas"] > 0:
+            assert peigen.thread_info()["blas"] == 1
+    after = peigen.thread_info()
+    assert after["eigen"] == before["eigen"]
+    assert after["blas"] == before["blas"]
+
+
+def test_threadpool_limits_single_layer():
+    before = peigen.thread_info()
+    with peigen.threadpool_limits(1, user_api="eigen"):
+        info = peigen.thread_info()
+        assert info["eigen"] == 1
+        assert info["blas"] == before["blas"]
+    assert peigen.get_num_threads() == before["eigen"]
+
+
+def test_threadpool_limits_invalid_api():
+    with pytest.raises(ValueError):
+        peigen.threadpool_limits(2, user_api="cuda")
+
+
+def test_results_independent_of_thread_count():
+    rng = np.random.default_rng(60)
+    a = rng.standard_normal((96, 96)) + 10 * np.eye(96)
+    b = rng.standard_normal((96, 3))
+    with peigen.threadpool_limits(1):
+        x1 = linalg.solve(a, b, method="eigen")
+    with peigen.threadpool_limits(4):
+        x4 = linalg.solve(a, b, method="eigen")
+    npt.assert_allclose(x1, x4, rtol=1e-10, atol=1e-11)